@@ -0,0 +1,267 @@
+/**
+ * @file main.cpp
+ * @brief Offline asset tool.
+ *
+ * @details
+ * Usage:
+ *  - `AssetTool pack <output.pak> <dir|file>... [--root <dir>] [--compress] [--align <bytes>]`
+ *    packs the given files (directories recursively). Entry names are the paths
+ *    relative to `--root` (default: current directory), which is how the engine
+ *    asks for them (e.g. "Sprites/WhiteCamo.png").
+ *  - `AssetTool list <archive.pak>` prints the index.
+ *  - `AssetTool cook <dir|file>... [--premultiply] [--mips] [--compress] [--bench]`
+ *    writes a `.ctex` blob (see CookedTexture) next to every png/jpg/bmp/tga
+ *    image. `--bench` times both load paths (read, decode, GPU upload) and
+ *    prints milliseconds per megapixel.
+ */
+
+#include "AssetArchive.h"
+#include "CookedTexture.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+ void
+ printUsage() {
+  std::cerr << "usage:\n"
+            << "  AssetTool pack <output.pak> <dir|file>... [--root <dir>] [--compress] [--align <bytes>]\n"
+            << "  AssetTool list <archive.pak>\n"
+            << "  AssetTool cook <dir|file>... [--premultiply] [--mips] [--compress] [--bench]\n";
+ }
+
+ bool
+ readFile(const fs::path& path, std::vector<uint8_t>& bytes) {
+  //misma lectura que ResourceManager::readSource
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+   return false;
+  }
+  bytes.resize(static_cast<std::size_t>(in.tellg()));
+  in.seekg(0);
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())));
+ }
+
+ double
+ elapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+ }
+
+ bool
+ isImage(const fs::path& path) {
+  std::string extension = path.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return extension == ".png" || extension == ".jpg" || extension == ".jpeg"
+      || extension == ".bmp" || extension == ".tga";
+ }
+
+ int
+ cook(int argc, char* argv[]) {
+  CookedTexture::CookOptions options;
+  bool bench = false;
+  std::vector<fs::path> images;
+  std::error_code error;
+  for (int i = 2; i < argc; ++i) {
+   const std::string arg = argv[i];
+   if (arg == "--premultiply") {
+    options.premultiply = true;
+   }
+   else if (arg == "--mips") {
+    options.mipmaps = true;
+   }
+   else if (arg == "--compress") {
+    options.compress = true;
+   }
+   else if (arg == "--bench") {
+    bench = true;
+   }
+   else if (fs::is_directory(arg, error)) {
+    for (const auto& item : fs::recursive_directory_iterator(arg, error)) {
+     if (item.is_regular_file(error) && isImage(item.path())) {
+      images.push_back(item.path());
+     }
+    }
+   }
+   else if (fs::is_regular_file(arg, error)) {
+    images.push_back(arg);
+   }
+   else {
+    std::cerr << "[AssetTool]: Not found: " << arg << "\n";
+    return 1;
+   }
+  }
+  if (images.empty()) {
+   printUsage();
+   return 1;
+  }
+
+  double megapixels = 0.0;
+  double sourceMs = 0.0;
+  double cookedMs = 0.0;
+  std::vector<uint8_t> bytes;
+  std::vector<uint8_t> blob;
+  for (const fs::path& path : images) {
+   sf::Image image;
+   if (!image.loadFromFile(path.string())) {
+    std::cerr << "[AssetTool]: Can't decode " << path.string() << "\n";
+    return 1;
+   }
+   CookedTexture::cook(image, options, blob);
+   fs::path output = path;
+   output.replace_extension(".ctex");
+   std::ofstream out(output, std::ios::binary | std::ios::trunc);
+   out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+   if (!out) {
+    std::cerr << "[AssetTool]: Failed to write " << output.string() << "\n";
+    return 1;
+   }
+   std::cout << output.string() << "  " << blob.size() << " B\n";
+
+   if (!bench) {
+    continue;
+   }
+   //mismo trabajo que el ResourceManager: leer, decodificar y subir
+   sf::Texture decodedTexture;
+   auto start = std::chrono::steady_clock::now();
+   sf::Image decoded;
+   const bool decodedOk = readFile(path, bytes) && decoded.loadFromMemory(bytes.data(), bytes.size())
+                          && decodedTexture.loadFromImage(decoded);
+   sourceMs += elapsedMs(start);
+
+   sf::Texture cookedTexture;
+   start = std::chrono::steady_clock::now();
+   CookedTexture cooked;
+   const bool cookedOk = readFile(output, bytes) && cooked.parse(ByteSpan{ bytes.data(), bytes.size() })
+                         && cooked.upload(cookedTexture);
+   cookedMs += elapsedMs(start);
+
+   if (!decodedOk || !cookedOk) {
+    std::cerr << "[AssetTool]: Benchmark load failed for " << path.string() << "\n";
+    return 1;
+   }
+   megapixels += static_cast<double>(image.getSize().x) * image.getSize().y / 1000000.0;
+  }
+
+  std::cout << "Cooked " << images.size() << " images\n";
+  if (bench && megapixels > 0.0) {
+   std::cout << "Source images: " << sourceMs / megapixels << " ms/MP\n"
+             << "Cooked blobs:  " << cookedMs / megapixels << " ms/MP ("
+             << megapixels << " MP)\n";
+  }
+  return 0;
+ }
+
+ int
+ pack(int argc, char* argv[]) {
+  if (argc < 4) {
+   printUsage();
+   return 1;
+  }
+  const std::string output = argv[2];
+  std::vector<std::string> sources;
+  fs::path root = fs::current_path();
+  bool compress = false;
+  uint32_t alignment = 16;
+  for (int i = 3; i < argc; ++i) {
+   const std::string arg = argv[i];
+   if (arg == "--compress") {
+    compress = true;
+   }
+   else if (arg == "--root" && i + 1 < argc) {
+    root = argv[++i];
+   }
+   else if (arg == "--align" && i + 1 < argc) {
+    alignment = static_cast<uint32_t>(std::stoul(argv[++i]));
+   }
+   else {
+    sources.push_back(arg);
+   }
+  }
+
+  std::vector<AssetArchive::BuildInput> inputs;
+  std::error_code error;
+  for (const std::string& source : sources) {
+   std::vector<fs::path> files;
+   if (fs::is_directory(source, error)) {
+    for (const auto& item : fs::recursive_directory_iterator(source, error)) {
+     if (item.is_regular_file(error)) {
+      files.push_back(item.path());
+     }
+    }
+   }
+   else if (fs::is_regular_file(source, error)) {
+    files.push_back(source);
+   }
+   else {
+    std::cerr << "[AssetTool]: Not found: " << source << "\n";
+    return 1;
+   }
+
+   for (const fs::path& file : files) {
+    const fs::path name = fs::relative(file, root, error);
+    if (error || name.empty()) {
+     std::cerr << "[AssetTool]: " << file.string() << " is outside " << root.string() << "\n";
+     return 1;
+    }
+    inputs.push_back({ name.generic_string(), file.string() });
+   }
+  }
+
+  if (!AssetArchive::build(output, inputs, compress, alignment)) {
+   std::cerr << "[AssetTool]: Failed to write " << output << "\n";
+   return 1;
+  }
+  std::cout << "Packed " << inputs.size() << " files into " << output << "\n";
+  return 0;
+ }
+
+ int
+ list(int argc, char* argv[]) {
+  if (argc < 3) {
+   printUsage();
+   return 1;
+  }
+  AssetArchive archive;
+  if (!archive.open(argv[2])) {
+   std::cerr << "[AssetTool]: Not a valid archive: " << argv[2] << "\n";
+   return 1;
+  }
+  uint64_t stored = 0;
+  uint64_t size = 0;
+  for (std::size_t i = 0; i < archive.getEntryCount(); ++i) {
+   const AssetArchive::Entry& entry = archive.getEntry(i);
+   stored += entry.storedSize;
+   size += entry.size;
+   std::cout << archive.getName(entry) << "  " << entry.size << " B";
+   if (entry.flags & AssetArchive::FLAG_COMPRESSED) {
+    std::cout << " (" << entry.storedSize << " B compressed)";
+   }
+   std::cout << "\n";
+  }
+  std::cout << archive.getEntryCount() << " entries, " << size << " B (" << stored << " B stored)\n";
+  return 0;
+ }
+}
+
+int
+main(int argc, char* argv[]) {
+ if (argc < 2) {
+  printUsage();
+  return 1;
+ }
+ const std::string command = argv[1];
+ if (command == "pack") {
+  return pack(argc, argv);
+ }
+ if (command == "list") {
+  return list(argc, argv);
+ }
+ if (command == "cook") {
+  return cook(argc, argv);
+ }
+ printUsage();
+ return 1;
+}
@@ -0,0 +1,403 @@
+/**
+ * @file main.cpp
+ * @brief Microbenchmarks of the engine hot paths.
+ *
+ * @details
+ * Usage: `Benchmarks [--filter <text>] [--reps <n>] [--warmup <n>] [--min-time <ms>] [--json <file>]`
+ *
+ * Every benchmark first calibrates how many operations make one repetition
+ * last at least `--min-time` (default 20 ms), then runs `--warmup` untimed
+ * repetitions (default 3) and `--reps` timed ones (default 15). The table
+ * shows nanoseconds per operation (min, median, mean, standard deviation,
+ * max); compare medians between commits. `--json` writes the same numbers so
+ * runs can be diffed by a script.
+ *
+ * Build in Release: the project defines ENGINE_PROFILER=0 so the measured
+ * code carries no profiler scopes.
+ */
+
+#include "A_Racer.h"
+#include "ResourceManager.h"
+#include "ECS/Transform.h"
+#include "Utilities/SpatialGrid.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <random>
+
+namespace {
+ //los resultados se escriben aqui para que el optimizador no borre el trabajo
+ volatile uint64_t g_sink = 0;
+
+ struct
+ BenchConfig {
+  std::string filter;
+  int reps = 15;
+  int warmup = 3;
+  double minTimeMs = 20.0;
+  std::string jsonFile;
+ };
+
+ struct
+ BenchResult {
+  std::string name;
+  uint64_t opsPerRep = 0;
+  double minNs = 0.0;
+  double medianNs = 0.0;
+  double meanNs = 0.0;
+  double stddevNs = 0.0;
+  double maxNs = 0.0;
+ };
+
+ /** @brief Runs `ops` operations and returns nothing; the work goes to g_sink. */
+ using BenchBody = std::function<void(uint64_t ops)>;
+
+ double
+ timeRep(const BenchBody& body, uint64_t ops) {
+  const auto start = std::chrono::steady_clock::now();
+  body(ops);
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+ }
+
+ BenchResult
+ runBench(const BenchConfig& config, const std::string& name, const BenchBody& body) {
+  BenchResult result;
+  result.name = name;
+
+  //calibrar: duplicar las operaciones hasta que una repeticion dure minTime
+  uint64_t ops = 1;
+  const double minNs = config.minTimeMs * 1e6;
+  for (;;) {
+   const double elapsed = timeRep(body, ops);
+   if (elapsed >= minNs || ops >= (uint64_t(1) << 34)) {
+    break;
+   }
+   ops = elapsed < minNs / 100.0 ? ops * 10 : ops * 2;
+  }
+  result.opsPerRep = ops;
+
+  for (int i = 0; i < config.warmup; ++i) {
+   timeRep(body, ops);
+  }
+  std::vector<double> samples;
+  samples.reserve(config.reps);
+  for (int i = 0; i < config.reps; ++i) {
+   samples.push_back(timeRep(body, ops) / ops);
+  }
+
+  std::sort(samples.begin(), samples.end());
+  double total = 0.0;
+  for (const double sample : samples) {
+   total += sample;
+  }
+  result.minNs = samples.front();
+  result.maxNs = samples.back();
+  result.meanNs = total / samples.size();
+  result.medianNs = samples.size() % 2 == 1
+   ? samples[samples.size() / 2]
+   : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) * 0.5;
+  double variance = 0.0;
+  for (const double sample : samples) {
+   variance += (sample - result.meanNs) * (sample - result.meanNs);
+  }
+  result.stddevNs = std::sqrt(variance / samples.size());
+  return result;
+ }
+
+ void
+ printRow(const BenchResult& result) {
+  std::cout << std::left << std::setw(44) << result.name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << result.minNs << std::setw(12) << result.medianNs
+            << std::setw(12) << result.meanNs << std::setw(10) << result.stddevNs
+            << std::setw(12) << result.maxNs << std::setw(14) << result.opsPerRep << std::endl;
+ }
+
+ bool
+ writeJson(const std::string& fileName, const BenchConfig& config, const std::vector<BenchResult>& results) {
+  std::ofstream out(fileName, std::ios::trunc);
+  if (!out) {
+   return false;
+  }
+#ifdef NDEBUG
+  const char* build = "Release";
+#else
+  const char* build = "Debug";
+#endif
+  out << std::fixed << std::setprecision(3);
+  out << "{\n  \"build\": \"" << build << "\",\n  \"reps\": " << config.reps
+      << ",\n  \"warmup\": " << config.warmup << ",\n  \"min_time_ms\": " << config.minTimeMs
+      << ",\n  \"benchmarks\": [\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+   const BenchResult& result = results[i];
+   out << "    {\"name\": \"" << result.name << "\", \"ops_per_rep\": " << result.opsPerRep
+       << ", \"ns_per_op\": {\"min\": " << result.minNs << ", \"median\": " << result.medianNs
+       << ", \"mean\": " << result.meanNs << ", \"stddev\": " << result.stddevNs
+       << ", \"max\": " << result.maxNs << "}}" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n}\n";
+  return static_cast<bool>(out);
+ }
+
+ //circuito cerrado de la escena de ejemplo
+ std::vector<sf::Vector2f>
+ makeWaypoints() {
+  return {
+   { 479.f, 350.f }, { 650.f, 408.f }, { 814.f, 563.f }, { 981.f, 641.f },
+   { 1138.f, 571.f }, { 1204.f, 408.f }, { 1137.f, 271.f }, { 974.f, 188.f },
+   { 820.f, 238.f }, { 724.f, 378.f }, { 729.f, 551.f }, { 660.f, 715.f },
+   { 491.f, 792.f }, { 322.f, 745.f }, { 244.f, 585.f }, { 301.f, 398.f }
+  };
+ }
+
+ //corredores repartidos por el circuito, con progreso distinto
+ std::vector<EngineUtilities::TSharedPointer<A_Racer>>
+ makeRacers(std::size_t count, const std::vector<sf::Vector2f>& waypoints) {
+  std::vector<EngineUtilities::TSharedPointer<A_Racer>> racers;
+  racers.reserve(count);
+  std::mt19937 random(1234);
+  std::uniform_real_distribution<float> offset(-40.f, 40.f);
+  for (std::size_t i = 0; i < count; ++i) {
+   auto racer = EngineUtilities::MakeShared<A_Racer>("Bench_" + std::to_string(i));
+   racer->setWaypoints(waypoints);
+   racer->spawnRelative(static_cast<int>(i % waypoints.size()), offset(random), offset(random));
+   racers.push_back(racer);
+  }
+  //unos pasos de simulacion para que no esten todos parados
+  for (int step = 0; step < 30; ++step) {
+   for (auto& racer : racers) {
+    racer->steerPhysics(1.f / 60.f);
+   }
+  }
+  return racers;
+ }
+}
+
+int
+main(int argc, char* argv[]) {
+ BenchConfig config;
+ for (int i = 1; i < argc; ++i) {
+  const std::string arg = argv[i];
+  const bool hasValue = i + 1 < argc;
+  if (arg == "--filter" && hasValue) {
+   config.filter = argv[++i];
+  }
+  else if (arg == "--reps" && hasValue) {
+   config.reps = std::max(1, std::atoi(argv[++i]));
+  }
+  else if (arg == "--warmup" && hasValue) {
+   config.warmup = std::max(0, std::atoi(argv[++i]));
+  }
+  else if (arg == "--min-time" && hasValue) {
+   config.minTimeMs = std::max(0.1, std::atof(argv[++i]));
+  }
+  else if (arg == "--json" && hasValue) {
+   config.jsonFile = argv[++i];
+  }
+  else {
+   std::cerr << "usage: Benchmarks [--filter <text>] [--reps <n>] [--warmup <n>] [--min-time <ms>] [--json <file>]\n";
+   return 1;
+  }
+ }
+
+ std::vector<BenchResult> results;
+ std::cout << std::left << std::setw(44) << "benchmark (ns/op)" << std::right
+           << std::setw(12) << "min" << std::setw(12) << "median" << std::setw(12) << "mean"
+           << std::setw(10) << "stddev" << std::setw(12) << "max" << std::setw(14) << "ops/rep" << std::endl;
+ auto bench = [&](const std::string& name, const BenchBody& body) {
+  if (!config.filter.empty() && name.find(config.filter) == std::string::npos) {
+   return;
+  }
+  results.push_back(runBench(config, name, body));
+  printRow(results.back());
+ };
+
+ const std::vector<sf::Vector2f> waypoints = makeWaypoints();
+
+ //--- TSharedPointer
+ EngineUtilities::TSharedPointer<Transform> transform = EngineUtilities::MakeShared<Transform>();
+ EngineUtilities::TSharedPointer<Component> component = transform;
+
+ bench("TSharedPointer copy", [&](uint64_t ops) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < ops; ++i) {
+   EngineUtilities::TSharedPointer<Transform> copy = transform;
+   sum += copy.useCount();
+  }
+  g_sink = g_sink + sum;
+ });
+
+ bench("TSharedPointer move", [&](uint64_t ops) {
+  EngineUtilities::TSharedPointer<Transform> a = transform;
+  EngineUtilities::TSharedPointer<Transform> b;
+  for (uint64_t i = 0; i < ops; ++i) {
+   if (i & 1) {
+    a = std::move(b);
+   }
+   else {
+    b = std::move(a);
+   }
+  }
+  g_sink = g_sink + a.useCount() + b.useCount();
+ });
+
+ bench("TSharedPointer dynamic_pointer_cast", [&](uint64_t ops) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < ops; ++i) {
+   EngineUtilities::TSharedPointer<Transform> cast = component.dynamic_pointer_cast<Transform>();
+   sum += cast.useCount();
+  }
+  g_sink = g_sink + sum;
+ });
+
+ //--- Entity::getComponent (el Actor tiene CShape y Transform, en ese orden)
+ auto actor = EngineUtilities::MakeShared<A_Racer>("Bench");
+ bench("Entity::getComponent<CShape> (first)", [&](uint64_t ops) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < ops; ++i) {
+   sum += actor->getComponent<CShape>().useCount();
+  }
+  g_sink = g_sink + sum;
+ });
+ bench("Entity::getComponent<Transform> (second)", [&](uint64_t ops) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < ops; ++i) {
+   sum += actor->getComponent<Transform>().useCount();
+  }
+  g_sink = g_sink + sum;
+ });
+ bench("Entity::getComponent<Texture> (missing)", [&](uint64_t ops) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < ops; ++i) {
+   sum += actor->getComponent<Texture>().useCount();
+  }
+  g_sink = g_sink + sum;
+ });
+
+ //--- A_Racer
+ for (const std::size_t count : { std::size_t(16), std::size_t(1024) }) {
+  auto racers = makeRacers(count, waypoints);
+  const std::string suffix = " (" + std::to_string(count) + " racers)";
+
+  bench("A_Racer::steerPhysics" + suffix, [&](uint64_t ops) {
+   for (uint64_t i = 0; i < ops; ++i) {
+    racers[i % racers.size()]->steerPhysics(1.f / 60.f);
+   }
+  });
+
+  bench("A_Racer::getProgressMeters" + suffix, [&](uint64_t ops) {
+   float sum = 0.f;
+   for (uint64_t i = 0; i < ops; ++i) {
+    sum += racers[i % racers.size()]->getProgressMeters();
+   }
+   g_sink = g_sink + static_cast<uint64_t>(sum);
+  });
+
+  //una operacion = ordenar todo el peloton
+  std::vector<A_Racer::PlaceEntry> placeScratch;
+  bench("A_Racer::updatePlaces" + suffix, [&](uint64_t ops) {
+   for (uint64_t i = 0; i < ops; ++i) {
+    A_Racer::updatePlaces(racers, placeScratch);
+   }
+   g_sink = g_sink + racers.front()->getPlace();
+  });
+ }
+
+ //--- SpatialGrid: cajas de 16 a 48 unidades en un mundo que crece con N (densidad fija)
+ for (const std::size_t count : { std::size_t(1024), std::size_t(65536) }) {
+  const float side = 64.f * std::sqrt(static_cast<float>(count));
+  std::mt19937 random(4321);
+  std::uniform_real_distribution<float> position(0.f, side);
+  std::uniform_real_distribution<float> size(16.f, 48.f);
+  std::vector<sf::FloatRect> boxes(count);
+  SpatialGrid grid(64.f);
+  for (std::size_t i = 0; i < count; ++i) {
+   boxes[i] = sf::FloatRect({ position(random), position(random) }, { size(random), size(random) });
+   grid.update(static_cast<int>(i), boxes[i]);
+  }
+  std::vector<sf::Vector2f> points(1024);
+  for (sf::Vector2f& point : points) {
+   point = { position(random), position(random) };
+  }
+  std::vector<int> found;
+  found.reserve(count);
+  const std::string suffix = " (" + std::to_string(count) + " items)";
+
+  bench("SpatialGrid::queryPoint" + suffix, [&](uint64_t ops) {
+   uint64_t sum = 0;
+   for (uint64_t i = 0; i < ops; ++i) {
+    found.clear();
+    grid.queryPoint(points[i % points.size()], found);
+    sum += found.size();
+   }
+   g_sink = g_sink + sum;
+  });
+
+  //referencia: lo que costaba el pick probando todas las cajas
+  bench("Linear point test" + suffix, [&](uint64_t ops) {
+   uint64_t sum = 0;
+   for (uint64_t i = 0; i < ops; ++i) {
+    const sf::Vector2f& point = points[i % points.size()];
+    for (const sf::FloatRect& box : boxes) {
+     sum += box.contains(point) ? 1 : 0;
+    }
+   }
+   g_sink = g_sink + sum;
+  });
+
+  //una operacion = seleccion con caja de 256x256 unidades
+  bench("SpatialGrid::queryRect 256x256" + suffix, [&](uint64_t ops) {
+   uint64_t sum = 0;
+   for (uint64_t i = 0; i < ops; ++i) {
+    found.clear();
+    grid.queryRect(sf::FloatRect(points[i % points.size()], { 256.f, 256.f }), found);
+    sum += found.size();
+   }
+   g_sink = g_sink + sum;
+  });
+
+  //movimiento de un frame: la mitad de las veces la caja cambia de celdas
+  bench("SpatialGrid::update (moved)" + suffix, [&](uint64_t ops) {
+   for (uint64_t i = 0; i < ops; ++i) {
+    const std::size_t id = i % count;
+    const float step = (i / count) & 1 ? -20.f : 20.f;
+    boxes[id].position.x += step;
+    grid.update(static_cast<int>(id), boxes[id]);
+   }
+  });
+ }
+
+ //--- ResourceManager::getTexture con la cache llena de entradas
+ ResourceManager& resources = ResourceManager::getInstance();
+ std::vector<StringId> keys;
+ for (int i = 0; i < 1000; ++i) {
+  const StringId key(std::string("Bench/Texture_") + std::to_string(i));
+  resources.getTextureCache().insert(key, EngineUtilities::MakeShared<Texture>());
+  keys.push_back(key);
+ }
+ bench("ResourceManager::getTexture (StringId)", [&](uint64_t ops) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < ops; ++i) {
+   sum += resources.getTexture(keys[i % keys.size()]).useCount();
+  }
+  g_sink = g_sink + sum;
+ });
+ const std::string name = "Bench/Texture_500";
+ bench("ResourceManager::getTexture (std::string)", [&](uint64_t ops) {
+  uint64_t sum = 0;
+  for (uint64_t i = 0; i < ops; ++i) {
+   sum += resources.getTexture(StringId(name)).useCount();
+  }
+  g_sink = g_sink + sum;
+ });
+
+ if (!config.jsonFile.empty()) {
+  if (!writeJson(config.jsonFile, config, results)) {
+   std::cerr << "Can't write " << config.jsonFile << "\n";
+   return 1;
+  }
+  std::cout << "Results written to " << config.jsonFile << "\n";
+ }
+ return 0;
+}
@@ -24,6 +24,15 @@
   */
 class A_Racer : public Actor {
 public:
+ /**
+  * @brief Sort entry of @ref updatePlaces: one per racer.
+  */
+ struct
+  PlaceEntry {
+  float progress;      ///< Track progress in meters, read once per racer.
+  A_Racer* racer;      ///< Racer the progress belongs to.
+ };
+
  /**
   * @brief Constructs a racer.
   * @param name Display name for this racer.
@@ -39,6 +48,23 @@ public:
  void
   update(float deltaTime) override;
 
+ /**
+  * @brief Applies steering forces, drag, and integration to update velocity/position.
+  * @param dt Time step in seconds.
+  * @note Called by @ref update; public so benchmarks can time it on its own.
+  */
+ void 
+  steerPhysics(float dt);
+
+ /**
+  * @brief Ranks racers by progress and stores each one's place (1 = leader).
+  * @param racers Racers to rank.
+  * @param scratch Sort buffer owned by the caller; reused between calls it stops allocating once it has grown.
+  */
+ static void
+  updatePlaces(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers,
+               std::vector<PlaceEntry>& scratch);
+
  /**
   * @brief Sets the path this racer should follow.
   * @param waypoints Ordered list of 2D waypoints forming a looped track.
@@ -159,13 +185,6 @@ private:
  float
   linearDrag = 0.12f;
 
- /**
-  * @brief Applies steering forces, drag, and integration to update velocity/position.
-  * @param dt Time step in seconds.
-  */
- void 
-  steerPhysics(float dt);
-
  /**
   * @brief Computes the total length of the waypoint loop.
   * @return Sum of segment lengths between consecutive waypoints (including wrap).
@@ -17,8 +17,10 @@
 #include "Prerequisites.h"
 #include "ECS/Entity.h"
 #include "CShape.h"
+#include "CTilemap.h"
 #include "ECS/Transform.h"
 #include "ECS/Texture.h"
+#include "Utilities/StringId.h"
 
  /**
   * @class Actor
@@ -31,9 +33,9 @@ class
  Actor : public Entity {
 public:
 /**
- * @brief Default constructor.
+ * @brief Default constructor (bumps @ref getHierarchyVersion).
  */
- Actor() = default;
+ Actor();
 
 /**
  * @brief Constructs an Actor with a given name.
@@ -42,9 +44,9 @@ public:
  Actor(const std::string& actorName);
 
  /**
-  * @brief Default destructor.
+  * @brief Destructor (bumps @ref getHierarchyVersion).
   */
- virtual ~Actor() = default;
+ virtual ~Actor();
 
  /**
   * @brief Called once when the actor is started.
@@ -86,12 +88,62 @@ public:
 
  /**
   * @brief Gets the actor's display name.
-  * @return The current name of this actor.
+  * @return The current name of this actor (interned text of @ref getNameId).
+  * @note Cached on construction: no intern table lookup per call.
   */
- std::string getName() const {
+ const std::string&
+  getName() const {
+  return *m_nameText;
+ }
+
+ /**
+  * @brief Gets the actor's name as an id, for comparisons and lookups.
+  */
+ StringId
+  getNameId() const {
   return m_name;
  }
 
+ /**
+  * @brief Sets the parent of the actor in the scene hierarchy.
+  * @param parent New parent, or nullptr to make the actor a root.
+  * @return false (and nothing changes) if @p parent is this actor or one of its descendants.
+  * @note The parent is not owned: it must outlive the actor or be cleared first.
+  */
+ bool
+  setParent(Actor* parent);
+
+ /**
+  * @brief Gets the parent of the actor, or nullptr for a root.
+  */
+ Actor*
+  getParent() const {
+  return m_parent;
+ }
+
+ /**
+  * @brief Counter bumped by every parent change and by every actor created or destroyed, so views can cache the hierarchy.
+  */
+ static uint32_t
+  getHierarchyVersion();
+
+ /**
+  * @brief Sets the id this actor reports when its bounds move (see @ref takeDirtyBounds).
+  * @param id Index chosen by the owner of the spatial index; -1 stops reporting.
+  */
+ void
+  setBoundsId(int id) {
+  m_boundsId = id;
+ }
+
+ /**
+  * @brief Moves the ids of the actors whose transform was copied to their shape since the last call.
+  * @param out Receives the ids (cleared first); an id may appear more than once.
+  * @note The list is global and not synchronized: update the tracked actors on one thread.
+  */
+ static void
+  takeDirtyBounds(std::vector<int>& out);
+
  /**
   * @brief Retrieves a component of the specified type attached to the actor.
   * @tparam T Type of the component to retrieve.
@@ -111,7 +163,11 @@ public:
  EngineUtilities::TSharedPointer<T> getComponent() const;
 
 private:
- std::string m_name = "Actor"; ///< Name of the actor.
+ StringId m_name{ std::string("Actor") }; ///< Name of the actor (interned).
+ const std::string* m_nameText = &m_name.getString(); ///< Interned text of @ref m_name (never moves).
+ Actor* m_parent = nullptr;               ///< Parent in the scene hierarchy (not owned).
+ uint32_t m_syncedShapeRevision = 0;      ///< CShape revision the transform was last copied to.
+ int m_boundsId = -1;                     ///< Id reported when the bounds move (-1: not tracked).
 };
 
 template<typename T>
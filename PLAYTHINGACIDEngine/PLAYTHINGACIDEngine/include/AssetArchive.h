@@ -0,0 +1,182 @@
+/**
+ * @file AssetArchive.h
+ * @brief Packed, memory-mapped asset archive (`.pak`).
+ *
+ * @details
+ * Layout (little endian):
+ *  - @ref AssetArchive::Header;
+ *  - entry payloads, each starting at a multiple of the archive alignment;
+ *  - name table: NUL-terminated entry names;
+ *  - index: @ref AssetArchive::Entry records sorted by name hash (then name).
+ *
+ * Opening maps the file and validates the header, so it takes constant time
+ * whatever the number of entries. Lookups binary-search the index by the
+ * 64-bit FNV-1a hash of the name. Entries stored uncompressed are returned as
+ * spans into the mapping (no copy); compressed ones are inflated into a buffer
+ * supplied by the caller.
+ *
+ * Archives are written offline with @ref AssetArchive::build (see the
+ * AssetTool `pack` command).
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include "Utilities/MappedFile.h"
+#include "Utilities/StringId.h"
+
+/**
+ * @struct ByteSpan
+ * @brief Non-owning view of a byte range.
+ */
+struct
+ ByteSpan {
+ const uint8_t* data = nullptr;  ///< First byte.
+ std::size_t size = 0;           ///< Number of bytes.
+
+ /**
+  * @brief Returns true if the span has no bytes.
+  */
+ bool
+  empty() const { return data == nullptr || size == 0; }
+};
+
+/**
+ * @class AssetArchive
+ * @brief Read-only view of a packed archive plus the offline builder.
+ */
+class
+ AssetArchive {
+public:
+ /** @brief Entry flag: payload compressed with @ref Compression. */
+ static constexpr uint32_t FLAG_COMPRESSED = 1u << 0;
+
+ /**
+  * @brief Fixed header at offset 0.
+  */
+ struct
+  Header {
+  char magic[4];           ///< "PAK1".
+  uint32_t version;        ///< Format version.
+  uint32_t entryCount;     ///< Number of index records.
+  uint32_t alignment;      ///< Payload alignment in bytes.
+  uint64_t indexOffset;    ///< Offset of the index.
+  uint64_t namesOffset;    ///< Offset of the name table.
+  uint64_t namesSize;      ///< Size of the name table.
+ };
+
+ /**
+  * @brief Index record.
+  */
+ struct
+  Entry {
+  uint64_t hash;           ///< @ref hashName of the entry name.
+  uint64_t offset;         ///< Payload offset.
+  uint64_t storedSize;     ///< Payload size in the archive.
+  uint64_t size;           ///< Uncompressed size.
+  uint32_t nameOffset;     ///< Name offset inside the name table.
+  uint32_t flags;          ///< FLAG_* bits.
+ };
+
+ /**
+  * @brief File to pack.
+  */
+ struct
+  BuildInput {
+  std::string name;        ///< Name the engine asks for (e.g. "Sprites/WhiteCamo.png").
+  std::string sourceFile;  ///< File to read.
+ };
+
+ /**
+  * @brief Default constructor (no archive open).
+  */
+ AssetArchive() = default;
+
+ /**
+  * @brief Maps an archive.
+  * @param fileName Archive file.
+  * @return True if the file is a valid archive.
+  */
+ bool
+  open(const std::string& fileName);
+
+ /**
+  * @brief Unmaps the archive; spans handed out become invalid.
+  */
+ void
+  close();
+
+ /**
+  * @brief Returns true if an archive is open.
+  */
+ bool
+  isOpen() const { return m_index != nullptr; }
+
+ /**
+  * @brief Finds an entry by name.
+  * @param name Entry name ('\\' and leading "./" are ignored).
+  * @return Index record, or null if absent.
+  */
+ const Entry*
+  find(const std::string& name) const;
+
+ /**
+  * @brief Gets the bytes of an entry.
+  * @param entry Record returned by @ref find.
+  * @param storage Buffer used when the entry must be decompressed.
+  * @return Span into the mapping (uncompressed) or into @p storage; empty on error.
+  *
+  * @details
+  * Thread-safe: the mapping is never modified.
+  */
+ ByteSpan
+  getBytes(const Entry& entry, std::vector<uint8_t>& storage) const;
+
+ /**
+  * @brief Gets the number of entries.
+  */
+ std::size_t
+  getEntryCount() const { return m_entryCount; }
+
+ /**
+  * @brief Gets an entry by index position.
+  */
+ const Entry&
+  getEntry(std::size_t index) const { return m_index[index]; }
+
+ /**
+  * @brief Gets the name of an entry.
+  */
+ const char*
+  getName(const Entry& entry) const { return m_names + entry.nameOffset; }
+
+ /**
+  * @brief Hashes an entry name (64-bit FNV-1a over the normalized name).
+  */
+ static uint64_t
+  hashName(const std::string& name);
+
+ /**
+  * @brief Normalizes an entry name: forward slashes, no leading "./".
+  */
+ static std::string
+  normalizeName(const std::string& name);
+
+ /**
+  * @brief Writes an archive.
+  * @param outputFile Archive to create.
+  * @param inputs Files to pack.
+  * @param compress Compress entries (kept raw when compression does not help).
+  * @param alignment Payload alignment in bytes (power of two).
+  * @return True on success.
+  */
+ static bool
+  build(const std::string& outputFile, const std::vector<BuildInput>& inputs,
+        bool compress, uint32_t alignment = 16);
+
+private:
+ MappedFile m_file;                 ///< Mapped archive.
+ const Entry* m_index = nullptr;    ///< Sorted index inside the mapping.
+ const char* m_names = nullptr;     ///< Name table inside the mapping.
+ std::size_t m_namesSize = 0;       ///< Name table size.
+ std::size_t m_entryCount = 0;      ///< Number of entries.
+};
@@ -19,6 +19,13 @@
 #include "Actor.h"
 #include "EngineGUI.H"
 #include "A_Racer.h"
+#include "Render/RenderThread.h"
+#include "Render/Camera.h"
+#include "Render/ParticleSystem.h"
+#include "Render/VirtualTexture.h"
+#include "Utilities/FrameStats.h"
+#include "Utilities/SpatialGrid.h"
+#include "StressScene.h"
 
  /**
   * @class BaseApp
@@ -42,14 +49,25 @@ public:
 
  /**
  * @brief Entry point for running the application.
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
  * @return Exit code from the application.
  *
  * @details
  * Typically performs initialization, enters the main loop (calling @ref update and
  * @ref render once per frame), and finalizes resources at shutdown.
+ *
+ * Options: `--startup-trace[=file.json]` writes the start-up timeline as a
+ * Chrome trace (default `startup_trace.json`); `--startup-summary` prints it
+ * as a table. Start-up ends once the initial textures finished loading.
+ * `--stress=N` replaces the demo scene with a generated one (see StressScene.h);
+ * with `--headless` it runs without a window. `--assert-no-alloc[=frames]`
+ * stops the program when a frame allocates after the warm-up (default 300
+ * frames, see MemoryTracker.h). `--log-level=` sets the minimum severity that
+ * is logged and `--log-file=` the log file (default `engine.log`).
  */
  int
-  run();
+  run(int argc = 0, char* argv[] = nullptr);
 
  /**
  * @brief Initializes the application and its subsystems.
@@ -66,17 +84,28 @@ public:
  * @brief Updates application logic once per frame.
  *
  * @details
- * Advances simulation state (actors, racers, GUI, etc.). The time step handling
- * (fixed vs. variable) depends on the implementation in the .cpp file.
+ * Advances simulation state (actors, racers, ranking). It does not touch ImGui,
+ * so it overlaps with the render thread drawing the previous frame.
  */
  void
   update();
 
+ /**
+ * @brief Processes window events and builds the GUI frame.
+ *
+ * @details
+ * Waits until the render thread has drawn the previous GUI frame, because ImGui
+ * keeps a single global context.
+ */
+ void
+  updateGUI();
+
  /**
  * @brief Renders the current frame.
  *
  * @details
- * Submits draw calls for scene objects and GUI elements to the active window/context.
+ * Records the scene into a @ref DrawCommandList. With the render thread running
+ * the list is submitted to it; otherwise it is executed immediately.
  */
  void
   render();
@@ -91,10 +120,95 @@ public:
   destroy();
 
 private:
+ /**
+  * @brief Records the scene draw commands of the current frame.
+  * @param commandList Destination list.
+  */
+ void
+  recordFrame(DrawCommandList& commandList);
+
+ /**
+  * @brief Feeds follow targets to the cameras and advances them.
+  * @param deltaTime Time elapsed since the last frame, in seconds.
+  */
+ void
+  updateCameras(float deltaTime);
+
+ /**
+  * @brief Queues the actors reported by Actor::takeDirtyBounds for @ref m_pickGrid.
+  *
+  * @details
+  * The grid is rebuilt when @ref m_actors changes: another buffer or size, or
+  * a new Actor::getHierarchyVersion (an actor created, destroyed or reparented).
+  * Moved actors are queued once each and only moved in the grid by
+  * @ref syncPickGrid, so a frame without picks does not touch (or grow) its cells.
+  */
+ void
+  updatePickIndex();
+
+ /**
+  * @brief Moves the queued actors in @ref m_pickGrid; called before a query.
+  */
+ void
+  syncPickGrid();
+
+ /**
+  * @brief Click and box selection in the viewport, answered by @ref m_pickGrid and exact CShape tests.
+  *
+  * @details
+  * A click picks the top-most actor under the cursor; a drag selects every
+  * actor overlapping the box. Shift or Ctrl adds to the selection. Clicks
+  * over ImGui windows are ignored.
+  */
+ void
+  updatePicking();
+
+ /**
+  * @brief Records the scene as seen by one camera, skipping what it cannot see.
+  * @param commandList Destination list.
+  * @param camera Camera to cull against, or null to record everything with the default view.
+  */
+ void
+  recordScene(DrawCommandList& commandList, const Camera* camera);
+
+ /**
+  * @brief Creates the demo waypoints and the three racers on their grid.
+  */
+ void
+  createDemoScene();
+
+ /**
+  * @brief Creates a generated track and @ref m_stress racers.
+  * @param area World rectangle that contains the track.
+  */
+ void
+  createStressScene(const sf::FloatRect& area);
+
+ /**
+  * @brief Creates the particle layers and attaches the emitters to every racer.
+  */
+ void
+  createEffects();
+
+ /**
+  * @brief Runs the stress scene for a fixed number of ticks without window or GUI.
+  * @return Exit code.
+  */
+ int
+  runHeadless();
+
+ /**
+  * @brief Arms the steady-state allocation assert when `--assert-no-alloc` was given.
+  */
+ void
+  armAllocationAssert();
+
  /** @brief Generic scene actors owned by the application. */
  std::vector<EngineUtilities::TSharedPointer<Actor>>  m_actors;
  /** @brief Racer-specific actors used in the racing scenario. */
  std::vector<EngineUtilities::TSharedPointer<A_Racer>> m_racers;
+ /** @brief Sort buffer of @ref A_Racer::updatePlaces, kept between frames. */
+ std::vector<A_Racer::PlaceEntry> m_placeScratch;
 
  /** @brief Primary application window. */
  EngineUtilities::TSharedPointer<Window> m_windowPtr;
@@ -106,6 +220,72 @@ private:
  /** @brief Current waypoint index for any global/path-related iteration. */
  size_t m_currentWaypointIndex = 0;
 
+ /** @brief Scene cameras, rendered in order (later cameras draw on top). */
+ std::vector<Camera> m_cameras;
+
+ /** @brief Pooled effects (tire smoke and sparks attached to the racers). */
+ ParticleSystem m_particles;
+
+ /** @brief Full resolution track image, streamed by tiles (replaces the tilemap when open). */
+ VirtualTexture m_trackTexture;
+
  /** @brief Immediate-mode engine GUI wrapper for runtime overlays/controls. */
  EngineGUI m_engineGUI;
+
+ /** @brief Dedicated thread that owns the GL context and executes submitted frames. */
+ RenderThread m_renderThread;
+ /** @brief Command list used when rendering on the main thread. */
+ DrawCommandList m_frameCommands;
+ /** @brief Runs rendering on @ref m_renderThread instead of the main thread. */
+ bool m_threadedRendering = true;
+ /** @brief Chrome trace file for the start-up timeline (empty: not written). */
+ std::string m_startupTraceFile;
+ /** @brief Print the start-up timeline table. */
+ bool m_printStartupSummary = false;
+ /** @brief Frames to capture to @ref m_captureFile from the first frame (0: none). */
+ uint32_t m_captureFrameCount = 0;
+ /** @brief Chrome trace file of the frame capture. */
+ std::string m_captureFile = "frame_trace.json";
+ /** @brief Frame, simulation, GUI and render durations. */
+ FrameStats m_frameStats;
+ /** @brief Per-frame CSV written on exit (empty: not written). */
+ std::string m_frameStatsFile = "frame_stats.csv";
+ /** @brief Stress mode options (racers == 0: demo scene). */
+ StressConfig m_stress;
+ /** @brief Generated scene and its timings (null outside stress mode). */
+ EngineUtilities::TSharedPointer<StressScene> m_stressScene;
+ /** @brief Process memory before spawning the stress racers. */
+ StressScene::ProcessMemory m_stressMemoryBefore;
+ /** @brief Process memory after spawning the stress racers and their emitters. */
+ StressScene::ProcessMemory m_stressMemoryAfter;
+ /** @brief Fail when the frame loop allocates after @ref m_assertNoAllocWarmup frames. */
+ bool m_assertNoAlloc = false;
+ /** @brief Frames allowed to allocate before the assert is armed. */
+ uint32_t m_assertNoAllocWarmup = 300;
+ /** @brief Minimum severity logged at runtime. */
+ LogSeverity m_logLevel = LOG_SEVERITY_INFO;
+ /** @brief Log file (empty: not written). */
+ std::string m_logFile = "engine.log";
+ /** @brief Spatial index of the actor bounds (ids are indices into @ref m_actors). */
+ SpatialGrid m_pickGrid;
+ /** @brief Shape of each actor, cached when the actor list changes. */
+ std::vector<CShape*> m_pickShapes;
+ /** @brief Actors whose bounds moved this frame, from Actor::takeDirtyBounds (reused). */
+ std::vector<int> m_pickDirty;
+ /** @brief Actors moved since the last @ref syncPickGrid (each once; capacity of m_actors). */
+ std::vector<int> m_pickMoved;
+ /** @brief Per actor: already in @ref m_pickMoved. */
+ std::vector<uint8_t> m_pickQueued;
+ /** @brief m_actors.data() when @ref m_pickGrid was built. */
+ const void* m_pickSource = nullptr;
+ /** @brief Actor::getHierarchyVersion when @ref m_pickGrid was built. */
+ uint32_t m_pickVersion = 0;
+ /** @brief Grid candidates of the last pick (reused). */
+ std::vector<int> m_pickCandidates;
+ /** @brief Actors that passed the exact test in the last pick (reused). */
+ std::vector<int> m_pickResult;
+ /** @brief Mouse position where the current click or drag started. */
+ sf::Vector2f m_pickStart;
+ /** @brief Camera the current click or drag started in (-1: none). */
+ int m_pickCamera = -1;
 };
@@ -4,6 +4,7 @@
 #include "ECS\Texture.h"
 
 class Window;
+class DrawCommandList;
 //class Texture;
 
 /**
@@ -62,6 +63,36 @@ public:
  void
   render(const EngineUtilities::TSharedPointer<Window>& window) override;
 
+ /**
+  * @brief Records the shape into a frame command list instead of drawing it.
+  * @param commandList List consumed later by the render thread.
+  */
+ void
+  record(DrawCommandList& commandList) const;
+
+ /**
+  * @brief Gets the world-space bounding box of the shape.
+  * @return Bounds after the shape transform (empty if there is no shape).
+  */
+ sf::FloatRect
+  getGlobalBounds() const;
+
+ /**
+  * @brief Exact test of a world point against the transformed outline.
+  * @param point World position.
+  * @return true if the point is inside the shape (false if there is no shape).
+  */
+ bool
+  containsPoint(const sf::Vector2f& point) const;
+
+ /**
+  * @brief Exact test of a world rectangle against the transformed outline.
+  * @param rect World rectangle.
+  * @return true if the rectangle and the shape overlap (false if there is no shape).
+  */
+ bool
+  intersectsRect(const sf::FloatRect& rect) const;
+
  /**
   * @brief Releases any allocated resources or references.
   */
@@ -111,8 +142,16 @@ public:
  void
   setTexture(const EngineUtilities::TSharedPointer<Texture>& texture);
 
+ /**
+  * @brief Counter bumped by @ref createShape (a new shape needs the whole transform again).
+  */
+ uint32_t
+  getShapeRevision() const { return m_shapeRevision; }
+
 private:
  EngineUtilities::TSharedPointer<sf::Shape> m_shapePtr; ///< Pointer to the SFML shape.
+ EngineUtilities::TSharedPointer<Texture> m_texture;    ///< Texture applied to the shape.
+ uint32_t m_textureRevision = 0;                        ///< Texture revision the shape was set up with.
  ShapeType m_shapeType;                                 ///< Type of the shape (circle, rectangle, etc.).
- sf::VertexArray* m_line;                               ///< Optional pointer to a line (not currently used).
+ uint32_t m_shapeRevision = 0;                          ///< Shapes created so far.
 };
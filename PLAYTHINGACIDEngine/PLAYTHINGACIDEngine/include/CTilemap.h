@@ -0,0 +1,228 @@
+#pragma once
+#include "Prerequisites.h"
+#include "ECS\Component.h"
+#include "ECS\Reflection.h"
+#include "ECS\Texture.h"
+
+class Window;
+class DrawCommandList;
+
+/**
+ * @class CTilemap
+ * @brief Component that draws a large grid of tiles from a tileset, split in chunks.
+ *
+ * The map is divided in square chunks of tiles. A chunk's vertex array (two
+ * triangles per tile, in world space) is built the first time the chunk is seen
+ * and rebuilt only when one of its tiles changes. Rendering walks only the
+ * chunks overlapping the visible rectangle, and since every chunk shares the
+ * tileset texture they merge into a single draw call. Vertex arrays of chunks
+ * that stay out of view for a while are released, so memory follows what is
+ * visible instead of the size of the world.
+ */
+class
+ CTilemap : public Component {
+public:
+ /** @brief Tile id of an empty cell. */
+ static constexpr uint16_t EMPTY_TILE = 0xFFFF;
+
+ /**
+  * @brief Default constructor.
+  */
+ CTilemap() : Component(ComponentType::TILEMAP) {}
+
+ /**
+  * @brief Virtual destructor.
+  */
+ virtual ~CTilemap() = default;
+
+ /**
+  * @brief Allocates an empty map.
+  * @param width Width in tiles.
+  * @param height Height in tiles.
+  * @param tileSize World size of one tile.
+  * @param chunkSize Chunk side in tiles.
+  */
+ void
+  create(unsigned int width, unsigned int height, const sf::Vector2f& tileSize, unsigned int chunkSize = 32);
+
+ /**
+  * @brief Sets the tileset texture and the pixel size of one tile in it.
+  * @param texture Tileset; tile ids are numbered row by row.
+  * @param tilePixels Size of a tileset cell in pixels.
+  */
+ void
+  setTileset(const EngineUtilities::TSharedPointer<Texture>& texture, const sf::Vector2u& tilePixels);
+
+ /**
+  * @brief Builds a map that shows a whole image, sliced in tiles (tile id = cell index).
+  * @param texture Image to show.
+  * @param tilePixels Size of a tile in pixels.
+  * @param worldSize World size the whole image covers.
+  * @param chunkSize Chunk side in tiles.
+  */
+ void
+  createFromImage(const EngineUtilities::TSharedPointer<Texture>& texture,
+                  const sf::Vector2u& tilePixels,
+                  const sf::Vector2f& worldSize,
+                  unsigned int chunkSize = 32);
+
+ /**
+  * @brief Called once when the component is initialized.
+  */
+ void
+  start() override {}
+
+ /**
+  * @brief Advances the frame counter and releases chunks that left the view.
+  * @param deltaTime Time elapsed since last frame.
+  */
+ void
+  update(float deltaTime) override;
+
+ /**
+  * @brief Draws every chunk directly to the window.
+  * @param window Target window.
+  */
+ void
+  render(const EngineUtilities::TSharedPointer<Window>& window) override;
+
+ /**
+  * @brief Records the chunks overlapping a rectangle into a command list.
+  * @param commandList Destination list.
+  * @param visibleRect World rectangle to cull against, or null for the whole map.
+  */
+ void
+  record(DrawCommandList& commandList, const sf::FloatRect* visibleRect = nullptr);
+
+ /**
+  * @brief Releases the map.
+  */
+ void
+  destroy() override;
+
+ /**
+  * @brief Changes one tile and marks its chunk for rebuild.
+  * @param x Column.
+  * @param y Row.
+  * @param tile Tile id, or @ref EMPTY_TILE.
+  */
+ void
+  setTile(unsigned int x, unsigned int y, uint16_t tile);
+
+ /**
+  * @brief Gets a tile id (EMPTY_TILE outside the map).
+  * @param x Column.
+  * @param y Row.
+  */
+ uint16_t
+  getTile(unsigned int x, unsigned int y) const;
+
+ /**
+  * @brief Moves the map; every built chunk is rebuilt.
+  * @param origin World position of the top-left corner.
+  */
+ void
+  setOrigin(const sf::Vector2f& origin);
+
+ /**
+  * @brief Gets the world rectangle covered by the map.
+  */
+ sf::FloatRect
+  getWorldBounds() const;
+
+ /**
+  * @brief Sets how many frames a chunk may stay out of view before its vertices are freed.
+  * @param frames Frame count (0 keeps every chunk built).
+  */
+ void
+  setEvictionFrames(unsigned int frames) { m_evictionFrames = frames; }
+
+ /**
+  * @brief Gets the total number of chunks.
+  */
+ std::size_t
+  getChunkCount() const { return m_chunks.size(); }
+
+ /**
+  * @brief Gets the number of chunks holding vertex data.
+  */
+ std::size_t
+  getResidentChunkCount() const { return m_residentChunks; }
+
+ /**
+  * @brief Gets the number of chunks recorded in the last call to @ref record.
+  */
+ std::size_t
+  getVisibleChunkCount() const { return m_visibleChunks; }
+
+ /**
+  * @brief Returns the reflected fields (the eviction delay).
+  */
+ const ReflectClass*
+  getReflection() const override;
+
+private:
+ friend struct Reflect<CTilemap>;
+
+ /**
+  * @brief Square block of tiles with its own vertex array.
+  */
+ struct
+  Chunk {
+  std::vector<sf::Vertex> vertices;  ///< Two triangles per non-empty tile.
+  bool dirty = true;                 ///< Vertices must be rebuilt.
+  uint64_t lastVisibleFrame = 0;     ///< Frame the chunk was last recorded.
+ };
+
+ /**
+  * @brief Rebuilds the vertex array of a chunk.
+  */
+ void
+  buildChunk(unsigned int chunkX, unsigned int chunkY);
+
+ /**
+  * @brief Returns the chunk, building it first if needed.
+  */
+ Chunk&
+  touchChunk(unsigned int chunkX, unsigned int chunkY);
+
+ unsigned int m_width = 0;                        ///< Width in tiles.
+ unsigned int m_height = 0;                       ///< Height in tiles.
+ unsigned int m_chunkSize = 32;                   ///< Chunk side in tiles.
+ unsigned int m_chunksX = 0;                      ///< Chunks per row.
+ unsigned int m_chunksY = 0;                      ///< Chunks per column.
+ sf::Vector2f m_tileSize = { 32.f, 32.f };        ///< World size of a tile.
+ sf::Vector2f m_origin = { 0.f, 0.f };            ///< World position of the map corner.
+ std::vector<uint16_t> m_tiles;                   ///< Tile ids, row major.
+ std::vector<Chunk> m_chunks;                     ///< Chunks, row major.
+
+ EngineUtilities::TSharedPointer<Texture> m_tileset; ///< Tileset texture.
+ sf::Vector2u m_tilePixels = { 32, 32 };          ///< Tileset cell size in pixels.
+ unsigned int m_tilesetColumns = 1;               ///< Cells per tileset row.
+
+ uint64_t m_frame = 1;                            ///< Frame counter for eviction.
+ unsigned int m_evictionFrames = 120;             ///< Frames before an unseen chunk is freed.
+ std::size_t m_residentChunks = 0;                ///< Chunks with vertex data.
+ std::size_t m_visibleChunks = 0;                 ///< Chunks recorded last time.
+};
+
+/**
+ * @brief Field table of CTilemap.
+ */
+template<>
+struct
+ Reflect<CTilemap> {
+ static const ReflectClass&
+  get() {
+  static const ReflectField fields[] = {
+   REFLECT_FIELD(CTilemap, m_evictionFrames, "Eviction frames", 0.0f, 3600.0f, 1.0f),
+  };
+  static const ReflectClass info = makeReflectClass("Tilemap", fields);
+  return info;
+ }
+};
+
+inline const ReflectClass*
+CTilemap::getReflection() const {
+ return &Reflect<CTilemap>::get();
+}
@@ -0,0 +1,137 @@
+/**
+ * @file CookedTexture.h
+ * @brief Pre-decoded texture blob (`.ctex`) and its offline cooker.
+ *
+ * @details
+ * A cooked texture stores the pixels exactly as the GPU takes them, so loading
+ * it skips PNG decoding: the blob is read (or inflated, if compressed) and
+ * handed to `sf::Texture::update`.
+ *
+ * Layout (little endian):
+ *  - @ref CookedTexture::Header;
+ *  - pixel data, RGBA8, level 0 first and then each mip level down to 1x1,
+ *    optionally compressed as a whole with @ref Compression.
+ *
+ * Blobs are written offline with @ref CookedTexture::cook (see the AssetTool
+ * `cook` command) next to their source image, with the `.ctex` extension.
+ *
+ * @note Premultiplied blobs must be drawn with a premultiplied blend mode
+ * (`One, OneMinusSrcAlpha`); @ref isPremultiplied tells which one applies.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include "AssetArchive.h"
+
+/**
+ * @class CookedTexture
+ * @brief Parsed view of a cooked texture blob, ready to upload.
+ */
+class
+ CookedTexture {
+public:
+ /** @brief Header flag: color channels premultiplied by alpha. */
+ static constexpr uint32_t FLAG_PREMULTIPLIED = 1u << 0;
+ /** @brief Header flag: pixel data compressed with @ref Compression. */
+ static constexpr uint32_t FLAG_COMPRESSED = 1u << 1;
+
+ /**
+  * @brief Fixed header at offset 0.
+  */
+ struct
+  Header {
+  char magic[4];         ///< "CTX1".
+  uint32_t version;      ///< Format version.
+  uint32_t width;        ///< Level 0 width.
+  uint32_t height;       ///< Level 0 height.
+  uint32_t mipCount;     ///< Number of levels (1 = no mips).
+  uint32_t flags;        ///< FLAG_* bits.
+  uint64_t pixelBytes;   ///< Size of all levels, uncompressed.
+  uint64_t storedBytes;  ///< Size of the pixel data in the blob.
+ };
+
+ /**
+  * @brief Cooking options.
+  */
+ struct
+  CookOptions {
+  bool premultiply = false;  ///< Premultiply color by alpha.
+  bool mipmaps = false;      ///< Precompute the mip chain (2x2 box filter).
+  bool compress = false;     ///< Compress the pixel data (kept raw if it does not shrink).
+ };
+
+ /**
+  * @brief Default constructor (nothing parsed).
+  */
+ CookedTexture() = default;
+
+ /**
+  * @brief Parses a blob.
+  * @param blob Blob bytes.
+  * @return True if the blob is valid.
+  *
+  * @details
+  * Uncompressed pixels are not copied: @p blob must stay alive until the
+  * texture is uploaded (archive mappings live as long as the archive is
+  * mounted). Compressed pixels are inflated into an internal buffer.
+  */
+ bool
+  parse(ByteSpan blob);
+
+ /**
+  * @brief Returns true if a blob was parsed.
+  */
+ bool
+  isValid() const { return m_pixels != nullptr; }
+
+ /**
+  * @brief Uploads the pixels (and precomputed mips) to a texture.
+  * @param texture Destination; resized if needed.
+  * @return True on success.
+  *
+  * @details
+  * Must run on a thread with an active OpenGL context.
+  */
+ bool
+  upload(sf::Texture& texture) const;
+
+ /**
+  * @brief Gets the level 0 size.
+  */
+ sf::Vector2u
+  getSize() const { return { m_header.width, m_header.height }; }
+
+ /**
+  * @brief Gets the number of levels.
+  */
+ uint32_t
+  getMipCount() const { return m_header.mipCount; }
+
+ /**
+  * @brief Returns true if the color channels are premultiplied by alpha.
+  */
+ bool
+  isPremultiplied() const { return (m_header.flags & FLAG_PREMULTIPLIED) != 0; }
+
+ /**
+  * @brief Writes a cooked blob.
+  * @param image Source image.
+  * @param options Cooking options.
+  * @param output Receives the blob.
+  * @return False if the image is empty.
+  */
+ static bool
+  cook(const sf::Image& image, const CookOptions& options, std::vector<uint8_t>& output);
+
+ /**
+  * @brief Gets the cooked file that belongs to a texture.
+  * @param fileName Base file name (without extension), as given to the ResourceManager.
+  */
+ static std::string
+  getCookedPath(const std::string& fileName) { return fileName + ".ctex"; }
+
+private:
+ Header m_header = {};              ///< Parsed header.
+ const uint8_t* m_pixels = nullptr; ///< Level 0 pixels, mips follow.
+ std::vector<uint8_t> m_storage;    ///< Inflated pixels of compressed blobs.
+};
@@ -4,6 +4,9 @@
 class
  Window;
 
+struct
+ ReflectClass;
+
 /**
  * @enum ComponentType
  * @brief Defines the various types of components in the ECS system.
@@ -17,7 +20,8 @@ enum
  PHYSICS = 4,    ///< Physics component (collisions, forces).
  AUDIOSOURCE = 5,///< Audio source component.
  SHAPE = 6,      ///< Shape component (for primitive shapes).
- TEXTURE = 7     ///< Texture component (image data).
+ TEXTURE = 7,    ///< Texture component (image data).
+ TILEMAP = 8     ///< Tilemap component (chunked tile grid).
 };
 
 /**
@@ -78,6 +82,37 @@ public:
   */
  ComponentType getType() const { return m_type; }
 
+ /**
+  * @brief Returns the field metadata of this component (see ECS/Reflection.h).
+  * @return The reflected fields, or nullptr if the component exposes none.
+  */
+ virtual const ReflectClass*
+  getReflection() const { return nullptr; }
+
+ /**
+  * @brief Marks fields as changed so dependent systems refresh only those.
+  * @param fields Change bits (bit i is field i of the reflection table).
+  */
+ void
+  markChanged(uint32_t fields) { m_changedFields |= fields; }
+
+ /**
+  * @brief Gets the fields changed since the last @ref consumeChanges.
+  */
+ uint32_t
+  getChangedFields() const { return m_changedFields; }
+
+ /**
+  * @brief Returns the changed fields and clears them (done by the owner that applies them).
+  */
+ uint32_t
+  consumeChanges() {
+  const uint32_t fields = m_changedFields;
+  m_changedFields = 0;
+  return fields;
+ }
+
 protected:
  ComponentType m_type; ///< The specific type of this component.
+ uint32_t m_changedFields = 0; ///< Fields changed and not yet applied.
 };
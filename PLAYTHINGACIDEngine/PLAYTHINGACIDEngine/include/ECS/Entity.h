@@ -75,6 +75,14 @@ public:
   return EngineUtilities::TSharedPointer<T>();
  }
 
+ /**
+  * @brief Gets every component attached to the entity, in insertion order.
+  */
+ const std::vector<EngineUtilities::TSharedPointer<Component>>&
+  getComponents() const {
+  return components;
+ }
+
 protected:
  bool isActive; ///< Indicates whether the entity is active in the scene.
  uint32_t id; ///< Unique identifier for the entity.
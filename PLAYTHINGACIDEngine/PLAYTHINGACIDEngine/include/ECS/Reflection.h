@@ -0,0 +1,128 @@
+/**
+ * @file Reflection.h
+ * @brief Compile-time field metadata for components (name, type, accessor, range).
+ *
+ * @details
+ * A component describes its editable fields by specializing @ref Reflect with a
+ * static table built from @ref REFLECT_FIELD, and returns that table from
+ * Component::getReflection. Tools (the inspector) generate their editors from
+ * it without knowing the concrete type.
+ *
+ * Fields are reached through a member pointer instantiated per field rather
+ * than a byte offset: components are polymorphic, where `offsetof` is not
+ * portable. Field @c i of a table owns change bit `1u << i`, so a component
+ * can mark exactly the fields it touched (see Component::markChanged).
+ *
+ * @code
+ * template<>
+ * struct Reflect<MyComponent> {
+ *  static const ReflectClass& get() {
+ *   static const ReflectField fields[] = {
+ *    REFLECT_FIELD(MyComponent, m_speed, "Speed", 0.f, 100.f, 0.5f),
+ *   };
+ *   static const ReflectClass info = makeReflectClass("My component", fields);
+ *   return info;
+ *  }
+ * };
+ * @endcode
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+class
+ Component;
+
+/**
+ * @enum ReflectType
+ * @brief Storage type of a reflected field (selects the editor).
+ */
+enum
+ ReflectType {
+ REFLECT_TYPE_BOOL = 0,   ///< bool (checkbox).
+ REFLECT_TYPE_INT = 1,    ///< int.
+ REFLECT_TYPE_UINT = 2,   ///< unsigned int.
+ REFLECT_TYPE_FLOAT = 3,  ///< float.
+ REFLECT_TYPE_VEC2 = 4    ///< sf::Vector2f (two contiguous floats).
+};
+
+/**
+ * @brief Maps a C++ type to its @ref ReflectType (unsupported types do not compile).
+ */
+template<typename F>
+struct
+ ReflectTypeOf;
+
+template<> struct ReflectTypeOf<bool> { static constexpr ReflectType value = REFLECT_TYPE_BOOL; };
+template<> struct ReflectTypeOf<int> { static constexpr ReflectType value = REFLECT_TYPE_INT; };
+template<> struct ReflectTypeOf<unsigned int> { static constexpr ReflectType value = REFLECT_TYPE_UINT; };
+template<> struct ReflectTypeOf<float> { static constexpr ReflectType value = REFLECT_TYPE_FLOAT; };
+template<> struct ReflectTypeOf<sf::Vector2f> { static constexpr ReflectType value = REFLECT_TYPE_VEC2; };
+
+/** @brief Fields a table may hold: field @c i owns change bit `1u << i` of a uint32_t. */
+constexpr std::size_t REFLECT_MAX_FIELDS = 32;
+
+/**
+ * @struct ReflectField
+ * @brief Metadata of one field.
+ */
+struct
+ ReflectField {
+ const char* name;                      ///< Label shown by the editors.
+ ReflectType type;                      ///< Storage type.
+ void* (*address)(Component* object);   ///< Address of the field inside @p object.
+ float min;                             ///< Lower bound (min == max means unbounded).
+ float max;                             ///< Upper bound.
+ float speed;                           ///< Drag speed of the editor.
+};
+
+/**
+ * @struct ReflectClass
+ * @brief Metadata of one component type: its fields, in change-bit order.
+ */
+struct
+ ReflectClass {
+ const char* name;              ///< Display name.
+ const ReflectField* fields;    ///< Field table.
+ uint32_t fieldCount;           ///< Entries in @ref fields (@ref REFLECT_MAX_FIELDS at most, one change bit each).
+};
+
+/**
+ * @brief Builds the ReflectClass of a field table, checking its size at compile time.
+ * @param name Display name.
+ * @param fields Field table (a static array, so its size is known).
+ */
+template<std::size_t N>
+ReflectClass
+makeReflectClass(const char* name, const ReflectField (&fields)[N]) {
+ static_assert(N <= REFLECT_MAX_FIELDS, "Reflect: more fields than change bits (32)");
+ return ReflectClass{ name, fields, static_cast<uint32_t>(N) };
+}
+
+/**
+ * @brief Field table of @p T; specialize it next to the component.
+ *
+ * @details
+ * The specialization must provide `static const ReflectClass& get()`. Declare
+ * it a friend of the component to reach private members.
+ */
+template<typename T>
+struct
+ Reflect;
+
+/**
+ * @brief Address of a member, with the pointer adjusted from Component to @p T.
+ */
+template<typename T, typename F, F T::*Member>
+void*
+reflectAddress(Component* object) {
+ return &(static_cast<T*>(object)->*Member);
+}
+
+/**
+ * @brief Builds a ReflectField for a member of @p Type.
+ */
+#define REFLECT_FIELD(Type, member, label, minValue, maxValue, dragSpeed)                        \
+ ReflectField{ label, ReflectTypeOf<decltype(Type::member)>::value,                              \
+               &reflectAddress<Type, decltype(Type::member), &Type::member>,                     \
+               minValue, maxValue, dragSpeed }
@@ -5,17 +5,27 @@
  * @details
  * The Texture component loads and owns an `sf::Texture` from disk, using a name and
  * optional file extension (default "png"). It sets its component type to
- * `ComponentType::TEXTURE` in the base class. If loading fails, it prints an error
- * to `std::cout` and keeps the internal texture in its default-constructed state.
+ * `ComponentType::TEXTURE` in the base class. If loading fails, it logs an error
+ * (category "Texture") and keeps the internal texture in its default-constructed state.
  *
  * @note This component uses SFML (`sf::Texture`) and depends on the engine's
  * `EngineUtilities::TSharedPointer` for the `render` signature.
  * @warning The constructor does not throw on load failure; it only logs a message.
+ *
+ * A texture can also be created from a placeholder and filled later with
+ * @ref finishLoad, once its image was decoded in the background. Holders of the
+ * texture notice the change through @ref getRevision.
+ *
+ * Cooked blobs (@ref CookedTexture) skip image decoding altogether: their
+ * pixels go straight to `sf::Texture::update`. Blobs cooked premultiplied are
+ * drawn with the blend mode returned by @ref getBlendMode.
  */
 
 #pragma once
 #include "../Prerequisites.h"
 #include "Component.h"
+#include "../CookedTexture.h"
+#include <atomic>
 
  /**
   * @class Texture
@@ -38,16 +48,69 @@ public:
   * Attempts to load `<textureName>.<extension>` into the internal `sf::Texture`.
   * Sets the base @ref Component type to `ComponentType::TEXTURE`.
   *
-  * @note On failure, writes an error message to `std::cout`.
+  * @note On failure, logs an error.
   */
  Texture(const std::string& textureName, 
 	     const std::string& extension = "png") :
   m_textureName(textureName), m_extension(extension), Component(ComponentType::TEXTURE) {
   if (!m_texture.loadFromFile(m_textureName + "." + m_extension)) {
-   std::cout << "Error de carga de textura: " << m_textureName << "." << m_extension << std::endl;
+   LOG_ERROR("Texture", "Can't load texture {}.{}", m_textureName, m_extension);
+  }
+  m_ready.store(true, std::memory_order_release);
+ }
+
+ /**
+  * @brief Constructs a texture from an encoded image in memory (e.g. a packed archive entry).
+  * @param textureName Base name of the file (without extension).
+  * @param extension File extension.
+  * @param data Encoded image bytes.
+  * @param size Number of bytes.
+  */
+ Texture(const std::string& textureName,
+         const std::string& extension,
+         const void* data,
+         std::size_t size) :
+  m_textureName(textureName), m_extension(extension), Component(ComponentType::TEXTURE) {
+  if (data == nullptr || !m_texture.loadFromMemory(data, size)) {
+   LOG_ERROR("Texture", "Can't load texture {}.{}", m_textureName, m_extension);
+  }
+  m_ready.store(true, std::memory_order_release);
+ }
+
+ /**
+  * @brief Constructs a texture from a parsed cooked blob.
+  * @param textureName Base name of the source file (without extension).
+  * @param extension Extension of the source file.
+  * @param cooked Parsed blob.
+  */
+ Texture(const std::string& textureName,
+         const std::string& extension,
+         const CookedTexture& cooked) :
+  m_textureName(textureName), m_extension(extension), Component(ComponentType::TEXTURE) {
+  if (!cooked.upload(m_texture)) {
+   LOG_ERROR("Texture", "Can't load texture {}", CookedTexture::getCookedPath(m_textureName));
   }
+  else {
+   m_premultiplied.store(cooked.isPremultiplied(), std::memory_order_relaxed);
+  }
+  m_ready.store(true, std::memory_order_release);
  }
 
+ /**
+  * @brief Constructs a texture that shows a placeholder until its image is loaded.
+  * @param textureName Base name of the file being loaded (without extension).
+  * @param extension File extension.
+  * @param placeholder Texture copied and shown meanwhile.
+  *
+  * @details
+  * The texture stays not ready until @ref finishLoad is called.
+  */
+ Texture(const std::string& textureName,
+         const std::string& extension,
+         const sf::Texture& placeholder) :
+  m_textureName(textureName), m_extension(extension), Component(ComponentType::TEXTURE),
+  m_texture(placeholder) {}
+
  /**
   * @brief Virtual default destructor.
   */
@@ -94,6 +157,109 @@ public:
   return m_texture;
  }
 
+ /**
+  * @brief Read-only accessor for the underlying SFML texture.
+  * @return Const reference to the owned `sf::Texture`.
+  */
+ const sf::Texture&
+  getTexture() const {
+  return m_texture;
+ }
+
+ /**
+  * @brief Replaces the placeholder with the decoded image and marks the texture ready.
+  * @param image Decoded image; if empty the placeholder is kept.
+  *
+  * @details
+  * Performs the GPU upload, so it must run on the thread that owns the render context.
+  */
+ void
+  finishLoad(const sf::Image& image) {
+  if (image.getSize().x > 0 && image.getSize().y > 0) {
+   if (m_texture.loadFromImage(image)) {
+    m_premultiplied.store(false, std::memory_order_relaxed);
+    m_revision.fetch_add(1, std::memory_order_release);
+   }
+  }
+  m_ready.store(true, std::memory_order_release);
+ }
+
+ /**
+  * @brief Replaces the placeholder with a cooked blob and marks the texture ready.
+  * @param cooked Parsed blob; if invalid the placeholder is kept.
+  *
+  * @details
+  * Performs the GPU upload, so it must run on the thread that owns the render context.
+  */
+ void
+  finishLoad(const CookedTexture& cooked) {
+  if (cooked.upload(m_texture)) {
+   m_premultiplied.store(cooked.isPremultiplied(), std::memory_order_relaxed);
+   m_revision.fetch_add(1, std::memory_order_release);
+  }
+  m_ready.store(true, std::memory_order_release);
+ }
+
+ /**
+  * @brief Marks the texture as loading again (hot reload); the current image stays visible.
+  */
+ void
+  beginReload() {
+  m_ready.store(false, std::memory_order_release);
+ }
+
+ /**
+  * @brief Returns true once the texture holds its final image (or its load failed).
+  */
+ bool
+  isReady() const {
+  return m_ready.load(std::memory_order_acquire);
+ }
+
+ /**
+  * @brief Gets a counter that increases every time the texture contents are replaced.
+  */
+ uint32_t
+  getRevision() const {
+  return m_revision.load(std::memory_order_acquire);
+ }
+
+ /**
+  * @brief Returns true if the color channels are premultiplied by alpha (cooked with `--premultiply`).
+  */
+ bool
+  isPremultiplied() const {
+  return m_premultiplied.load(std::memory_order_relaxed);
+ }
+
+ /**
+  * @brief Gets the blend mode the texture must be drawn with.
+  * @return `sf::BlendAlpha`, or `One, OneMinusSrcAlpha` for premultiplied pixels.
+  */
+ sf::BlendMode
+  getBlendMode() const {
+  //SFML 3.0 no trae el modo premultiplicado
+  return isPremultiplied()
+   ? sf::BlendMode(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha)
+   : sf::BlendAlpha;
+ }
+
+ /**
+  * @brief Gets the base file name of the texture.
+  */
+ const std::string&
+  getName() const {
+  return m_textureName;
+ }
+
+ /**
+  * @brief Gets the file the texture is loaded from (`<name>.<extension>`).
+  */
+ std::string
+  getPath() const {
+  return m_textureName + "." + m_extension;
+ }
+
 private:
  /** @brief Underlying SFML texture resource. */
  sf::Texture m_texture;
@@ -101,4 +267,10 @@ private:
  std::string m_textureName;
  /** @brief File extension used during load (e.g., "png", "jpg"). */
  std::string m_extension;
+ /** @brief True when the final image is on the GPU. */
+ std::atomic<bool> m_ready{ false };
+ /** @brief Incremented each time the texture contents change. */
+ std::atomic<uint32_t> m_revision{ 0 };
+ /** @brief True when the pixels were cooked premultiplied by alpha. */
+ std::atomic<bool> m_premultiplied{ false };
 };
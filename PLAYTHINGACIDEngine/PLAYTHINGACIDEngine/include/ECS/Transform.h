@@ -9,18 +9,32 @@
  *
  * @note Rotation is represented as a 2D vector. Its semantic meaning depends on
  * the engine convention (e.g., storing yaw/pitch or an angle plus auxiliary data).
- * @warning Raw pointer accessors (`getPosData`, `getRotData`, `getScaData`) expose
- * underlying memory; use with care and ensure the object outlives any external use.
+ * The fields are reflected (see ECS/Reflection.h) and every setter marks its
+ * @ref TransformField bit, so the owner actor only copies the changed fields to
+ * the shape.
  */
 
 #pragma once
 #include "Prerequisites.h"
 #include "Component.h"
+#include "Reflection.h"
 #include "Math/EngineMath.h"
 using sf::Vector2f;
 
 class Window;
 
+/**
+ * @enum TransformField
+ * @brief Change bits of the Transform fields (same order as its reflection table).
+ */
+enum
+ TransformField {
+ TRANSFORM_FIELD_POSITION = 1 << 0,  ///< position changed.
+ TRANSFORM_FIELD_ROTATION = 1 << 1,  ///< rotation changed.
+ TRANSFORM_FIELD_SCALE = 1 << 2,     ///< scale changed.
+ TRANSFORM_FIELD_ALL = TRANSFORM_FIELD_POSITION | TRANSFORM_FIELD_ROTATION | TRANSFORM_FIELD_SCALE
+};
+
 /**
  * @class Transform
  * @brief Component that handles position, rotation, and scale in 2D space.
@@ -39,6 +53,8 @@ public:
 		       position(0.0f, 0.0f),
 		       rotation(0.0f, 0.0f),
 		       scale(1.0f, 1.0f){
+  //todo cuenta como cambiado hasta la primera sincronizacion
+  m_changedFields = TRANSFORM_FIELD_ALL;
  }
 
  /**
@@ -91,6 +107,7 @@ public:
   if (length > range) {
    direction /= length; //normalizar el vector
    position += direction * speed * deltaTime;
+   markChanged(TRANSFORM_FIELD_POSITION);
   }
  }
 
@@ -101,6 +118,7 @@ public:
  void
   setPosition(const Vector2f& pos) {
   position = pos;
+  markChanged(TRANSFORM_FIELD_POSITION);
  }
 
  /**
@@ -110,6 +128,7 @@ public:
  void
   setRotation(const Vector2f& rot) {
   rotation = rot;
+  markChanged(TRANSFORM_FIELD_ROTATION);
  }
 
  /**
@@ -119,6 +138,7 @@ public:
  void
   setScale(const Vector2f& scl) {
   scale = scl;
+  markChanged(TRANSFORM_FIELD_SCALE);
  }
 
  /**
@@ -149,34 +169,10 @@ public:
  }
 
  /**
- * @brief Provides raw pointer access to the position data (x, y).
- * @return Pointer to the first float component of @ref position.
- * @warning Exposes internal storage; ensure lifetime and avoid aliasing issues.
- */
- float*
-  getPosData() {
-  return &position.x;
- }
-
- /**
-  * @brief Provides raw pointer access to the rotation data (x, y).
-  * @return Pointer to the first float component of @ref rotation.
-  * @warning Exposes internal storage; ensure lifetime and avoid aliasing issues.
+  * @brief Returns the reflected fields: position, rotation and scale.
   */
- float*
-  getRotData() {
-  return &rotation.x;
- }
-
- /** 
- * @brief Provides raw pointer access to the scale data (x, y).
- * @return Pointer to the first float component of @ref scale.
- * @warning Exposes internal storage; ensure lifetime and avoid aliasing issues.
- */
- float*
-  getScaData() {
-  return &scale.x;
- }
+ const ReflectClass*
+  getReflection() const override;
 
  /**
   * @brief Virtual destructor.
@@ -184,7 +180,32 @@ public:
  virtual ~Transform() = default;
 
 private:
+ friend struct Reflect<Transform>;
+
  Vector2f position; ///< Position in 2D space.
  Vector2f rotation; ///< Rotation angles (could represent Euler angles or axis).
  Vector2f scale;    ///< Scaling factors.
 };
+
+/**
+ * @brief Field table of Transform (order matches @ref TransformField).
+ */
+template<>
+struct
+ Reflect<Transform> {
+ static const ReflectClass&
+  get() {
+  static const ReflectField fields[] = {
+   REFLECT_FIELD(Transform, position, "Position", 0.0f, 0.0f, 0.5f),
+   REFLECT_FIELD(Transform, rotation, "Rotation", -360.0f, 360.0f, 0.5f),
+   REFLECT_FIELD(Transform, scale, "Scale", 0.0f, 100.0f, 0.01f),
+  };
+  static const ReflectClass info = makeReflectClass("Transform", fields);
+  return info;
+ }
+};
+
+inline const ReflectClass*
+Transform::getReflection() const {
+ return &Reflect<Transform>::get();
+}
@@ -15,11 +15,17 @@
 
 #pragma once
 #include "Prerequisites.h"
+#include <imgui.h>
 #include <vector>
 
 class Window;
 class Actor;
 class A_Racer;
+class Camera;
+class FrameStats;
+class Component;
+struct ReflectClass;
+struct ReflectField;
 
 /**
  * @class EngineGUI
@@ -105,23 +111,43 @@ class
   *
   * @details
   * Selection updates @ref selectedActorIndex to drive the Inspector panel.
+  *
+  * Actors are shown as a tree following Actor::getParent (parents outside
+  * @p actors make the actor a root); with a search filter the matches are
+  * listed flat. The rows are cached and only rebuilt when the filter, the
+  * actors list (address or size), the hierarchy version or an expanded node
+  * changes; each frame only the visible rows are drawn (ImGuiListClipper).
   */
  void
  outliner(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors);
 
  /**
-  * @brief Shows a console panel with categorized program messages.
-  * @param programMessages Map from message category to list of log lines.
+  * @brief Shows the console panel: the Logger messages with severity, category and text filters.
+  * @param open Window visibility flag (cleared by the close button).
+  *
+  * @details
+  * Lines are read in place from the logger's ring (LogBuffer) and drawn with
+  * ImGuiListClipper, so only the visible ones are touched. With a filter
+  * active the matching sequence numbers are cached: each frame only the new
+  * lines are tested and discarded ones are trimmed from the front; the cache
+  * is rebuilt when the filter changes.
   *
-  * @note The key type `ConsolErrorType` is assumed to enumerate message kinds
-  * (e.g., Info/Warning/Error).
+  * The "Levels" popup changes the runtime level of the logger and of each
+  * category, which filters messages where they are written.
   */
  void
- console(const std::map<ConsolErrorType, std::vector<std::string>>& programMessages);
+ console(bool* open);
 
  /**
   * @brief Displays and edits properties of the currently selected actor.
   * @param actors Collection of actors (indexed by @ref selectedActorIndex).
+  *
+  * @details
+  * One editor per reflected field of every component (see ECS/Reflection.h);
+  * components without reflection are only listed. The component pointers of
+  * the selected actor are cached until the selection or its component list
+  * changes. Edited fields are reported with Component::markChanged, so only
+  * those are applied by the systems that depend on them.
   */
  void
  inspector(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors);
@@ -132,14 +158,21 @@ class
   * @param values       Pointer to two contiguous floats (x, y) to edit.
   * @param resetValues  Default value applied when reset is triggered (per component).
   * @param columnWidth  Label column width in pixels.
+  * @param speed        Drag speed.
+  * @param minValue     Lower bound (equal to @p maxValue for none).
+  * @param maxValue     Upper bound.
+  * @return true if a value changed this frame.
   *
   * @warning Expects @p values to reference valid memory for two floats.
   */
- void
+ bool
  vec2Control(const std::string& label,
  float* values,
  float resetValues = 0.0f,
- float columnWidth = 100.0f);
+ float columnWidth = 100.0f,
+ float speed = 0.1f,
+ float minValue = 0.0f,
+ float maxValue = 0.0f);
 
  /**
   * @brief Renders a leaderboard view for racer actors.
@@ -151,8 +184,114 @@ class
  void
  leaderboard(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers);
 
+ /**
+  * @brief Shows the camera panel (enable, follow mode, zoom, visible rectangle).
+  * @param cameras Cameras owned by the application, edited in place.
+  */
+ void
+ cameras(std::vector<Camera>& cameras);
+
+ /**
+  * @brief Shows the profiler panel: flame graph of the last frame and per-scope statistics.
+  * @param open Window visibility flag (cleared by the close button).
+  */
+ void
+ profiler(bool* open);
+
+ /**
+  * @brief Shows the memory panel: live/peak bytes, allocations per frame and the top allocating types.
+  * @param open Window visibility flag (cleared by the close button).
+  */
+ void
+ memory(bool* open);
+
+ /**
+  * @brief Shows the frame-time graph and the p50/p95/p99/max of every channel.
+  * @param stats Frame statistics of the application.
+  */
+ void
+ frameStats(const FrameStats& stats);
+
+ /**
+  * @brief Gets the actor selected in the outliner.
+  * @return Index into the actors list, or -1 when nothing is selected.
+  */
+ int
+ getSelectedActorIndex() const { return selectedActorIndex; }
+
+ /**
+  * @brief Replaces or extends the selection (outliner clicks and viewport picking).
+  * @param indices Actor indices; the last one becomes the inspected actor (none and not additive: nothing is inspected).
+  * @param additive Adds to the current selection instead of replacing it.
+  */
+ void
+ selectActors(const std::vector<int>& indices, bool additive);
+
+ /**
+  * @brief Gets every selected actor index, in selection order.
+  */
+ const std::vector<int>&
+ getSelection() const { return m_selection; }
+
  private:
+ /**
+  * @brief Rebuilds the child lists of the outliner from the actor parents.
+  */
+ void
+ rebuildOutlinerTree(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors);
+
+ /**
+  * @brief Rebuilds the outliner rows: matches of the filter, or the expanded tree.
+  */
+ void
+ rebuildOutlinerRows(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors);
+
+ /**
+  * @brief Draws the editor of a reflected field.
+  * @return true if the value changed this frame.
+  */
+ bool
+ fieldControl(const ReflectField& field, Component* component);
+
+ /**
+  * @brief One visible row of the outliner.
+  */
+ struct
+ OutlinerRow {
+  int actor;         ///< Index into the actors list.
+  int depth;         ///< Nesting level (0 for roots and filter matches).
+  bool hasChildren;  ///< Draws the expand arrow.
+ };
+
  /** @brief Index of the currently selected actor in @ref outliner; -1 means none. */
  int selectedActorIndex = -1;
+
+ ImGuiTextFilter m_outlinerFilter;           ///< Search box of the outliner.
+ std::vector<OutlinerRow> m_outlinerRows;    ///< Rows in display order.
+ std::vector<int> m_outlinerRoots;           ///< Actors without a parent in the list.
+ std::vector<int> m_outlinerFirstChild;      ///< First child of each actor, or -1.
+ std::vector<int> m_outlinerNextSibling;     ///< Next sibling of each actor, or -1.
+ std::vector<uint8_t> m_outlinerOpen;        ///< Expanded flag of each actor.
+ const void* m_outlinerSource = nullptr;     ///< Address of the actors list the tree was built from.
+ std::size_t m_outlinerSourceSize = 0;       ///< Size of that list.
+ uint32_t m_outlinerVersion = 0;             ///< Actor::getHierarchyVersion of that build.
+ bool m_outlinerRowsDirty = true;            ///< Rows must be rebuilt before drawing.
+
+ /**
+  * @brief Cached component of the inspected actor.
+  */
+ struct
+ InspectorComponent {
+  Component* component;            ///< Component (owned by the actor).
+  const ReflectClass* reflection;  ///< Its fields, or nullptr.
+ };
+
+ std::vector<InspectorComponent> m_inspectorComponents;  ///< Components of the inspected actor.
+ const Actor* m_inspectorActor = nullptr;                ///< Actor the cache was built for.
+ const void* m_inspectorSource = nullptr;                ///< Address of its component list.
+ std::size_t m_inspectorComponentCount = 0;              ///< Size of its component list.
+
+ std::vector<int> m_selection;                           ///< Selected actor indices.
+ std::vector<uint8_t> m_selectedFlags;                   ///< Selected flag per actor index.
 };
 
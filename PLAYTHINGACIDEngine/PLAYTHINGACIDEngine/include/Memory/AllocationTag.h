@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <typeinfo>
+
+/**
+ * Con ENGINE_MEMORY_TRACKING en 1 MakeShared y MakeUnique etiquetan la
+ * reserva con el tipo creado para que el MemoryTracker la cuente por tipo.
+ * Con 0 la etiqueta no hace nada y new/delete no se reemplazan.
+ *
+ * Por defecto solo esta activo en Debug: los hooks cuestan una cabecera y
+ * varios atomicos por reserva. Un build de profiling lo activa definiendo
+ * ENGINE_MEMORY_TRACKING=1.
+ */
+#ifndef ENGINE_MEMORY_TRACKING
+#ifdef _DEBUG
+#define ENGINE_MEMORY_TRACKING 1
+#else
+#define ENGINE_MEMORY_TRACKING 0
+#endif
+#endif
+
+namespace EngineUtilities {
+#if ENGINE_MEMORY_TRACKING
+	/**
+	 * @brief Registra un tipo en el MemoryTracker.
+	 *
+	 * @param name Nombre del tipo (debe vivir toda la ejecucion).
+	 * @param size Tamao del tipo en bytes.
+	 * @return Identificador del tipo (0 si ya no caben mas tipos).
+	 */
+	uint32_t registerAllocationType(const char* name, std::size_t size);
+
+	/**
+	 * @brief Marca la siguiente reserva de este hilo con un tipo.
+	 *
+	 * La consume el siguiente operator new del hilo, que es el del objeto
+	 * porque en C++17 la reserva ocurre antes de evaluar el constructor.
+	 *
+	 * @param type Identificador devuelto por registerAllocationType.
+	 */
+	void setNextAllocationType(uint32_t type);
+
+	/**
+	 * @brief Etiqueta la siguiente reserva con el tipo T.
+	 *
+	 * @tparam T Tipo que se va a crear.
+	 */
+	template<typename T>
+	inline void tagNextAllocation()
+	{
+		static const uint32_t type = registerAllocationType(typeid(T).name(), sizeof(T));
+		setNextAllocationType(type);
+	}
+#else
+	template<typename T>
+	inline void tagNextAllocation() {}
+#endif
+}
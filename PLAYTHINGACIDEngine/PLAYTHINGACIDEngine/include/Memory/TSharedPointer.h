@@ -27,6 +27,7 @@
  * SOFTWARE.
 */
 #pragma once
+#include "AllocationTag.h"
 
 namespace EngineUtilities {
 	/**
@@ -204,6 +205,13 @@ namespace EngineUtilities {
 		 */
 		bool isNull() const { return ptr == nullptr; }
 
+		/**
+		 * @brief Obtener el numero de referencias compartidas.
+		 *
+		 * @return Recuento de referencias, o 0 si el puntero es nulo.
+		 */
+		int useCount() const { return refCount ? *refCount : 0; }
+
 		template<typename U>
 		TSharedPointer(const TSharedPointer<U>& other)
 			: ptr(other.ptr), refCount(other.refCount)
@@ -289,6 +297,7 @@ namespace EngineUtilities {
 	template<typename T, typename... Args>
 	TSharedPointer<T> MakeShared(Args... args)
 	{
+		tagNextAllocation<T>();
 		return TSharedPointer<T>(new T(args...));
 	}
 
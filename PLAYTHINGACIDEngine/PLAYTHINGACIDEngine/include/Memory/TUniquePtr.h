@@ -27,6 +27,7 @@
  * SOFTWARE.
 */
 #pragma once
+#include "AllocationTag.h"
 
 namespace EngineUtilities {
     /**
@@ -181,6 +182,7 @@ namespace EngineUtilities {
     template<typename T, typename... Args>
     TUniquePtr<T> MakeUnique(Args... args)
     {
+        tagNextAllocation<T>();
         return TUniquePtr<T>(new T(args...));
     }
 
@@ -15,6 +15,7 @@
 #include "Memory\TWeakPointer.h"
 #include "Memory\TStaticPtr.h"
 #include "Memory\TUniquePtr.h"
+#include "Utilities\Logger.h"
 
 
 //imgui
@@ -24,22 +25,12 @@
 // MACRO for safe release of resources
 #define SAFE_PTR_RELEASE(x) if(x != nullptr) { delete x; x = nullptr; }
 
-#define MESSAGE(classObj, method, state)             \
-{                                                    \
- std::ostringstream os_;                             \
- os_ << classObj << "::" << method << " : "          \
-  << "[CREATION OF RESOURCE" << ": " << state "] \n";\
- std::cerr << os_.str();                             \
-}
-
-#define ERROR(classObj, method, errorMSG)                \
-{                                                        \
- std::ostringstream os_;                                 \
- os_ << "ERROR : " << classObj << "::" << method << " : "\
-  << "  Error in data from params [" << errorMSG"] \n";  \
- std::cerr << os_.str();                                 \
- exit(1);                                                \
-}
+// MESSAGE y ERROR pasan por el Logger asincrono (la clase es la categoria); ERROR ya no termina el programa
+#define MESSAGE(classObj, method, state) \
+ LOG_INFO(classObj, "{}: [CREATION OF RESOURCE: {}]", method, state)
+
+#define ERROR(classObj, method, errorMSG) \
+ LOG_ERROR(classObj, "{}: Error in data from params [{}]", method, errorMSG)
 
 //ENUMS
 enum
@@ -51,6 +42,19 @@ enum
  POLYGON = 4
 };
 
+enum
+RenderBackendType {
+ SFML_WINDOW = 0,
+ SOFTWARE = 1
+};
+
+enum
+CameraFollowMode {
+ CAMERA_FREE = 0,
+ CAMERA_FOLLOW_LEADER = 1,
+ CAMERA_FOLLOW_SELECTED = 2
+};
+
 enum
 ConsolErrorType {
 	INFO = 0,
@@ -0,0 +1,267 @@
+/**
+ * @file Camera.h
+ * @brief 2D camera with smooth follow, zoom, screen viewport and a world-space visible rectangle.
+ *
+ * @details
+ * A Camera produces the `sf::View` used to draw the scene. Its visible world size is
+ * the size of its screen viewport in pixels divided by the zoom, so a zoom of 1 maps
+ * one world unit to one pixel. Each frame @ref update moves the center towards the
+ * follow target with exponential smoothing (frame-rate independent), eases the zoom
+ * and clamps the view to the world bounds.
+ *
+ * The resulting @ref getVisibleRect is what render code uses to cull objects and to
+ * decide level of detail (see @ref getPixelsPerUnit).
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @class Camera
+ * @brief View of the world rendered into a region of the target.
+ */
+class
+ Camera {
+public:
+ /**
+  * @brief Default constructor.
+  */
+ Camera() = default;
+
+ /**
+  * @brief Creates a camera covering the whole target.
+  * @param name Name shown in the GUI.
+  * @param targetSize Size in pixels of the render target.
+  */
+ Camera(const std::string& name, const sf::Vector2u& targetSize);
+
+ /**
+  * @brief Default destructor.
+  */
+ ~Camera() = default;
+
+ /**
+  * @brief Advances follow and zoom smoothing and rebuilds the view.
+  * @param deltaTime Time elapsed since the last update, in seconds.
+  */
+ void
+  update(float deltaTime);
+
+ /**
+  * @brief Sets the point the camera follows (ignored in CAMERA_FREE mode).
+  * @param target World position.
+  */
+ void
+  setTarget(const sf::Vector2f& target);
+
+ /**
+  * @brief Moves the camera immediately, without smoothing.
+  * @param center World position of the view center.
+  */
+ void
+  setCenter(const sf::Vector2f& center);
+
+ /**
+  * @brief Gets the current view center.
+  */
+ const sf::Vector2f&
+  getCenter() const { return m_center; }
+
+ /**
+  * @brief Sets the zoom the camera eases to (1 = one pixel per world unit).
+  * @param zoom Target zoom, clamped to the camera limits.
+  */
+ void
+  setZoom(float zoom);
+
+ /**
+  * @brief Sets the zoom immediately, without easing.
+  * @param zoom New zoom, clamped to the camera limits.
+  */
+ void
+  snapZoom(float zoom);
+
+ /**
+  * @brief Gets the current zoom.
+  */
+ float
+  getZoom() const { return m_zoom; }
+
+ /**
+  * @brief Gets the zoom the camera is easing to.
+  */
+ float
+  getTargetZoom() const { return m_targetZoom; }
+
+ /**
+  * @brief Sets the allowed zoom range.
+  * @param minZoom Smallest zoom (widest view).
+  * @param maxZoom Largest zoom (closest view).
+  */
+ void
+  setZoomLimits(float minZoom, float maxZoom);
+
+ /**
+  * @brief Changes the zoom so the whole rectangle fits in the viewport and centers on it.
+  * @param worldRect Rectangle to frame.
+  */
+ void
+  fitRect(const sf::FloatRect& worldRect);
+
+ /**
+  * @brief Sets the region of the target the camera draws into.
+  * @param viewport Normalized rectangle (0..1) of the target.
+  */
+ void
+  setViewport(const sf::FloatRect& viewport);
+
+ /**
+  * @brief Gets the normalized viewport.
+  */
+ const sf::FloatRect&
+  getViewport() const { return m_viewport; }
+
+ /**
+  * @brief Sets the size of the render target in pixels.
+  * @param targetSize Size of the window or framebuffer.
+  */
+ void
+  setTargetSize(const sf::Vector2u& targetSize);
+
+ /**
+  * @brief Limits the view to a world rectangle (a zero-size rectangle disables the clamp).
+  * @param bounds World bounds.
+  */
+ void
+  setWorldBounds(const sf::FloatRect& bounds);
+
+ /**
+  * @brief Sets how the camera picks its target.
+  * @param mode Follow mode.
+  */
+ void
+  setFollowMode(CameraFollowMode mode) { m_followMode = mode; }
+
+ /**
+  * @brief Gets the follow mode.
+  */
+ CameraFollowMode
+  getFollowMode() const { return m_followMode; }
+
+ /**
+  * @brief Sets the follow smoothing rate.
+  * @param rate Higher values catch up faster; 0 freezes the camera.
+  */
+ void
+  setFollowRate(float rate) { m_followRate = rate < 0.f ? 0.f : rate; }
+
+ /**
+  * @brief Gets the follow smoothing rate.
+  */
+ float
+  getFollowRate() const { return m_followRate; }
+
+ /**
+  * @brief Gets the view to draw with.
+  */
+ const sf::View&
+  getView() const { return m_view; }
+
+ /**
+  * @brief Gets the world-space rectangle currently visible through the camera.
+  */
+ const sf::FloatRect&
+  getVisibleRect() const { return m_visibleRect; }
+
+ /**
+  * @brief Returns true if a world rectangle overlaps the visible area.
+  * @param worldRect Bounds to test.
+  */
+ bool
+  isVisible(const sf::FloatRect& worldRect) const;
+
+ /**
+  * @brief Projects a world position to target pixel coordinates.
+  * @param world World position.
+  * @return Pixel position inside the render target.
+  */
+ sf::Vector2f
+  worldToScreen(const sf::Vector2f& world) const;
+
+ /**
+  * @brief Maps target pixel coordinates back to the world (inverse of @ref worldToScreen).
+  * @param screen Pixel position inside the render target.
+  * @return World position.
+  */
+ sf::Vector2f
+  screenToWorld(const sf::Vector2f& screen) const;
+
+ /**
+  * @brief Returns true if a target pixel falls inside the camera viewport.
+  * @param screen Pixel position inside the render target.
+  */
+ bool
+  containsScreenPoint(const sf::Vector2f& screen) const;
+
+ /**
+  * @brief Gets how many screen pixels one world unit covers (for level of detail).
+  */
+ float
+  getPixelsPerUnit() const { return m_zoom; }
+
+ /**
+  * @brief Enables or disables the camera.
+  * @param enabled Disabled cameras are not rendered.
+  */
+ void
+  setEnabled(bool enabled) { m_enabled = enabled; }
+
+ /**
+  * @brief Returns true if the camera is rendered.
+  */
+ bool
+  isEnabled() const { return m_enabled; }
+
+ /**
+  * @brief Gets the camera name.
+  */
+ const std::string&
+  getName() const { return m_name; }
+
+ /**
+  * @brief Gets a pointer to the enabled flag (for GUI checkboxes).
+  */
+ bool*
+  getEnabledData() { return &m_enabled; }
+
+private:
+ /**
+  * @brief Size of the visible world area at the current zoom.
+  */
+ sf::Vector2f
+  visibleSize() const;
+
+ /**
+  * @brief Clamps the center, rebuilds the view and the visible rectangle.
+  */
+ void
+  rebuild();
+
+ std::string m_name = "Camera";                       ///< Name shown in the GUI.
+ sf::Vector2u m_targetSize = { 1, 1 };                ///< Target size in pixels.
+ sf::FloatRect m_viewport = { { 0.f, 0.f }, { 1.f, 1.f } }; ///< Normalized screen region.
+ sf::Vector2f m_center = { 0.f, 0.f };                ///< Current view center.
+ sf::Vector2f m_target = { 0.f, 0.f };                ///< Follow target.
+ bool m_hasTarget = false;                            ///< True once a target was provided.
+ float m_zoom = 1.f;                                  ///< Current zoom.
+ float m_targetZoom = 1.f;                            ///< Zoom being eased to.
+ float m_minZoom = 0.1f;                              ///< Widest zoom.
+ float m_maxZoom = 8.f;                               ///< Closest zoom.
+ float m_followRate = 4.f;                            ///< Follow smoothing rate (1/s).
+ float m_zoomRate = 6.f;                              ///< Zoom easing rate (1/s).
+ CameraFollowMode m_followMode = CAMERA_FREE;         ///< Target selection.
+ sf::FloatRect m_worldBounds;                         ///< Clamp rectangle (empty = none).
+ sf::View m_view;                                     ///< View handed to the renderer.
+ sf::FloatRect m_visibleRect;                         ///< Visible world rectangle.
+ bool m_enabled = true;                               ///< Rendered when true.
+};
@@ -0,0 +1,205 @@
+/**
+ * @file DebugDraw.h
+ * @brief Immediate-mode debug drawing (lines, circles, arrows, text markers) batched per frame.
+ *
+ * @details
+ * Gameplay code calls the `DEBUG_*` macros from anywhere during the update. The
+ * primitives are appended to linear per-frame buffers: every line, circle,
+ * rectangle and arrow ends up in one `Lines` vertex buffer that is recorded as a single batch
+ * per camera, and text markers are drawn in one pass through the ImGui
+ * background draw list. Buffers are cleared (keeping their capacity) at the end
+ * of each frame.
+ *
+ * Debug drawing is compiled in only when `ENGINE_DEBUG_DRAW` is 1, which by
+ * default follows the build configuration (`NDEBUG` turns it off). In release
+ * the macros expand to nothing, so their arguments are not even evaluated, and
+ * the DebugDraw class itself does not exist. In debug builds the macros skip
+ * argument evaluation while collection is disabled at runtime.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+#ifndef ENGINE_DEBUG_DRAW
+#ifdef NDEBUG
+#define ENGINE_DEBUG_DRAW 0
+#else
+#define ENGINE_DEBUG_DRAW 1
+#endif
+#endif
+
+#if ENGINE_DEBUG_DRAW
+
+class Camera;
+class DrawCommandList;
+
+/**
+ * @class DebugDraw
+ * @brief Per-frame collector of debug primitives (singleton).
+ */
+class
+ DebugDraw {
+private:
+ /**
+  * @brief Private constructor to enforce singleton pattern.
+  */
+ DebugDraw() = default;
+
+ /**
+  * @brief Private destructor.
+  */
+ ~DebugDraw() = default;
+
+public:
+ /**
+  * @brief Deleted copy constructor (singleton: non-copyable).
+  */
+ DebugDraw(const DebugDraw&) = delete;
+
+ /**
+  * @brief Deleted copy assignment (singleton: non-assignable).
+  */
+ DebugDraw& operator=(const DebugDraw&) = delete;
+
+ /**
+  * @brief Provides access to the single DebugDraw instance.
+  * @return Reference to the global DebugDraw.
+  */
+ static DebugDraw& getInstance() {
+  static DebugDraw instance;
+  return instance;
+ }
+
+ /**
+  * @brief Adds a line segment.
+  * @param from Start point (world space).
+  * @param to End point (world space).
+  * @param color Line color.
+  */
+ void
+  line(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color& color);
+
+ /**
+  * @brief Adds a circle outline.
+  * @param center Center (world space).
+  * @param radius Radius in world units.
+  * @param color Line color.
+  * @param segments Number of segments of the outline.
+  */
+ void
+  circle(const sf::Vector2f& center, float radius, const sf::Color& color, int segments = 24);
+
+ /**
+  * @brief Adds an arrow from one point to another.
+  * @param from Tail (world space).
+  * @param to Tip (world space).
+  * @param color Line color.
+  * @param headSize Length of the head strokes in world units.
+  */
+ void
+  arrow(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color& color, float headSize = 8.f);
+
+ /**
+  * @brief Adds a rectangle outline (e.g. collision bounds).
+  * @param rect Rectangle (world space).
+  * @param color Line color.
+  */
+ void
+  rect(const sf::FloatRect& rect, const sf::Color& color);
+
+ /**
+  * @brief Adds a cross marker with a text label next to it.
+  * @param position Marker position (world space).
+  * @param text Label.
+  * @param color Marker and text color.
+  */
+ void
+  text(const sf::Vector2f& position, const std::string& text, const sf::Color& color);
+
+ /**
+  * @brief Records the line buffer into a command list as one batch.
+  * @param commandList Destination list (with the camera view already set).
+  */
+ void
+  record(DrawCommandList& commandList) const;
+
+ /**
+  * @brief Draws the text markers through a camera with the ImGui background draw list.
+  * @param camera Camera used to project the markers to the screen.
+  *
+  * @details
+  * Must be called while an ImGui frame is being built.
+  */
+ void
+  drawText(const Camera& camera) const;
+
+ /**
+  * @brief Empties the buffers, keeping their capacity.
+  */
+ void
+  clear();
+
+ /**
+  * @brief Enables or disables collection (disabled calls are ignored).
+  * @param enabled New state.
+  */
+ void
+  setEnabled(bool enabled) { m_enabled = enabled; }
+
+ /**
+  * @brief Returns true if primitives are being collected.
+  */
+ bool
+  isEnabled() const { return m_enabled; }
+
+ /**
+  * @brief Gets a pointer to the enabled flag (for GUI toggles).
+  */
+ bool*
+  getEnabledData() { return &m_enabled; }
+
+ /**
+  * @brief Gets the number of line vertices collected this frame.
+  */
+ std::size_t
+  getLineVertexCount() const { return m_lines.size(); }
+
+private:
+ /**
+  * @brief Text marker waiting to be drawn.
+  */
+ struct
+  TextMarker {
+  sf::Vector2f position;
+  sf::Color color;
+  std::string text;
+ };
+
+ std::vector<sf::Vertex> m_lines;      ///< Line list of the frame.
+ std::vector<TextMarker> m_texts;      ///< Text markers of the frame.
+ bool m_enabled = false;               ///< Collection toggle.
+};
+
+//los argumentos solo se evaluan con el debug draw activo
+#define DEBUG_DRAW_CALL(call)                                       \
+ do {                                                               \
+  if (DebugDraw::getInstance().isEnabled()) {                       \
+   DebugDraw::getInstance().call;                                   \
+  }                                                                 \
+ } while (0)
+
+#define DEBUG_LINE(from, to, color)         DEBUG_DRAW_CALL(line((from), (to), (color)))
+#define DEBUG_CIRCLE(center, radius, color) DEBUG_DRAW_CALL(circle((center), (radius), (color)))
+#define DEBUG_ARROW(from, to, color)        DEBUG_DRAW_CALL(arrow((from), (to), (color)))
+#define DEBUG_RECT(rectangle, color)        DEBUG_DRAW_CALL(rect((rectangle), (color)))
+#define DEBUG_TEXT(position, label, color)  DEBUG_DRAW_CALL(text((position), (label), (color)))
+
+#else
+
+#define DEBUG_LINE(from, to, color)         ((void)0)
+#define DEBUG_CIRCLE(center, radius, color) ((void)0)
+#define DEBUG_ARROW(from, to, color)        ((void)0)
+#define DEBUG_RECT(rectangle, color)        ((void)0)
+#define DEBUG_TEXT(position, label, color)  ((void)0)
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @file DrawCommandList.h
+ * @brief Immutable per-frame list of draw commands produced by the simulation.
+ *
+ * @details
+ * The simulation records everything it wants to draw for a frame into a
+ * DrawCommandList: shapes are tessellated into world-space triangles and
+ * appended to a single vertex buffer, grouped in batches that share texture
+ * and primitive type. Once submitted, the list is only read by the render
+ * thread, so it never references live scene objects (only long-lived textures).
+ *
+ * @note Outline thickness is not supported by the tessellator; the engine
+ * does not use shape outlines.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+class Window;
+
+/**
+ * @struct DrawBatch
+ * @brief Contiguous range of vertices drawn with a single draw call.
+ */
+struct
+ DrawBatch {
+ const sf::Texture* texture = nullptr;                  ///< Texture bound for the batch (may be null).
+ sf::PrimitiveType type = sf::PrimitiveType::Triangles; ///< Primitive type of the range.
+ std::size_t first = 0;                                 ///< First vertex of the range.
+ std::size_t count = 0;                                 ///< Number of vertices of the range.
+ int view = -1;                                         ///< Index of the view to draw with (-1 = window default).
+ sf::BlendMode blendMode = sf::BlendAlpha;              ///< Blend mode of the range.
+};
+
+/**
+ * @class DrawCommandList
+ * @brief Batched, self-contained draw data for one frame.
+ */
+class
+ DrawCommandList {
+public:
+ /**
+  * @brief Default constructor.
+  */
+ DrawCommandList() = default;
+
+ /**
+  * @brief Default destructor.
+  */
+ ~DrawCommandList() = default;
+
+ /**
+  * @brief Empties the list keeping its allocated capacity.
+  */
+ void
+  clear();
+
+ /**
+  * @brief Sets the color used to clear the target before executing the list.
+  * @param color Clear color.
+  */
+ void
+  setClearColor(const sf::Color& color) { m_clearColor = color; }
+
+ /**
+  * @brief Gets the clear color of the frame.
+  * @return Clear color.
+  */
+ const sf::Color&
+  getClearColor() const { return m_clearColor; }
+
+ /**
+  * @brief Marks whether the GUI must be rendered on top of this frame.
+  * @param hasGui True if an ImGui frame was built for this list.
+  */
+ void
+  setGuiPass(bool hasGui) { m_hasGui = hasGui; }
+
+ /**
+  * @brief Returns true if the GUI must be rendered on top of this frame.
+  */
+ bool
+  hasGuiPass() const { return m_hasGui; }
+
+ /**
+  * @brief Makes the following commands draw through a view (camera).
+  * @param view View to apply; a copy is stored with the list.
+  *
+  * @details
+  * Record the scene once per camera after switching views. The window's default
+  * view is restored after the list is executed.
+  */
+ void
+  setView(const sf::View& view);
+
+ /**
+  * @brief Gets the number of views recorded in the list.
+  */
+ std::size_t
+  getViewCount() const { return m_views.size(); }
+
+ /**
+  * @brief Tessellates a convex SFML shape into world-space triangles.
+  * @param shape Shape to record (fill only, using its transform and texture rect).
+  * @param blendMode Blend mode (see Texture::getBlendMode for premultiplied textures).
+  */
+ void
+  addShape(const sf::Shape& shape, const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+ /**
+  * @brief Appends already transformed vertices.
+  * @param vertices Pointer to the first vertex.
+  * @param count Number of vertices.
+  * @param type Primitive type (Triangles and Lines batches are merged).
+  * @param texture Optional texture used by the vertices.
+  * @param blendMode Blend mode of the vertices.
+  */
+ void
+  addVertices(const sf::Vertex* vertices,
+              std::size_t count,
+              sf::PrimitiveType type,
+              const sf::Texture* texture = nullptr,
+              const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+ /**
+  * @brief Reserves room for vertices that the caller writes in place.
+  * @param maxCount Maximum number of vertices that will be written.
+  * @param type Primitive type (Triangles and Lines batches are merged).
+  * @param texture Optional texture used by the vertices.
+  * @param blendMode Blend mode of the vertices.
+  * @return Pointer to @p maxCount writable vertices, valid until @ref endVertices.
+  *
+  * @details
+  * Lets large generated geometry (particles) be streamed into the frame without
+  * an intermediate copy. Every call must be paired with @ref endVertices.
+  */
+ sf::Vertex*
+  beginVertices(std::size_t maxCount,
+                sf::PrimitiveType type,
+                const sf::Texture* texture = nullptr,
+                const sf::BlendMode& blendMode = sf::BlendAlpha);
+
+ /**
+  * @brief Commits the vertices written after @ref beginVertices.
+  * @param usedCount Number of vertices actually written (at most the reserved count).
+  */
+ void
+  endVertices(std::size_t usedCount);
+
+ /**
+  * @brief Issues every batch to the window.
+  * @param window Target window (its context must be active on the calling thread).
+  */
+ void
+  execute(Window& window) const;
+
+ /**
+  * @brief Gets the number of draw calls the list will issue.
+  */
+ std::size_t
+  getBatchCount() const { return m_batches.size(); }
+
+ /**
+  * @brief Gets the total number of recorded vertices.
+  */
+ std::size_t
+  getVertexCount() const { return m_vertices.size(); }
+
+ /**
+  * @brief Gets the recorded vertices.
+  */
+ const std::vector<sf::Vertex>&
+  getVertices() const { return m_vertices; }
+
+ /**
+  * @brief Gets the recorded batches in submission order.
+  */
+ const std::vector<DrawBatch>&
+  getBatches() const { return m_batches; }
+
+ /**
+  * @brief Tessellates a convex shape into a triangle list (shape transform applied).
+  * @param shape Shape to tessellate.
+  * @param out Vector the triangles are appended to.
+  * @return Number of vertices appended.
+  */
+ static std::size_t
+  tessellateShape(const sf::Shape& shape, std::vector<sf::Vertex>& out);
+
+private:
+ /**
+  * @brief Returns the batch new vertices must be appended to, opening one if needed.
+  */
+ DrawBatch&
+  batchFor(sf::PrimitiveType type, const sf::Texture* texture, const sf::BlendMode& blendMode);
+
+ std::vector<sf::Vertex> m_vertices;            ///< Vertex storage shared by all batches.
+ std::vector<DrawBatch> m_batches;              ///< Draw calls in submission order.
+ std::vector<sf::View> m_views;                 ///< Views referenced by the batches.
+ int m_currentView = -1;                        ///< View used by new batches.
+ std::size_t m_pendingFirst = 0;                ///< First vertex reserved by @ref beginVertices.
+ std::size_t m_pendingBatch = 0;                ///< Batch receiving the reserved vertices.
+ sf::Color m_clearColor = sf::Color(0, 0, 0, 255); ///< Clear color of the frame.
+ bool m_hasGui = false;                         ///< True if the GUI is drawn over the frame.
+};
@@ -0,0 +1,259 @@
+/**
+ * @file ParticleSystem.h
+ * @brief Pooled particle system (tire smoke, sparks) with SoA storage and a vectorized update.
+ *
+ * @details
+ * Particles live in layers, one per texture. Each layer is a fixed-capacity pool
+ * stored as structure of arrays (one array per attribute), so the integration
+ * kernel streams through contiguous floats four at a time with SSE2. Dead
+ * particles are removed by swapping the last live one into their slot, which
+ * keeps every pool dense and allocation free after construction.
+ *
+ * Emitters are also pooled. An emitter spawns at a constant rate from a fixed
+ * position or from the center of an attached actor, optionally shooting
+ * particles against the actor's motion (trails).
+ *
+ * Each layer is written straight into the frame's @ref DrawCommandList as a
+ * single triangle batch, so the whole layer costs one draw call.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include "CShape.h"
+
+class Actor;
+class DrawCommandList;
+
+/**
+ * @struct ParticleEmitterDesc
+ * @brief Spawn parameters shared by all particles of an emitter.
+ */
+struct
+ ParticleEmitterDesc {
+ float rate = 50.f;            ///< Particles spawned per second.
+ float lifetimeMin = 0.5f;     ///< Shortest lifetime, in seconds.
+ float lifetimeMax = 1.0f;     ///< Longest lifetime, in seconds.
+ float speedMin = 20.f;        ///< Slowest initial speed.
+ float speedMax = 60.f;        ///< Fastest initial speed.
+ float direction = 0.f;        ///< Emission direction in degrees (world space).
+ float spread = 360.f;         ///< Emission cone width in degrees.
+ bool emitBackwards = false;   ///< Emit against the motion of the attached actor.
+ float inheritVelocity = 0.f;  ///< Fraction of the emitter motion added to each particle.
+ float drag = 1.f;             ///< Linear damping per second.
+ float gravity = 0.f;          ///< Vertical acceleration.
+ float sizeStart = 4.f;        ///< Size at birth.
+ float sizeEnd = 12.f;         ///< Size at death.
+ float stretch = 0.f;          ///< Elongation along the velocity (0 = square quads).
+ sf::Color colorStart = sf::Color::White;           ///< Color at birth.
+ sf::Color colorEnd = sf::Color(255, 255, 255, 0);  ///< Color at death.
+};
+
+/**
+ * @class ParticleSystem
+ * @brief Owns particle layers and emitters, updates and records them.
+ */
+class
+ ParticleSystem {
+public:
+ /**
+  * @brief Creates the emitter pool.
+  * @param maxEmitters Maximum number of simultaneous emitters.
+  */
+ explicit ParticleSystem(std::size_t maxEmitters = 64);
+
+ /**
+  * @brief Default destructor.
+  */
+ ~ParticleSystem() = default;
+
+ /**
+  * @brief Creates a layer with its own particle pool.
+  * @param name Layer name (for stats).
+  * @param capacity Maximum live particles in the layer.
+  * @param texture Texture of the layer, or null for flat colored quads.
+  * @return Layer index.
+  */
+ int
+  createLayer(const std::string& name, std::size_t capacity, const sf::Texture* texture = nullptr);
+
+ /**
+  * @brief Takes an emitter from the pool.
+  * @param layer Layer the emitter spawns into.
+  * @param desc Spawn parameters.
+  * @return Emitter id, or -1 if the pool is full.
+  */
+ int
+  createEmitter(int layer, const ParticleEmitterDesc& desc);
+
+ /**
+  * @brief Returns an emitter to the pool; its live particles keep going.
+  * @param emitter Emitter id.
+  */
+ void
+  destroyEmitter(int emitter);
+
+ /**
+  * @brief Makes an emitter follow the center of an actor's shape.
+  * @param emitter Emitter id.
+  * @param actor Actor to follow (its CShape bounds are used).
+  * @param offset World offset from the shape center.
+  */
+ void
+  attachEmitter(int emitter,
+                const EngineUtilities::TSharedPointer<Actor>& actor,
+                const sf::Vector2f& offset = { 0.f, 0.f });
+
+ /**
+  * @brief Moves a detached emitter (teleports, no trail is spawned in between).
+  * @param emitter Emitter id.
+  * @param position World position.
+  */
+ void
+  setEmitterPosition(int emitter, const sf::Vector2f& position);
+
+ /**
+  * @brief Pauses or resumes continuous emission.
+  * @param emitter Emitter id.
+  * @param active False stops spawning (bursts still work).
+  */
+ void
+  setEmitterActive(int emitter, bool active);
+
+ /**
+  * @brief Changes the spawn parameters of an emitter.
+  * @param emitter Emitter id.
+  * @param desc New parameters.
+  */
+ void
+  setEmitterDesc(int emitter, const ParticleEmitterDesc& desc);
+
+ /**
+  * @brief Spawns a number of particles at once.
+  * @param emitter Emitter id.
+  * @param count Particles to spawn (clamped to the free capacity).
+  */
+ void
+  burst(int emitter, std::size_t count);
+
+ /**
+  * @brief Moves emitters, spawns new particles, integrates and retires dead ones.
+  * @param deltaTime Time elapsed since the last update, in seconds.
+  */
+ void
+  update(float deltaTime);
+
+ /**
+  * @brief Writes every layer into the command list, one batch per layer.
+  * @param commandList Destination list.
+  * @param visibleRect Optional world rectangle; particles outside are skipped.
+  */
+ void
+  record(DrawCommandList& commandList, const sf::FloatRect* visibleRect = nullptr) const;
+
+ /**
+  * @brief Kills every particle (emitters are kept).
+  */
+ void
+  clearParticles();
+
+ /**
+  * @brief Gets the number of live particles in all layers.
+  */
+ std::size_t
+  getLiveCount() const;
+
+ /**
+  * @brief Gets the number of layers.
+  */
+ std::size_t
+  getLayerCount() const { return m_layers.size(); }
+
+ /**
+  * @brief Gets the name of a layer.
+  * @param layer Layer index.
+  */
+ const std::string&
+  getLayerName(int layer) const { return m_layers[layer].name; }
+
+ /**
+  * @brief Gets the live particles of a layer.
+  * @param layer Layer index.
+  */
+ std::size_t
+  getLayerLiveCount(int layer) const { return m_layers[layer].count; }
+
+ /**
+  * @brief Gets the capacity of a layer.
+  * @param layer Layer index.
+  */
+ std::size_t
+  getLayerCapacity(int layer) const { return m_layers[layer].capacity; }
+
+private:
+ /**
+  * @brief Particle pool of one texture, stored as structure of arrays.
+  *
+  * @details
+  * Float arrays are padded to a multiple of four so the SIMD kernel never
+  * needs a scalar tail.
+  */
+ struct
+  ParticleLayer {
+  std::string name;
+  const sf::Texture* texture = nullptr;
+  sf::Vector2f texSize = { 0.f, 0.f };
+  std::size_t capacity = 0;
+  std::size_t count = 0;
+  std::vector<float> posX, posY;
+  std::vector<float> velX, velY;
+  std::vector<float> age;           ///< Normalized age, dies at 1.
+  std::vector<float> invLife;       ///< 1 / lifetime.
+  std::vector<float> drag;
+  std::vector<float> gravity;
+  std::vector<float> sizeStart, sizeEnd;
+  std::vector<float> stretch;
+  std::vector<uint32_t> colorStart, colorEnd;
+ };
+
+ /**
+  * @brief Spawns particles for an emitter along the segment it moved this frame.
+  */
+ void
+  spawn(int emitter, std::size_t count, const sf::Vector2f& from, const sf::Vector2f& to,
+        const sf::Vector2f& motion);
+
+ /**
+  * @brief Integrates a layer (vectorized).
+  */
+ static void
+  integrate(ParticleLayer& layer, float deltaTime);
+
+ /**
+  * @brief Removes dead particles from a layer by swapping in the last live one.
+  */
+ static void
+  retire(ParticleLayer& layer);
+
+ /**
+  * @brief Returns a uniform random float in [0, 1).
+  */
+ float
+  random01();
+
+ std::vector<ParticleLayer> m_layers;                    ///< Particle pools.
+
+ //pool de emisores (SoA)
+ std::size_t m_maxEmitters;                              ///< Emitter capacity.
+ std::vector<ParticleEmitterDesc> m_emitterDesc;         ///< Spawn parameters.
+ std::vector<int> m_emitterLayer;                        ///< Target layer.
+ std::vector<sf::Vector2f> m_emitterPos;                 ///< Current position.
+ std::vector<sf::Vector2f> m_emitterPrevPos;             ///< Position on the previous update.
+ std::vector<sf::Vector2f> m_emitterOffset;              ///< Offset from the attached shape.
+ std::vector<float> m_emitterAccum;                      ///< Fractional particles pending.
+ std::vector<uint8_t> m_emitterAlive;                    ///< Slot in use.
+ std::vector<uint8_t> m_emitterActive;                   ///< Continuous emission enabled.
+ std::vector<EngineUtilities::TSharedPointer<CShape>> m_emitterParent; ///< Followed shape.
+ std::vector<int> m_freeEmitters;                        ///< Free slots.
+
+ uint32_t m_rngState = 0x9E3779B9u;                      ///< Xorshift state.
+};
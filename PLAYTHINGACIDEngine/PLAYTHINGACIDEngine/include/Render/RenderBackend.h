@@ -0,0 +1,144 @@
+/**
+ * @file RenderBackend.h
+ * @brief Abstract rendering backend used by @ref Window, plus the SFML window implementation.
+ *
+ * @details
+ * Window forwards `clear`, `draw`, `display` and view changes to a RenderBackend.
+ * The default backend draws into the `sf::RenderWindow` owned by the Window; the
+ * @ref SoftwareRenderBackend rasterizes on the CPU into an in-memory RGBA image so
+ * the same rendering paths run on machines without a GPU.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @class RenderBackend
+ * @brief Interface of a render target that receives the engine's draw calls.
+ */
+class
+ RenderBackend {
+public:
+ /**
+  * @brief Virtual destructor.
+  */
+ virtual ~RenderBackend() = default;
+
+ /**
+  * @brief Returns true while the backend can accept frames.
+  */
+ virtual bool
+  isOpen() const = 0;
+
+ /**
+  * @brief Clears the target with a color.
+  * @param color Clear color.
+  */
+ virtual void
+  clear(const sf::Color& color) = 0;
+
+ /**
+  * @brief Draws an SFML drawable.
+  * @param drawable Object to draw.
+  * @param states Render states.
+  */
+ virtual void
+  draw(const sf::Drawable& drawable, const sf::RenderStates& states) = 0;
+
+ /**
+  * @brief Draws a range of vertices.
+  * @param vertices Pointer to the first vertex.
+  * @param vertexCount Number of vertices.
+  * @param type Primitive type.
+  * @param states Render states.
+  */
+ virtual void
+  draw(const sf::Vertex* vertices,
+       std::size_t vertexCount,
+       sf::PrimitiveType type,
+       const sf::RenderStates& states) = 0;
+
+ /**
+  * @brief Presents the frame.
+  */
+ virtual void
+  display() = 0;
+
+ /**
+  * @brief Sets the active view (camera) used by following draws.
+  * @param view View to apply.
+  */
+ virtual void
+  setView(const sf::View& view) = 0;
+
+ /**
+  * @brief Gets the active view.
+  */
+ virtual const sf::View&
+  getView() const = 0;
+
+ /**
+  * @brief Gets the size of the target in pixels.
+  */
+ virtual sf::Vector2u
+  getSize() const = 0;
+
+ /**
+  * @brief Activates or releases the backend context on the calling thread.
+  * @param active True to activate.
+  * @return True on success.
+  */
+ virtual bool
+  setActive(bool active) = 0;
+};
+
+/**
+ * @class SfmlRenderBackend
+ * @brief Backend that forwards every call to an `sf::RenderWindow`.
+ */
+class
+ SfmlRenderBackend : public RenderBackend {
+public:
+ /**
+  * @brief Constructs the backend over a window owned by the caller.
+  * @param window Render window; must outlive the backend.
+  */
+ explicit SfmlRenderBackend(sf::RenderWindow& window) : m_window(window) {}
+
+ bool
+  isOpen() const override { return m_window.isOpen(); }
+
+ void
+  clear(const sf::Color& color) override { m_window.clear(color); }
+
+ void
+  draw(const sf::Drawable& drawable, const sf::RenderStates& states) override {
+  m_window.draw(drawable, states);
+ }
+
+ void
+  draw(const sf::Vertex* vertices,
+       std::size_t vertexCount,
+       sf::PrimitiveType type,
+       const sf::RenderStates& states) override {
+  m_window.draw(vertices, vertexCount, type, states);
+ }
+
+ void
+  display() override { m_window.display(); }
+
+ void
+  setView(const sf::View& view) override { m_window.setView(view); }
+
+ const sf::View&
+  getView() const override { return m_window.getView(); }
+
+ sf::Vector2u
+  getSize() const override { return m_window.getSize(); }
+
+ bool
+  setActive(bool active) override { return m_window.setActive(active); }
+
+private:
+ sf::RenderWindow& m_window; ///< Window owned by @ref Window.
+};
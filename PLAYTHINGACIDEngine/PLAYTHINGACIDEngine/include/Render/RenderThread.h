@@ -0,0 +1,148 @@
+/**
+ * @file RenderThread.h
+ * @brief Dedicated render thread fed by triple-buffered draw command lists.
+ *
+ * @details
+ * The simulation thread records frame N+1 into a free @ref DrawCommandList while
+ * the render thread executes frame N. Three lists rotate between the roles
+ * "write" (owned by the simulation), "ready" (latest submitted frame) and
+ * "read" (being executed), so neither side ever waits for a buffer: if the
+ * renderer falls behind, a newer ready frame simply replaces the stale one.
+ *
+ * The render thread owns the `sf::RenderWindow` OpenGL context while it runs;
+ * @ref start deactivates it on the caller and @ref stop hands it back.
+ *
+ * ImGui keeps a single global context, so the GUI frame built by the
+ * simulation must be rendered before the next one starts: callers use
+ * @ref waitForGuiIdle before processing events or building new GUI.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include "Render/DrawCommandList.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+class Window;
+class EngineGUI;
+class VirtualTexture;
+
+/**
+ * @class RenderThread
+ * @brief Consumes submitted frames on a worker thread that owns the GL context.
+ */
+class
+ RenderThread {
+public:
+ /**
+  * @brief Default constructor.
+  */
+ RenderThread() = default;
+
+ /**
+  * @brief Destructor. Stops the thread if it is still running.
+  */
+ ~RenderThread();
+
+ RenderThread(const RenderThread&) = delete;
+ RenderThread& operator=(const RenderThread&) = delete;
+
+ /**
+  * @brief Transfers the window context to a new render thread and starts it.
+  * @param window Window to render into.
+  * @param engineGUI GUI whose pending frame is rendered after each list.
+  * @return True if the thread was started.
+  */
+ bool
+  start(const EngineUtilities::TSharedPointer<Window>& window, EngineGUI* engineGUI);
+
+ /**
+  * @brief Finishes the frame in flight, joins the thread and reactivates the
+  * window context on the calling thread.
+  */
+ void
+  stop();
+
+ /**
+  * @brief Returns true while the render thread is running.
+  */
+ bool
+  isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+ /**
+  * @brief Returns the list the simulation records the next frame into (cleared).
+  * @return Reference valid until the next @ref submit.
+  */
+ DrawCommandList&
+  beginFrame();
+
+ /**
+  * @brief Publishes the list returned by @ref beginFrame as the latest frame.
+  */
+ void
+  submit();
+
+ /**
+  * @brief Blocks until the GUI frame of the last submitted list was rendered.
+  */
+ void
+  waitForGuiIdle();
+
+ /**
+  * @brief Gets the number of frames executed by the render thread.
+  */
+ uint64_t
+  getRenderedFrames() const { return m_renderedFrames.load(std::memory_order_relaxed); }
+
+ /**
+  * @brief Gets the number of submitted frames replaced before being rendered.
+  */
+ uint64_t
+  getDroppedFrames() const { return m_droppedFrames.load(std::memory_order_relaxed); }
+
+ /**
+  * @brief Sets the time spent uploading loaded textures before each frame.
+  * @param budget Upload time per frame.
+  */
+ void
+  setUploadBudget(sf::Time budget) { m_uploadBudget = budget; }
+
+ /**
+  * @brief Makes the render thread copy the queued tiles of a virtual texture before each frame.
+  * @param texture Texture drawn by the submitted frames (must outlive the thread).
+  * @note Call it before @ref start.
+  */
+ void
+  addVirtualTexture(VirtualTexture* texture) { m_virtualTextures.push_back(texture); }
+
+private:
+ /**
+  * @brief Render loop: waits for a ready frame, executes it and presents it.
+  */
+ void
+  threadMain();
+
+ std::array<DrawCommandList, 3> m_frames; ///< Triple buffer of command lists.
+ int m_writeIndex = 0;                    ///< Slot owned by the simulation.
+ int m_readyIndex = 1;                    ///< Latest submitted slot.
+ int m_readIndex = 2;                     ///< Slot owned by the render thread.
+ bool m_hasReady = false;                 ///< True if the ready slot holds an unrendered frame.
+ bool m_guiPending = false;               ///< True while a submitted GUI frame is not rendered yet.
+ bool m_stopRequested = false;            ///< Asks the render loop to exit.
+
+ std::mutex m_mutex;                      ///< Guards slot indices and flags.
+ std::condition_variable m_frameReady;    ///< Signals a new ready frame or stop.
+ std::condition_variable m_guiIdle;       ///< Signals that the pending GUI frame was rendered.
+
+ std::thread m_thread;                    ///< Render thread.
+ std::atomic<bool> m_running{ false };    ///< Running state.
+ std::atomic<uint64_t> m_renderedFrames{ 0 }; ///< Frames executed.
+ std::atomic<uint64_t> m_droppedFrames{ 0 };  ///< Frames overwritten before rendering.
+
+ EngineUtilities::TSharedPointer<Window> m_window; ///< Target window.
+ EngineGUI* m_engineGUI = nullptr;                 ///< GUI rendered on top of each frame.
+ sf::Time m_uploadBudget = sf::milliseconds(2);    ///< Texture upload time per frame.
+ std::vector<VirtualTexture*> m_virtualTextures;   ///< Atlases updated before each frame.
+};
@@ -0,0 +1,158 @@
+/**
+ * @file SoftwareRenderBackend.h
+ * @brief CPU rasterizer that renders the engine's draw calls into an in-memory RGBA image.
+ *
+ * @details
+ * Supports everything the engine submits: convex shapes (via the same tessellation
+ * used by @ref DrawCommandList), sprites, vertex arrays and raw vertex ranges of
+ * every SFML primitive type. Triangles are rasterized scanline by scanline; each
+ * span is filled with SSE2 when it is flat colored, or shaded per pixel with
+ * nearest texture sampling, vertex color modulation and alpha blending.
+ *
+ * Textures are read back with `sf::Texture::copyToImage` the first time they are
+ * used, or can be provided explicitly with @ref registerTexture so tests do not
+ * need any GPU texture at all.
+ *
+ * @note Only `sf::BlendAlpha` is implemented; other blend modes are treated as alpha.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include "Render/RenderBackend.h"
+
+/**
+ * @class SoftwareRenderBackend
+ * @brief Headless backend writing into a CPU framebuffer.
+ */
+class
+ SoftwareRenderBackend : public RenderBackend {
+public:
+ /**
+  * @brief Creates a framebuffer of the given size.
+  * @param width Width in pixels.
+  * @param height Height in pixels.
+  */
+ SoftwareRenderBackend(unsigned int width, unsigned int height);
+
+ /**
+  * @brief Default destructor.
+  */
+ ~SoftwareRenderBackend() override = default;
+
+ bool
+  isOpen() const override { return m_open; }
+
+ void
+  clear(const sf::Color& color) override;
+
+ void
+  draw(const sf::Drawable& drawable, const sf::RenderStates& states) override;
+
+ void
+  draw(const sf::Vertex* vertices,
+       std::size_t vertexCount,
+       sf::PrimitiveType type,
+       const sf::RenderStates& states) override;
+
+ void
+  display() override { ++m_frameCount; }
+
+ void
+  setView(const sf::View& view) override;
+
+ const sf::View&
+  getView() const override { return m_view; }
+
+ sf::Vector2u
+  getSize() const override { return { m_width, m_height }; }
+
+ bool
+  setActive(bool) override { return true; }
+
+ /**
+  * @brief Stops accepting frames (makes @ref isOpen return false).
+  */
+ void
+  close() { m_open = false; }
+
+ /**
+  * @brief Provides the CPU pixels of a texture, bypassing the GPU read-back.
+  * @param texture Texture pointer used in render states.
+  * @param image Pixels to sample when that texture is bound.
+  */
+ void
+  registerTexture(const sf::Texture* texture, const sf::Image& image);
+
+ /**
+  * @brief Gets the framebuffer, one RGBA8 pixel per element (R in the lowest byte).
+  */
+ const std::vector<uint32_t>&
+  getPixels() const { return m_pixels; }
+
+ /**
+  * @brief Copies the framebuffer into an `sf::Image`.
+  */
+ sf::Image
+  getImage() const;
+
+ /**
+  * @brief Saves the framebuffer to an image file (format from the extension).
+  * @param fileName Output path.
+  * @return True on success.
+  */
+ bool
+  saveToFile(const std::string& fileName) const;
+
+ /**
+  * @brief Gets the number of presented frames.
+  */
+ uint64_t
+  getFrameCount() const { return m_frameCount; }
+
+private:
+ /**
+  * @brief CPU copy of a texture.
+  */
+ struct
+  TextureImage {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  bool repeated = false;
+  std::vector<uint32_t> texels;
+ };
+
+ /**
+  * @brief Vertex already transformed to pixel space.
+  */
+ struct
+  RasterVertex {
+  float x, y;
+  float u, v;
+  sf::Color color;
+ };
+
+ const TextureImage*
+  resolveTexture(const sf::Texture* texture);
+
+ void
+  rasterTriangle(const RasterVertex& a, const RasterVertex& b, const RasterVertex& c,
+                 const TextureImage* texture);
+
+ void
+  rasterLine(const RasterVertex& a, const RasterVertex& b);
+
+ void
+  plot(int x, int y, uint32_t color);
+
+ unsigned int m_width;                  ///< Framebuffer width.
+ unsigned int m_height;                 ///< Framebuffer height.
+ std::vector<uint32_t> m_pixels;        ///< RGBA8 framebuffer.
+ sf::View m_view;                       ///< Active view.
+ sf::IntRect m_clip;                    ///< Viewport of the active view, in pixels.
+ bool m_open = true;                    ///< Open state.
+ uint64_t m_frameCount = 0;             ///< Presented frames.
+ bool m_warnedUnsupported = false;      ///< Unsupported drawables are reported once.
+ std::vector<sf::Vertex> m_scratch;     ///< Tessellation scratch buffer.
+ std::vector<RasterVertex> m_transformed; ///< Transformed vertex scratch buffer.
+ std::unordered_map<const sf::Texture*, TextureImage> m_textures; ///< CPU texture copies.
+};
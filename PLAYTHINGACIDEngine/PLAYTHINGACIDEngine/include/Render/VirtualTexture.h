@@ -0,0 +1,313 @@
+/**
+ * @file VirtualTexture.h
+ * @brief Streams huge background images from a tiled mip pyramid into a fixed-size tile cache.
+ *
+ * @details
+ * A `.vtex` file stores an image as a pyramid of levels (each half the size of the
+ * previous one) cut into square tiles, every tile encoded as PNG:
+ *
+ *  - header: magic `VTEX`, version, width, height, tile size, level count (uint32, little endian);
+ *  - tile table: for every level, row-major `{ uint64 offset; uint32 size; uint32 reserved }`;
+ *  - tile payloads.
+ *
+ * Opening a file reads only the header, the table and the single top-level tile,
+ * so startup cost does not depend on the image size. Each frame @ref update picks
+ * the mip level that matches every camera's zoom, marks the tiles it sees as used
+ * and queues the missing ones on the @ref JobSystem, where they are read and
+ * decoded. Decoded tiles get a slot of an atlas texture (the physical cache)
+ * under a per-frame budget, evicting the least recently used tile when it is
+ * full. While a tile is loading, the closest resident coarser level is drawn
+ * instead, so the image never has holes.
+ *
+ * The atlas itself is only touched by the thread that draws it: @ref update
+ * queues the pixels of every new tile and @ref processUploads (render thread)
+ * copies them before the next frame is executed. Slots are only recycled once
+ * no frame in flight can still be drawing them.
+ *
+ * All tiles are drawn with the atlas texture, i.e. a single batch per camera.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <unordered_set>
+
+class Camera;
+class DrawCommandList;
+
+/**
+ * @class VirtualTexture
+ * @brief Tiled, streamed image drawn over a world rectangle.
+ */
+class
+ VirtualTexture {
+public:
+ /**
+  * @brief Default constructor.
+  */
+ VirtualTexture() = default;
+
+ /**
+  * @brief Waits for pending tile loads and releases the cache.
+  */
+ ~VirtualTexture();
+
+ /**
+  * @brief Converts an image file into a `.vtex` pyramid (offline step).
+  * @param imageFile Source image (any format SFML loads).
+  * @param outputFile Destination `.vtex` file.
+  * @param tileSize Tile side in pixels.
+  * @return True on success.
+  */
+ static bool
+  buildPyramid(const std::string& imageFile, const std::string& outputFile, unsigned int tileSize = 256);
+
+ /**
+  * @brief Opens a `.vtex` file, building it from the source image on a worker if it is missing.
+  * @param imageFile Source image used when the pyramid does not exist.
+  * @param fileName Pyramid file.
+  * @param cacheTilesPerSide The cache atlas holds this many tiles per row and column.
+  *
+  * @details
+  * While the pyramid is being built @ref isOpen returns false; @ref update
+  * opens it once the worker finishes.
+  */
+ void
+  openOrBuild(const std::string& imageFile, const std::string& fileName, unsigned int cacheTilesPerSide = 8);
+
+ /**
+  * @brief Opens a `.vtex` file and creates the tile cache.
+  * @param fileName Pyramid file.
+  * @param cacheTilesPerSide The cache atlas holds this many tiles per row and column.
+  * @return True on success.
+  */
+ bool
+  open(const std::string& fileName, unsigned int cacheTilesPerSide = 8);
+
+ /**
+  * @brief Closes the file and drops every cached tile.
+  */
+ void
+  close();
+
+ /**
+  * @brief Returns true if a pyramid is open.
+  */
+ bool
+  isOpen() const { return !m_levels.empty(); }
+
+ /**
+  * @brief Sets the world rectangle the image covers.
+  * @param worldRect World rectangle.
+  */
+ void
+  setWorldRect(const sf::FloatRect& worldRect) { m_worldRect = worldRect; }
+
+ /**
+  * @brief Gets the world rectangle the image covers.
+  */
+ const sf::FloatRect&
+  getWorldRect() const { return m_worldRect; }
+
+ /**
+  * @brief Requests the tiles seen by the cameras and places finished loads in the cache.
+  * @param cameras Cameras of the frame (disabled ones are ignored).
+  */
+ void
+  update(const std::vector<Camera>& cameras);
+
+ /**
+  * @brief Creates the atlas and copies the queued tiles into it (render thread).
+  *
+  * @details
+  * Call it before executing a frame, from the thread that draws the atlas
+  * (the render thread, or the main thread when rendering there).
+  */
+ void
+  processUploads();
+
+ /**
+  * @brief Records the tiles visible through a camera.
+  * @param commandList Destination list (with the camera view set).
+  * @param camera Camera to draw for.
+  */
+ void
+  record(DrawCommandList& commandList, const Camera& camera) const;
+
+ /**
+  * @brief Sets how many tiles may be uploaded to the cache per frame.
+  * @param tiles Upload budget.
+  */
+ void
+  setUploadBudget(unsigned int tiles) { m_uploadBudget = tiles; }
+
+ /**
+  * @brief Sets how many tile loads may be in flight at once.
+  * @param loads Maximum pending loads.
+  */
+ void
+  setMaxPendingLoads(unsigned int loads) { m_maxPendingLoads = loads; }
+
+ /**
+  * @brief Gets the number of mip levels.
+  */
+ std::size_t
+  getLevelCount() const { return m_levels.size(); }
+
+ /**
+  * @brief Gets the size of the full resolution image.
+  */
+ sf::Vector2u
+  getImageSize() const { return m_imageSize; }
+
+ /**
+  * @brief Gets the number of tiles in the cache.
+  */
+ std::size_t
+  getResidentTileCount() const { return m_pageTable.size(); }
+
+ /**
+  * @brief Gets the cache capacity in tiles.
+  */
+ std::size_t
+  getCacheCapacity() const { return m_slots.size(); }
+
+ /**
+  * @brief Gets the number of tiles being loaded.
+  */
+ std::size_t
+  getPendingLoadCount() const { return m_requested.size(); }
+
+private:
+ /**
+  * @brief Size and tile grid of one mip level.
+  */
+ struct
+  Level {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  unsigned int tilesX = 0;
+  unsigned int tilesY = 0;
+  std::size_t firstEntry = 0;  ///< Index of the first tile in @ref m_entries.
+ };
+
+ /**
+  * @brief Location of an encoded tile in the file.
+  */
+ struct
+  TileEntry {
+  uint64_t offset = 0;
+  uint32_t size = 0;
+  uint32_t reserved = 0;
+ };
+
+ /**
+  * @brief Cache slot in the atlas.
+  */
+ struct
+  Slot {
+  uint64_t key = 0;
+  uint64_t lastUsedFrame = 0;
+  bool used = false;
+  bool pinned = false;
+ };
+
+ /**
+  * @brief Tile decoded by a worker, waiting for upload.
+  */
+ struct
+  LoadedTile {
+  uint64_t key = 0;
+  sf::Image image;
+  bool ok = false;
+ };
+
+ static uint64_t
+  makeKey(unsigned int level, unsigned int x, unsigned int y) {
+  return (uint64_t(level) << 48) | (uint64_t(y) << 24) | uint64_t(x);
+ }
+
+ /**
+  * @brief Mip level matching the zoom of a camera.
+  */
+ unsigned int
+  levelFor(const Camera& camera) const;
+
+ /**
+  * @brief Range of tiles of a level overlapping a world rectangle (false if none).
+  */
+ bool
+  tileRange(unsigned int level, const sf::FloatRect& worldRect,
+            unsigned int& x0, unsigned int& y0, unsigned int& x1, unsigned int& y1) const;
+
+ /**
+  * @brief Reads and decodes one tile (runs on a worker).
+  */
+ bool
+  loadTile(uint64_t key, sf::Image& image) const;
+
+ /**
+  * @brief Queues the load of a tile if it is not resident or already requested.
+  */
+ void
+  request(uint64_t key);
+
+ /**
+  * @brief Marks a tile as used this frame.
+  */
+ void
+  touch(uint64_t key);
+
+ /**
+  * @brief Returns a free slot or evicts the least recently used one (-1 if none can go).
+  */
+ int
+  acquireSlot();
+
+ /**
+  * @brief Assigns a slot to a decoded tile and queues its pixels for the atlas.
+  */
+ void
+  upload(uint64_t key, sf::Image&& image, bool pinned);
+
+ /**
+  * @brief Tile pixels waiting to be copied into the atlas.
+  */
+ struct
+  AtlasWrite {
+  sf::Image image;
+  sf::Vector2u position;
+ };
+
+ std::string m_fileName;                              ///< Open pyramid.
+ sf::Vector2u m_imageSize;                            ///< Full resolution size.
+ unsigned int m_tileSize = 0;                         ///< Tile side in pixels.
+ std::vector<Level> m_levels;                         ///< Mip levels, 0 = full resolution.
+ std::vector<TileEntry> m_entries;                    ///< Tile table.
+ sf::FloatRect m_worldRect;                           ///< World area covered by the image.
+
+ sf::Texture m_atlas;                                 ///< Physical tile cache (render thread only).
+ unsigned int m_slotsPerSide = 0;                     ///< Atlas grid size.
+ std::vector<Slot> m_slots;                           ///< Atlas slots.
+ std::unordered_map<uint64_t, int> m_pageTable;       ///< Resident tile -> slot.
+ std::unordered_set<uint64_t> m_requested;            ///< Tiles being loaded.
+ uint64_t m_frame = 0;                                ///< Frame counter for LRU.
+ unsigned int m_uploadBudget = 8;                     ///< Uploads per frame.
+ unsigned int m_maxPendingLoads = 32;                 ///< Loads in flight.
+
+ mutable std::mutex m_loadedMutex;                    ///< Guards @ref m_loaded.
+ std::vector<LoadedTile> m_loaded;                    ///< Finished loads.
+ std::atomic<int> m_jobsInFlight{ 0 };                ///< Jobs still referencing this object.
+ std::condition_variable m_jobsDone;                  ///< Signals when jobs finish.
+
+ std::mutex m_writesMutex;                            ///< Guards the atlas writes.
+ std::vector<AtlasWrite> m_writes;                    ///< Tiles waiting for @ref processUploads.
+ std::vector<AtlasWrite> m_writing;                   ///< Batch being copied (render thread).
+ sf::Vector2u m_atlasSize;                            ///< Size the atlas must have.
+
+ std::string m_buildFile;                             ///< Pyramid being built by a worker.
+ unsigned int m_buildCacheTiles = 0;                  ///< Cache size to open it with.
+ std::atomic<bool> m_buildFinished{ false };          ///< Set by the build job.
+};
@@ -0,0 +1,298 @@
+/**
+ * @file ResourceCache.h
+ * @brief Keyed cache of shared resources with memory accounting and LRU eviction.
+ *
+ * @details
+ * A ResourceCache owns one reference to every resource it stores; callers get
+ * `EngineUtilities::TSharedPointer` handles to the same object. Each entry
+ * records its size in bytes (measured by a per-type function) so the cache
+ * knows its memory footprint. When the footprint exceeds the budget, @ref trim
+ * releases the least recently used entries that nobody else references. An
+ * entry must stay unreferenced for a few consecutive trims before it goes, so
+ * frames still in flight on the render thread never lose a texture they are
+ * drawing. Under budget, @ref trim returns without touching the entries.
+ *
+ * Keys are @ref StringId values, so lookups compare integers.
+ *
+ * Not thread-safe: use it from the main thread.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include "Utilities/StringId.h"
+#include <functional>
+#include <list>
+#include <type_traits>
+
+/**
+ * @class ResourceCache
+ * @brief LRU cache of shared resources of type @p T under a memory budget.
+ * @tparam T Resource type (Texture, sf::Font, sf::SoundBuffer, sf::Shader...).
+ */
+template<typename T>
+class
+ ResourceCache {
+public:
+ using Handle = EngineUtilities::TSharedPointer<T>;
+ using SizeFunction = std::function<std::size_t(const T&)>;
+
+ /**
+  * @brief Creates an empty cache.
+  * @param typeName Name shown in statistics ("Textures", "Fonts"...).
+  * @param sizeOf Returns the memory used by a resource, in bytes; if empty,
+  * entries keep the size given to @ref insert.
+  * @param budget Memory budget in bytes (0 = unlimited).
+  */
+ ResourceCache(const std::string& typeName, SizeFunction sizeOf, std::size_t budget = 0) :
+  m_typeName(typeName), m_sizeOf(std::move(sizeOf)), m_budget(budget) {}
+
+ /**
+  * @brief Returns a cached resource and marks it as recently used.
+  * @param key Resource key.
+  * @return Handle, or an empty pointer if the key is not cached.
+  */
+ Handle
+  find(StringId key) {
+  auto it = m_entries.find(key);
+  if (it == m_entries.end()) {
+   ++m_misses;
+   return Handle();
+  }
+  ++m_hits;
+  touch(it->second);
+  return it->second.resource;
+ }
+
+ /**
+  * @brief Returns a cached resource, loading and inserting it on a miss.
+  * @param key Resource key.
+  * @param load Callable returning a Handle (empty on failure). Caches without
+  * a size function pass it a `std::size_t&` to report the bytes to account.
+  * @return Handle, or an empty pointer if loading failed.
+  */
+ template<typename Loader>
+ Handle
+  getOrLoad(StringId key, Loader&& load) {
+  Handle resource = find(key);
+  if (resource) {
+   return resource;
+  }
+  std::size_t bytes = 0;
+  if constexpr (std::is_invocable_v<Loader&, std::size_t&>) {
+   resource = load(bytes);
+  }
+  else {
+   resource = load();
+  }
+  if (resource) {
+   insert(key, resource, bytes);
+  }
+  return resource;
+ }
+
+ /**
+  * @brief Stores a resource (replacing any entry with the same key).
+  * @param key Resource key.
+  * @param resource Resource to share.
+  * @param bytes Size to account when the cache has no size function.
+  */
+ void
+  insert(StringId key, const Handle& resource, std::size_t bytes = 0) {
+  if (!resource) {
+   return;
+  }
+  remove(key);
+  m_lru.push_front(key);
+  Entry& entry = m_entries[key];
+  entry.resource = resource;
+  entry.bytes = m_sizeOf ? m_sizeOf(*resource) : bytes;
+  entry.lruPosition = m_lru.begin();
+  m_memoryUsage += entry.bytes;
+ }
+
+ /**
+  * @brief Returns true if the key is cached.
+  */
+ bool
+  contains(StringId key) const { return m_entries.find(key) != m_entries.end(); }
+
+ /**
+  * @brief Drops an entry (outstanding handles stay valid).
+  * @param key Resource key.
+  * @return True if the entry existed.
+  */
+ bool
+  remove(StringId key) {
+  auto it = m_entries.find(key);
+  if (it == m_entries.end()) {
+   return false;
+  }
+  m_memoryUsage -= it->second.bytes;
+  m_lru.erase(it->second.lruPosition);
+  m_entries.erase(it);
+  return true;
+ }
+
+ /**
+  * @brief Measures an entry again, after its resource changed size.
+  * @param key Resource key (ignored if not cached or without a size function).
+  *
+  * @details
+  * E.g. a texture finishing its background load or a hot reload.
+  */
+ void
+  refreshSize(StringId key) {
+  auto it = m_entries.find(key);
+  if (it == m_entries.end() || !m_sizeOf) {
+   return;
+  }
+  m_memoryUsage -= it->second.bytes;
+  it->second.bytes = m_sizeOf(*it->second.resource);
+  m_memoryUsage += it->second.bytes;
+ }
+
+ /**
+  * @brief Evicts unreferenced resources while over budget.
+  *
+  * @details
+  * Call once per frame. Under budget it only counts the call. Over budget it
+  * walks the LRU list from the least recent entry, and only until the idle
+  * entries it met cover the excess.
+  */
+ void
+  trim() {
+  ++m_trims;
+  if (m_budget == 0 || m_memoryUsage <= m_budget) {
+   return;
+  }
+
+  //del menos al mas reciente, saltando lo que sigue en uso
+  const std::size_t excess = m_memoryUsage - m_budget;
+  std::size_t idleBytes = 0;
+  auto it = m_lru.end();
+  while (idleBytes < excess && it != m_lru.begin()) {
+   --it;
+   Entry& entry = m_entries.find(*it)->second;
+   if (entry.resource.useCount() != 1) {
+    entry.idleTrims = 0;
+    continue;
+   }
+   //solo la referencia del cache: cuenta si tambien lo estaba en el trim anterior
+   entry.idleTrims = entry.lastIdleTrim + 1 == m_trims ? entry.idleTrims + 1 : 1;
+   entry.lastIdleTrim = m_trims;
+   idleBytes += entry.bytes;
+   if (entry.idleTrims <= IDLE_TRIMS_BEFORE_EVICTION) {
+    continue;
+   }
+   m_memoryUsage -= entry.bytes;
+   m_entries.erase(*it);
+   it = m_lru.erase(it);
+   ++m_evictions;
+  }
+ }
+
+ /**
+  * @brief Calls a function for every entry, without touching the LRU order.
+  * @param function Callable taking `(StringId key, const Handle& resource)`.
+  */
+ template<typename Function>
+ void
+  forEach(Function&& function) const {
+  for (const auto& pair : m_entries) {
+   function(pair.first, pair.second.resource);
+  }
+ }
+
+ /**
+  * @brief Drops every entry.
+  */
+ void
+  clear() {
+  m_entries.clear();
+  m_lru.clear();
+  m_memoryUsage = 0;
+ }
+
+ /**
+  * @brief Sets the memory budget in bytes (0 = unlimited).
+  */
+ void
+  setBudget(std::size_t bytes) { m_budget = bytes; }
+
+ /**
+  * @brief Gets the memory budget in bytes.
+  */
+ std::size_t
+  getBudget() const { return m_budget; }
+
+ /**
+  * @brief Gets the memory used by the cached resources, in bytes.
+  */
+ std::size_t
+  getMemoryUsage() const { return m_memoryUsage; }
+
+ /**
+  * @brief Gets the number of cached resources.
+  */
+ std::size_t
+  getCount() const { return m_entries.size(); }
+
+ /**
+  * @brief Gets the number of resources evicted so far.
+  */
+ std::size_t
+  getEvictionCount() const { return m_evictions; }
+
+ /**
+  * @brief Gets the number of successful lookups.
+  */
+ std::size_t
+  getHitCount() const { return m_hits; }
+
+ /**
+  * @brief Gets the number of failed lookups.
+  */
+ std::size_t
+  getMissCount() const { return m_misses; }
+
+ /**
+  * @brief Gets the type name given at construction.
+  */
+ const std::string&
+  getTypeName() const { return m_typeName; }
+
+private:
+ /** @brief Trims an entry must stay unreferenced before it can be evicted. */
+ static constexpr unsigned int IDLE_TRIMS_BEFORE_EVICTION = 3;
+
+ /**
+  * @brief Cached resource with its accounting data.
+  */
+ struct
+  Entry {
+  Handle resource;                                  ///< Cache reference.
+  std::size_t bytes = 0;                            ///< Measured size.
+  unsigned int idleTrims = 0;                       ///< Consecutive trims without outside references.
+  uint64_t lastIdleTrim = 0;                        ///< Trim that last saw it unreferenced.
+  std::list<StringId>::iterator lruPosition;        ///< Position in @ref m_lru.
+ };
+
+ /**
+  * @brief Moves an entry to the front of the LRU list.
+  */
+ void
+  touch(Entry& entry) {
+  m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+ }
+
+ std::string m_typeName;                            ///< Name for statistics.
+ SizeFunction m_sizeOf;                             ///< Memory measure.
+ std::unordered_map<StringId, Entry> m_entries;     ///< Entries by key.
+ std::list<StringId> m_lru;                         ///< Keys, most recent first.
+ std::size_t m_budget = 0;                          ///< Budget in bytes (0 = unlimited).
+ std::size_t m_memoryUsage = 0;                     ///< Current footprint.
+ std::size_t m_evictions = 0;                       ///< Evicted entries.
+ std::size_t m_hits = 0;                            ///< Successful lookups.
+ std::size_t m_misses = 0;                          ///< Failed lookups.
+ uint64_t m_trims = 0;                              ///< Calls to @ref trim.
+};
@@ -1,6 +1,7 @@
 /** 
  * @file ResourceManager.h
- * @brief Singleton responsible for loading and caching engine resources (textures).
+ * @brief Singleton responsible for loading and caching engine resources
+ * (textures, fonts, sound buffers and shaders).
  *
  * @details
  * The ResourceManager provides a global cache for texture resources to avoid
@@ -8,13 +9,45 @@
  * addressed by a string key (typically the file base name) and stored as
  * `EngineUtilities::TSharedPointer<Texture>`.
  *
- * @note Thread-safety is not implied by this interface; synchronize externally
- * if you access it from multiple threads.
+ * Caches are keyed by the @ref StringId of the base file name; the name is
+ * interned once at load time and later lookups compare 64-bit ids.
+ *
+ * Each resource type lives in its own @ref ResourceCache with a memory budget;
+ * resources nobody references are evicted in LRU order when a cache goes over
+ * budget (see @ref update), so sessions that cycle through many assets keep a
+ * steady footprint.
+ *
+ * Textures can also be loaded asynchronously: @ref loadTextureAsync returns at
+ * once with a handle showing the default texture, decodes the file on the
+ * @ref JobSystem and queues the decoded image; the render thread uploads queued
+ * images with @ref processUploads under a per-frame time budget.
+ *
+ * With hot reload enabled, a @ref FileWatcher reports edited texture files;
+ * they are decoded again on the JobSystem and replace the old image in place
+ * through the same upload queue, i.e. between two frames on the render thread,
+ * so every existing handle shows the new image.
+ *
+ * Files are looked up first in the mounted archives (@ref mountArchive), whose
+ * entries are read straight from the memory mapping, and then on disk.
+ *
+ * For a texture `<name>.<ext>`, a cooked blob `<name>.ctex` (see
+ * @ref CookedTexture) is preferred when present, since it uploads without
+ * decoding; a loose blob older than its source image is ignored. Load times
+ * of both paths are measured (@ref getTextureLoadStats).
+ *
+ * @note Apart from @ref processUploads (render thread), the interface must be
+ * used from the main thread.
  */
 
 #pragma once
 #include "Prerequisites.h"
 #include "ECS/Texture.h"
+#include "ResourceCache.h"
+#include "Utilities/FileWatcher.h"
+#include "AssetArchive.h"
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <mutex>
+#include <deque>
 
 /**
  * @class ResourceManager
@@ -30,9 +63,9 @@ class
  ResourceManager {
 private:
  /**
-  * @brief Private constructor to enforce singleton pattern.
+  * @brief Private constructor to enforce singleton pattern; sets the default budgets.
   */
- ResourceManager() = default;
+ ResourceManager();
 
  /**
   * @brief Private destructor.
@@ -74,16 +107,316 @@ public:
 
  /**
   * @brief Retrieves a cached texture by key.
-  * @param fileName Cache key used at load time (typically the base file name).
-  * @return Shared pointer to the texture if present; otherwise an empty pointer.
+  * @param id Id of the base file name used at load time; literals are hashed at compile time.
+  * @return Shared pointer to the texture if present; otherwise the default texture.
+  */
+ EngineUtilities::TSharedPointer<Texture>
+ getTexture(StringId id);
+
+ /**
+  * @brief Starts loading a texture in the background.
+  * @param fileName  Base file name (without extension) used as the cache key.
+  * @param extension File extension to append (e.g., "png", "jpg").
+  * @return Handle stored in the cache; it shows the default texture until
+  * the decoded image is uploaded (see @ref Texture::isReady).
+  *
+  * @details
+  * If the key is already cached (loaded or loading) the existing handle is returned.
   */
  EngineUtilities::TSharedPointer<Texture>
- getTexture(const std::string& fileName);
+ loadTextureAsync(const std::string& fileName, const std::string& extension);
+
+ /**
+  * @brief Uploads decoded textures to the GPU (render thread).
+  * @param budget Time allowed this frame; at least one texture is uploaded per call.
+  */
+ void
+ processUploads(sf::Time budget);
+
+ /**
+  * @brief Retrieves a font, loading it on first use.
+  * @param fileName  Base file name (without extension) used as the cache key.
+  * @param extension File extension (e.g., "ttf").
+  * @return Shared pointer to the font, or an empty pointer if it can't be opened.
+  */
+ EngineUtilities::TSharedPointer<sf::Font>
+ getFont(const std::string& fileName, const std::string& extension = "ttf");
+
+ /**
+  * @brief Retrieves a sound buffer, loading it on first use.
+  * @param fileName  Base file name (without extension) used as the cache key.
+  * @param extension File extension (e.g., "wav", "ogg").
+  * @return Shared pointer to the buffer, or an empty pointer if it can't be loaded.
+  */
+ EngineUtilities::TSharedPointer<sf::SoundBuffer>
+ getSoundBuffer(const std::string& fileName, const std::string& extension = "wav");
+
+ /**
+  * @brief Retrieves a shader, loading `<fileName>.vert` and `<fileName>.frag` on first use.
+  * @param fileName Base file name used as the cache key.
+  * @return Shared pointer to the shader, or an empty pointer if shaders are
+  * unavailable or compilation failed.
+  */
+ EngineUtilities::TSharedPointer<sf::Shader>
+ getShader(const std::string& fileName);
+
+ /**
+  * @brief Releases finished background loads and trims every cache to its budget
+  * (main thread, once per frame).
+  */
+ void
+ update();
+
+ /**
+  * @brief Maps a packed archive; its entries take precedence over loose files.
+  * @param fileName Archive file (`.pak`).
+  * @return True if the archive was mounted.
+  *
+  * @details
+  * Mount archives before loading resources; archives stay mapped for the
+  * lifetime of the manager. Later archives take precedence over earlier ones.
+  */
+ bool
+ mountArchive(const std::string& fileName);
+
+ /**
+  * @brief Gets the number of mounted archives.
+  */
+ std::size_t
+ getArchiveCount() const { return m_archives.size(); }
+
+ /**
+  * @brief Reloads every cached texture from disk, in the background.
+  */
+ void
+ reloadAll();
+
+ /**
+  * @brief Enables or disables watching loaded texture files for changes.
+  * @param enabled Hot reload state.
+  */
+ void
+ setHotReload(bool enabled);
+
+ /**
+  * @brief Returns true if loaded files are being watched.
+  */
+ bool
+ isHotReloadEnabled() const { return m_watcher.isRunning(); }
+
+ /**
+  * @brief Gets the texture cache (budget and statistics).
+  */
+ ResourceCache<Texture>&
+ getTextureCache() { return m_textures; }
+
+ /**
+  * @brief Gets the font cache (budget and statistics).
+  */
+ ResourceCache<sf::Font>&
+ getFontCache() { return m_fonts; }
+
+ /**
+  * @brief Gets the sound buffer cache (budget and statistics).
+  */
+ ResourceCache<sf::SoundBuffer>&
+ getSoundBufferCache() { return m_soundBuffers; }
+
+ /**
+  * @brief Gets the shader cache (budget and statistics).
+  */
+ ResourceCache<sf::Shader>&
+ getShaderCache() { return m_shaders; }
+
+ /**
+  * @brief Gets the number of textures still loading or waiting for upload.
+  */
+ std::size_t
+ getPendingTextureCount() const { return m_loading.size(); }
+
+ /**
+  * @brief Accumulated texture load times.
+  */
+ struct
+ TextureLoadStats {
+  uint32_t count = 0;         ///< Textures loaded.
+  double megapixels = 0.0;    ///< Pixels loaded, in millions.
+  double milliseconds = 0.0;  ///< Read + decode + upload time.
+
+  /**
+   * @brief Gets the average cost of a megapixel.
+   */
+  double
+  getMsPerMegapixel() const { return megapixels > 0.0 ? milliseconds / megapixels : 0.0; }
+ };
+
+ /**
+  * @brief Gets the load times of decoded images or of cooked blobs.
+  * @param cooked True for cooked blobs, false for images decoded from their source format.
+  */
+ TextureLoadStats
+ getTextureLoadStats(bool cooked) const;
 
 
 private:
+ /**
+  * @brief Decoded image waiting for its GPU upload.
+  */
+ struct
+ PendingUpload {
+  Texture* texture = nullptr;  ///< Kept alive by @ref m_loading.
+  sf::Image image;             ///< Empty if decoding failed.
+  std::vector<uint8_t> blob;   ///< Cooked file read from disk (@ref cooked may point into it).
+  CookedTexture cooked;        ///< Valid if the texture comes from a cooked blob.
+ };
+
+ /**
+  * @brief Where the bytes of a texture come from.
+  */
+ struct
+ TextureSource {
+  const AssetArchive* archive = nullptr;  ///< Archive holding the file, or null for disk.
+  AssetArchive::Entry entry = {};         ///< Index record when @ref archive is set.
+  std::string path;                       ///< File path.
+  bool cooked = false;                    ///< True for a `.ctex` blob.
+ };
+
+ /**
+  * @brief Time counters of one load path (updated from several threads).
+  */
+ struct
+ LoadCounters {
+  std::atomic<uint32_t> count{ 0 };
+  std::atomic<uint64_t> pixels{ 0 };
+  std::atomic<uint64_t> microseconds{ 0 };
+ };
+
+ /**
+  * @brief Chooses the file a texture is loaded from (main thread).
+  * @param fileName Base file name (without extension).
+  * @param path Source image path.
+  * @param allowCooked Consider cooked blobs (hot reload reads the source image).
+  */
+ TextureSource
+ locateTexture(const std::string& fileName, const std::string& path, bool allowCooked) const;
+
+ /**
+  * @brief Reads the bytes of a texture source (any thread).
+  * @param source Source returned by @ref locateTexture.
+  * @param storage Buffer for files read from disk or inflated archive entries.
+  * @return Bytes; empty if the file can't be read.
+  */
+ static ByteSpan
+ readSource(const TextureSource& source, std::vector<uint8_t>& storage);
+
+ /**
+  * @brief Adds a load step to the counters.
+  * @param cooked Load path.
+  * @param pixels Pixels loaded; 0 for the first half of a split (async) load.
+  * @param time Time spent.
+  */
+ void
+ recordLoad(bool cooked, uint64_t pixels, sf::Time time);
+
+ /**
+  * @brief Decodes the file of a texture on the JobSystem and queues its upload.
+  * @param texture Texture to fill; kept alive through @ref m_loading.
+  * @param allowCooked Prefer the cooked blob (false when reloading an edited source).
+  */
+ void
+ queueDecode(const EngineUtilities::TSharedPointer<Texture>& texture, bool allowCooked = true);
+
+ /**
+  * @brief Finds a file in the mounted archives.
+  * @param path File path as requested by the engine.
+  * @param entry Receives the index record.
+  * @return Archive holding the file, or null if it is only on disk.
+  */
+ const AssetArchive*
+ findInArchives(const std::string& path, const AssetArchive::Entry*& entry) const;
+
+ /**
+  * @brief Remembers which cache key a file belongs to and watches it.
+  */
+ void
+ trackFile(StringId key, const std::string& path);
+
+ /**
+  * @brief Decodes a cached texture again, or marks it stale if a load is already in flight.
+  * @param key Texture cache key.
+  * @param texture Cached texture.
+  * @param allowCooked Whether a cooked blob may be used.
+  *
+  * @details
+  * The load in flight may have read the file before the last change, so a
+  * stale texture is queued again by @ref update when that load finishes.
+  */
+ void
+ reloadTexture(StringId key, const EngineUtilities::TSharedPointer<Texture>& texture, bool allowCooked);
+
+ /**
+  * @brief Returns the default texture, loading it on first use.
+  */
+ EngineUtilities::TSharedPointer<Texture>
+ getDefaultTexture();
+
  /**
   * @brief Texture cache keyed by file name (base name without extension).
   */
- std::unordered_map<std::string, EngineUtilities::TSharedPointer<Texture>> m_textures;
+ ResourceCache<Texture> m_textures;
+
+ /**
+  * @brief Font cache keyed by file name.
+  */
+ ResourceCache<sf::Font> m_fonts;
+
+ /**
+  * @brief Sound buffer cache keyed by file name.
+  */
+ ResourceCache<sf::SoundBuffer> m_soundBuffers;
+
+ /**
+  * @brief Shader cache keyed by file name.
+  */
+ ResourceCache<sf::Shader> m_shaders;
+
+ /**
+  * @brief Textures whose background load has not finished (main thread only).
+  */
+ std::vector<EngineUtilities::TSharedPointer<Texture>> m_loading;
+
+ /**
+  * @brief Decoded images waiting for the render thread.
+  */
+ std::deque<PendingUpload> m_uploads;
+
+ /**
+  * @brief Guards @ref m_uploads.
+  */
+ std::mutex m_uploadMutex;
+
+ /**
+  * @brief Mounted archives, in mount order.
+  */
+ std::vector<EngineUtilities::TSharedPointer<AssetArchive>> m_archives;
+
+ /**
+  * @brief Watches the files of loaded textures.
+  */
+ FileWatcher m_watcher;
+
+ /**
+  * @brief Texture cache key of every loaded file (normalized path).
+  */
+ std::unordered_map<std::string, StringId> m_fileKeys;
+
+ /**
+  * @brief Textures changed while loading, to reload when ready (key -> allowCooked).
+  */
+ std::unordered_map<StringId, bool> m_staleTextures;
+
+ /**
+  * @brief Load time counters: [0] decoded images, [1] cooked blobs.
+  */
+ LoadCounters m_loadCounters[2];
 };
@@ -0,0 +1,135 @@
+/**
+ * @file StressScene.h
+ * @brief Procedural scenes for scaling tests (generated track, N racers, fixed ticks).
+ *
+ * @details
+ * Selected from the command line (see BaseApp::run):
+ *  - `--stress=N` spawns N racers (10 to 1,000,000) instead of the demo scene,
+ *  - `--stress-ticks=T` runs T fixed ticks of 1/60 s and exits (default 600),
+ *  - `--stress-seed=S` picks the scene (same seed, same track and racers),
+ *  - `--headless` runs the simulation and the frame recording without a
+ *    window, GUI or GPU; without it the scene runs in the normal window.
+ *
+ * At the end a report prints, per phase, the average and slowest tick and
+ * the cost per racer, plus the process memory before and after spawning.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include "A_Racer.h"
+#include <random>
+
+class Texture;
+
+/**
+ * @struct StressConfig
+ * @brief Stress mode options.
+ */
+struct
+ StressConfig {
+ uint32_t racers = 0;     ///< Racers to spawn; 0 disables stress mode.
+ uint32_t ticks = 600;    ///< Fixed ticks before exiting.
+ uint32_t seed = 1;       ///< Seed of the track and racer parameters.
+ bool headless = false;   ///< Run without window, GUI or rendering.
+};
+
+/**
+ * @class StressScene
+ * @brief Generates stress scenes and accumulates their per-phase timings.
+ */
+class
+ StressScene {
+public:
+ /** @brief Fixed simulation step. */
+ static constexpr float TICK = 1.f / 60.f;
+ /** @brief Smallest racer count accepted. */
+ static constexpr uint32_t MIN_RACERS = 10;
+ /** @brief Largest racer count accepted. */
+ static constexpr uint32_t MAX_RACERS = 1000000;
+
+ /**
+  * @brief Resident and peak memory of the process, in bytes (0 if unknown).
+  */
+ struct
+  ProcessMemory {
+  uint64_t current = 0;  ///< Working set / resident size.
+  uint64_t peak = 0;     ///< Peak working set / resident size.
+ };
+
+ /**
+  * @param config Stress options; the racer count is clamped to [MIN_RACERS, MAX_RACERS].
+  */
+ explicit StressScene(const StressConfig& config);
+
+ /**
+  * @brief Generates a closed track inside an area.
+  * @param area World rectangle that contains the track.
+  * @return Waypoints of the loop.
+  *
+  * @details
+  * A loop around the centre of the area whose radius wobbles with a few
+  * random harmonics, so every seed gives a different track with bends of
+  * different tightness.
+  */
+ std::vector<sf::Vector2f>
+  generateTrack(const sf::FloatRect& area);
+
+ /**
+  * @brief Creates the racers on a track with random parameters and liveries.
+  * @param waypoints Track from @ref generateTrack.
+  * @param liveries Textures to pick from (may be empty: colour only).
+  * @return Racers, already placed on a grid along the track.
+  */
+ std::vector<EngineUtilities::TSharedPointer<A_Racer>>
+  spawnRacers(const std::vector<sf::Vector2f>& waypoints,
+              const std::vector<EngineUtilities::TSharedPointer<Texture>>& liveries);
+
+ /**
+  * @brief Registers a phase and returns its index for @ref addSample.
+  */
+ int
+  addPhase(const char* name);
+
+ /**
+  * @brief Adds the time a phase took in one tick.
+  */
+ void
+  addSample(int phase, double milliseconds);
+
+ /**
+  * @brief Prints the per-phase table and the memory figures.
+  * @param out Output stream.
+  * @param before Memory before spawning.
+  * @param after Memory after spawning.
+  */
+ void
+  printReport(std::ostream& out, const ProcessMemory& before, const ProcessMemory& after) const;
+
+ /**
+  * @brief Gets the options (racer count already clamped).
+  */
+ const StressConfig&
+  getConfig() const { return m_config; }
+
+ /**
+  * @brief Reads the memory of the current process.
+  */
+ static ProcessMemory
+  getProcessMemory();
+
+private:
+ /**
+  * @brief Accumulated timings of one phase.
+  */
+ struct
+  Phase {
+  const char* name = nullptr;  ///< Phase name.
+  double totalMs = 0.0;        ///< Sum over all ticks.
+  double maxMs = 0.0;          ///< Slowest tick.
+  uint32_t samples = 0;        ///< Ticks measured.
+ };
+
+ StressConfig m_config;        ///< Options.
+ std::mt19937 m_random;        ///< Seeded generator.
+ std::vector<Phase> m_phases;  ///< Registered phases.
+};
@@ -0,0 +1,42 @@
+/**
+ * @file Compression.h
+ * @brief Fast byte-oriented LZ compression for packed assets.
+ *
+ * @details
+ * The format follows the LZ4 block layout: sequences of a token byte (literal
+ * length, match length), the literals, and a 16-bit back offset. It favours
+ * decompression speed over ratio, which suits assets decoded at load time.
+ * The uncompressed size is not stored; callers keep it next to the block.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+namespace Compression {
+
+ /**
+  * @brief Worst-case compressed size for an input of @p size bytes.
+  */
+ std::size_t
+  compressBound(std::size_t size);
+
+ /**
+  * @brief Compresses a buffer.
+  * @param source Input bytes.
+  * @param size Input size.
+  * @param output Receives the compressed block (resized to fit).
+  */
+ void
+  compress(const uint8_t* source, std::size_t size, std::vector<uint8_t>& output);
+
+ /**
+  * @brief Decompresses a block.
+  * @param source Compressed block.
+  * @param size Block size.
+  * @param destination Output buffer.
+  * @param destinationSize Exact uncompressed size.
+  * @return False if the block is malformed or does not decode to exactly @p destinationSize bytes.
+  */
+ bool
+  decompress(const uint8_t* source, std::size_t size, uint8_t* destination, std::size_t destinationSize);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file FileWatcher.h
+ * @brief Reports changes to a set of files, debounced, from a background thread.
+ *
+ * @details
+ * On Linux the watcher uses inotify on the parent directory of every watched
+ * file (editors often save through a temporary file and a rename, which a
+ * watch on the file itself would lose). Other platforms fall back to polling
+ * the last write time of each file.
+ *
+ * Editors and exporters usually write a file in several steps, so a change is
+ * reported only after the file has been quiet for the debounce interval.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_set>
+
+/**
+ * @class FileWatcher
+ * @brief Watches files and hands out the paths that changed.
+ */
+class
+ FileWatcher {
+public:
+ /**
+  * @brief Default constructor (not running).
+  */
+ FileWatcher() = default;
+
+ /**
+  * @brief Stops the watcher thread.
+  */
+ ~FileWatcher();
+
+ FileWatcher(const FileWatcher&) = delete;
+ FileWatcher& operator=(const FileWatcher&) = delete;
+
+ /**
+  * @brief Starts the watcher thread.
+  * @param debounce Quiet time required before a change is reported.
+  * @return True if the watcher is running.
+  */
+ bool
+  start(std::chrono::milliseconds debounce = std::chrono::milliseconds(250));
+
+ /**
+  * @brief Stops the watcher thread (watched paths are kept).
+  */
+ void
+  stop();
+
+ /**
+  * @brief Returns true while the watcher thread runs.
+  */
+ bool
+  isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+ /**
+  * @brief Adds a file to the watched set.
+  * @param path File path, as used to load the resource.
+  */
+ void
+  watch(const std::string& path);
+
+ /**
+  * @brief Returns the files whose changes settled since the last call.
+  */
+ std::vector<std::string>
+  takeChanges();
+
+ /**
+  * @brief Normalizes a path the way reported changes are spelled.
+  * @param path Any relative or absolute path.
+  */
+ static std::string
+  normalize(const std::string& path);
+
+ /**
+  * @brief Gets the name of the notification backend ("inotify" or "polling").
+  */
+ const char*
+  getBackendName() const;
+
+private:
+ using Clock = std::chrono::steady_clock;
+
+ /**
+  * @brief Watcher loop: collects raw events and promotes settled ones.
+  */
+ void
+  threadMain();
+
+ /**
+  * @brief Records a raw change of a watched file (called with @ref m_mutex held).
+  */
+ void
+  markChanged(const std::string& path, Clock::time_point now);
+
+ std::thread m_thread;                                   ///< Watcher thread.
+ std::atomic<bool> m_running{ false };                   ///< Running state.
+ std::chrono::milliseconds m_debounce{ 250 };            ///< Quiet interval.
+
+ std::mutex m_mutex;                                     ///< Guards the members below.
+ std::unordered_set<std::string> m_files;                ///< Watched files.
+ std::unordered_map<std::string, Clock::time_point> m_pending; ///< Raw changes by last event time.
+ std::vector<std::string> m_changes;                     ///< Settled changes.
+
+#if defined(__linux__)
+ int m_inotify = -1;                                     ///< inotify descriptor.
+ std::unordered_map<int, std::string> m_watchDirs;       ///< Watch descriptor -> directory.
+ std::unordered_set<std::string> m_watchedDirs;          ///< Directories already watched.
+#else
+ std::unordered_map<std::string, int64_t> m_writeTimes;  ///< Last seen write time per file.
+#endif
+};
@@ -0,0 +1,243 @@
+/**
+ * @file FrameStats.h
+ * @brief Frame-time statistics: HDR histograms, rolling percentiles and CSV export.
+ *
+ * @details
+ * Every frame the main loop marks the end of each phase (simulation, GUI,
+ * render) and of the frame; the frame time is the full loop period, so it
+ * includes waiting for the render thread and vsync. With the render thread the
+ * render phase is only the main-thread part (recording and submitting).
+ *
+ * Durations are kept in microseconds in log-linear (HDR-style) histograms:
+ * values below 128 us have their own bucket and above that each power of two
+ * is split in 64 buckets, so a percentile is off by at most 1/64 (~1.6 %)
+ * whatever its magnitude. There is one histogram per channel for the whole
+ * run and one for the last @ref FrameStats::WINDOW_FRAMES frames.
+ *
+ * Only the last @ref FrameStats::WINDOW_FRAMES frames are kept in memory; when
+ * a CSV is open every frame is streamed to it as a row, so a long session
+ * does not grow.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include <chrono>
+
+/**
+ * @enum FrameStatChannel
+ * @brief Durations measured every frame.
+ */
+enum
+FrameStatChannel {
+ FRAME_STAT_FRAME = 0,       ///< Full loop period.
+ FRAME_STAT_SIMULATION = 1,  ///< BaseApp::update.
+ FRAME_STAT_GUI = 2,         ///< BaseApp::updateGUI.
+ FRAME_STAT_RENDER = 3,      ///< BaseApp::render (main thread).
+ FRAME_STAT_COUNT = 4
+};
+
+/**
+ * @class FrameHistogram
+ * @brief Log-linear histogram of durations in microseconds.
+ */
+class
+ FrameHistogram {
+public:
+ /** @brief Buckets of width 1 below this value, log-linear above. */
+ static constexpr uint32_t LINEAR_LIMIT = 128;
+ /** @brief Buckets per power of two above @ref LINEAR_LIMIT. */
+ static constexpr uint32_t SUB_BUCKETS = 64;
+ /** @brief Largest value kept exactly (~67 s); longer samples are clamped. */
+ static constexpr uint64_t MAX_VALUE = (uint64_t(1) << 26) - 1;
+ /** @brief Number of buckets needed up to @ref MAX_VALUE. */
+ static constexpr uint32_t BUCKET_COUNT = (26 - 6 + 1) * SUB_BUCKETS;
+
+ /**
+  * @brief Adds a sample.
+  */
+ void
+  add(uint64_t micros);
+
+ /**
+  * @brief Removes a sample previously added.
+  */
+ void
+  remove(uint64_t micros);
+
+ /**
+  * @brief Gets the value below which a fraction of the samples fall.
+  * @param fraction Between 0 and 1 (0.99 for p99).
+  * @return Upper bound of the bucket holding that sample, in microseconds.
+  */
+ uint64_t
+  percentile(double fraction) const;
+
+ /**
+  * @brief Gets the number of samples.
+  */
+ uint64_t
+  getCount() const { return m_count; }
+
+ /**
+  * @brief Bucket that holds a value.
+  */
+ static uint32_t
+  bucketOf(uint64_t micros);
+
+ /**
+  * @brief Largest value that falls in a bucket.
+  */
+ static uint64_t
+  bucketUpper(uint32_t bucket);
+
+private:
+ uint32_t m_buckets[BUCKET_COUNT] = {};  ///< Samples per bucket.
+ uint64_t m_count = 0;                   ///< Total samples.
+};
+
+/**
+ * @class FrameStats
+ * @brief Collects per-frame durations and their percentiles.
+ */
+class
+ FrameStats {
+public:
+ /** @brief Frames covered by the rolling window. */
+ static constexpr std::size_t WINDOW_FRAMES = 300;
+
+ /**
+  * @brief Percentiles of one channel, in milliseconds.
+  */
+ struct
+  Summary {
+  double p50 = 0.0;      ///< Median.
+  double p95 = 0.0;      ///< 95th percentile.
+  double p99 = 0.0;      ///< 99th percentile.
+  double max = 0.0;      ///< Longest sample (exact).
+  uint64_t count = 0;    ///< Samples.
+ };
+
+ /**
+  * @brief Starts the phases of a frame.
+  */
+ void
+  beginFrame();
+
+ /**
+  * @brief Ends a phase: measures the time since the previous mark or @ref beginFrame.
+  * @param channel Phase that just ended.
+  */
+ void
+  mark(FrameStatChannel channel);
+
+ /**
+  * @brief Ends the frame and records every channel.
+  */
+ void
+  endFrame();
+
+ /**
+  * @brief Percentiles over the last @ref WINDOW_FRAMES frames.
+  */
+ Summary
+  getWindowSummary(FrameStatChannel channel) const;
+
+ /**
+  * @brief Percentiles over the whole run.
+  */
+ Summary
+  getTotalSummary(FrameStatChannel channel) const;
+
+ /**
+  * @brief Duration of a channel in the last recorded frame, in milliseconds.
+  */
+ double
+  getLastMs(FrameStatChannel channel) const {
+  if (m_frameCount == 0) {
+   return 0.0;
+  }
+  return m_recent[(m_windowNext + WINDOW_FRAMES - 1) % WINDOW_FRAMES].micros[channel] / 1000.0;
+ }
+
+ /**
+  * @brief Ring of the last frame times of a channel, in milliseconds (for ImGui::PlotLines).
+  */
+ const float*
+  getWindowData(FrameStatChannel channel) const { return m_windowMs[channel]; }
+
+ /**
+  * @brief Index of the oldest sample in @ref getWindowData.
+  */
+ int
+  getWindowOffset() const { return static_cast<int>(m_windowNext); }
+
+ /**
+  * @brief Gets the number of recorded frames.
+  */
+ std::size_t
+  getFrameCount() const { return m_frameCount; }
+
+ /**
+  * @brief Gets the display name of a channel.
+  */
+ static const char*
+  getChannelName(FrameStatChannel channel);
+
+ /**
+  * @brief Starts streaming one row per frame (durations in ms) to a file.
+  * @param fileName Output file (truncated).
+  * @return True if the file could be opened.
+  */
+ bool
+  openCsv(const std::string& fileName);
+
+ /**
+  * @brief Flushes and closes the CSV.
+  * @return True if every row was written.
+  */
+ bool
+  closeCsv();
+
+ /**
+  * @brief Whether frames are being streamed to a CSV.
+  */
+ bool
+  isCsvOpen() const { return m_csv.is_open(); }
+
+ /**
+  * @brief Prints the whole-run percentiles of every channel.
+  * @param out Output stream.
+  */
+ void
+  printSummary(std::ostream& out) const;
+
+private:
+ using Clock = std::chrono::steady_clock;
+
+ /**
+  * @brief Durations of one frame in microseconds.
+  */
+ struct
+  FrameRecord {
+  uint32_t micros[FRAME_STAT_COUNT] = {};  ///< Per channel.
+ };
+
+ /**
+  * @brief Appends a frame to the CSV.
+  */
+ void
+  writeCsvRow(const FrameRecord& record);
+
+ bool m_started = false;                                 ///< A frame has begun.
+ Clock::time_point m_frameStart;                         ///< End of the previous frame.
+ Clock::time_point m_phaseStart;                         ///< Last mark.
+ FrameRecord m_current;                                  ///< Frame being measured.
+ FrameRecord m_recent[WINDOW_FRAMES];                    ///< Ring of the window frames.
+ std::size_t m_frameCount = 0;                           ///< Frames recorded.
+ std::ofstream m_csv;                                    ///< Per-frame rows (closed: not written).
+ FrameHistogram m_total[FRAME_STAT_COUNT];               ///< Whole run.
+ FrameHistogram m_window[FRAME_STAT_COUNT];              ///< Last WINDOW_FRAMES frames.
+ uint64_t m_totalMax[FRAME_STAT_COUNT] = {};             ///< Longest sample of the run.
+ float m_windowMs[FRAME_STAT_COUNT][WINDOW_FRAMES] = {}; ///< Ring of the window samples.
+ std::size_t m_windowNext = 0;                           ///< Next slot of the rings.
+};
@@ -0,0 +1,95 @@
+/**
+ * @file JobSystem.h
+ * @brief Small pool of worker threads for background work (file reads, image decoding).
+ *
+ * @details
+ * Jobs are plain `std::function<void()>` executed in FIFO order by a fixed set of
+ * workers created on first use. Jobs must not touch the scene or ImGui; they hand
+ * their results back to the main thread through the owner's own queue.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+
+/**
+ * @class JobSystem
+ * @brief Global worker pool (singleton).
+ */
+class
+ JobSystem {
+private:
+ /**
+  * @brief Starts the workers (one less than the hardware threads, at least one).
+  */
+ JobSystem();
+
+ /**
+  * @brief Finishes the queued jobs and joins the workers.
+  */
+ ~JobSystem();
+
+public:
+ /**
+  * @brief Deleted copy constructor (singleton: non-copyable).
+  */
+ JobSystem(const JobSystem&) = delete;
+
+ /**
+  * @brief Deleted copy assignment (singleton: non-assignable).
+  */
+ JobSystem& operator=(const JobSystem&) = delete;
+
+ /**
+  * @brief Provides access to the single JobSystem instance.
+  * @return Reference to the global JobSystem.
+  */
+ static JobSystem& getInstance() {
+  static JobSystem instance;
+  return instance;
+ }
+
+ /**
+  * @brief Queues a job.
+  * @param job Work to run on a worker thread.
+  */
+ void
+  submit(std::function<void()> job);
+
+ /**
+  * @brief Blocks until every queued and running job has finished.
+  */
+ void
+  waitIdle();
+
+ /**
+  * @brief Gets the number of worker threads.
+  */
+ std::size_t
+  getWorkerCount() const { return m_workers.size(); }
+
+ /**
+  * @brief Gets the number of jobs waiting or running.
+  */
+ std::size_t
+  getPendingCount() const { return m_pending.load(); }
+
+private:
+ /**
+  * @brief Worker loop.
+  */
+ void
+  workerMain();
+
+ std::vector<std::thread> m_workers;          ///< Worker threads.
+ std::deque<std::function<void()>> m_jobs;    ///< FIFO of queued jobs.
+ std::mutex m_mutex;                          ///< Guards the queue.
+ std::condition_variable m_jobReady;          ///< Signals workers.
+ std::condition_variable m_idle;              ///< Signals waitIdle.
+ std::atomic<std::size_t> m_pending{ 0 };     ///< Queued + running jobs.
+ bool m_stopping = false;                     ///< Set on destruction.
+};
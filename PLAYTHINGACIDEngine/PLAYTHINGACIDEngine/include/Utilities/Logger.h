@@ -0,0 +1,567 @@
+/**
+ * @file Logger.h
+ * @brief Asynchronous structured logger with per-thread lock-free rings.
+ *
+ * @details
+ * Messages are written with @ref LOG_TRACE ... @ref LOG_ERROR (and the old
+ * MESSAGE / ERROR macros of Prerequisites.h, which forward here):
+ *
+ *     LOG_WARNING("ResourceManager", "{} not found, using {}", name, fallback);
+ *
+ * The calling thread does not format anything: it copies the format string
+ * pointer and the arguments (numbers, strings, vectors, pointers) into a
+ * fixed-size record and pushes it into its own single-producer ring. A
+ * background thread drains every ring a few times per frame, orders the
+ * records by time, replaces each `{}` with the next argument and hands the
+ * line to the sinks: a file, stderr and the console panel. When a ring is
+ * full the record is dropped and counted, so logging never blocks the frame.
+ *
+ * Filtering happens at three levels:
+ *  - compile time: calls below `ENGINE_LOG_LEVEL` expand to nothing,
+ *  - call site: a global level and one level per category (the first
+ *    argument of the macro), checked with two relaxed loads,
+ *  - sink: each sink has its own minimum severity.
+ *
+ * @note Format strings and category names must be string literals (or
+ * otherwise outlive the logger); string arguments are copied.
+ */
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @enum LogSeverity
+ * @brief Importance of a message, from the most verbose to the most serious.
+ */
+enum
+LogSeverity {
+ LOG_SEVERITY_TRACE = 0,    ///< Very verbose diagnostics.
+ LOG_SEVERITY_DEBUG = 1,    ///< Development diagnostics.
+ LOG_SEVERITY_INFO = 2,     ///< Normal events (resource created, thread started).
+ LOG_SEVERITY_WARNING = 3,  ///< Something unexpected that was handled.
+ LOG_SEVERITY_ERROR = 4,    ///< An operation failed; the program continues.
+ LOG_SEVERITY_OFF = 5       ///< Above every severity: disables a level or sink.
+};
+
+/**
+ * @enum LogSinkType
+ * @brief Destinations of the formatted messages.
+ */
+enum
+LogSinkType {
+ LOG_SINK_FILE = 0,     ///< Log file (see Logger::setFile).
+ LOG_SINK_STDERR = 1,   ///< Standard error.
+ LOG_SINK_CONSOLE = 2,  ///< EngineGUI console panel.
+ LOG_SINK_COUNT = 3
+};
+
+/** @brief Messages below this severity are removed at compile time (5 removes all). */
+#ifndef ENGINE_LOG_LEVEL
+#if defined(_DEBUG)
+#define ENGINE_LOG_LEVEL 0
+#else
+#define ENGINE_LOG_LEVEL 2
+#endif
+#endif
+
+/**
+ * @class LogBuffer
+ * @brief Fixed-capacity ring of formatted messages, in insertion order (console sink).
+ *
+ * @details
+ * Lines and their text live in two rings that grow on demand up to
+ * @ref MAX_LINES lines and @ref MAX_TEXT_BYTES bytes; past either limit the
+ * oldest lines are discarded. Each line keeps a sequence number, so a reader
+ * can tell which lines are new and which were discarded since it last looked.
+ * Line breaks are stored as spaces so every line has the same height.
+ */
+class
+ LogBuffer {
+public:
+ /** @brief Lines kept at most. */
+ static constexpr std::size_t MAX_LINES = std::size_t(1) << 20;
+ /** @brief Text bytes kept at most. */
+ static constexpr std::size_t MAX_TEXT_BYTES = std::size_t(64) << 20;
+
+ /**
+  * @brief One message (32 bytes); its text is read with @ref getText.
+  */
+ struct
+  Line {
+  uint64_t sequence = 0;    ///< Position in the whole log (0-based).
+  double time = 0.0;        ///< Seconds since the logger started.
+  uint32_t textOffset = 0;  ///< Start of the text in the text ring.
+  uint32_t textLength = 0;  ///< Text bytes.
+  uint32_t thread = 0;      ///< Index of the writing thread.
+  uint16_t category = 0;    ///< Category index (see Logger::getCategoryName).
+  uint8_t severity = 0;     ///< LogSeverity.
+ };
+
+ /**
+  * @param maxLines Lines kept at most.
+  * @param maxTextBytes Text bytes kept at most.
+  */
+ explicit LogBuffer(std::size_t maxLines = MAX_LINES, std::size_t maxTextBytes = MAX_TEXT_BYTES);
+
+ /**
+  * @brief Appends a line, discarding the oldest ones if there is no room.
+  */
+ void
+  push(double time, LogSeverity severity, uint16_t category, uint32_t thread, std::string_view text);
+
+ /**
+  * @brief Discards every line (sequence numbers keep counting).
+  */
+ void
+  clear();
+
+ /**
+  * @brief Sequence of the oldest line kept.
+  */
+ uint64_t
+  getFirstSequence() const { return m_nextSequence - m_count; }
+
+ /**
+  * @brief Sequence the next line will get.
+  */
+ uint64_t
+  getNextSequence() const { return m_nextSequence; }
+
+ /**
+  * @brief Gets the number of lines kept.
+  */
+ std::size_t
+  size() const { return m_count; }
+
+ /**
+  * @brief Gets a line by sequence number.
+  * @param sequence Between @ref getFirstSequence and @ref getNextSequence (exclusive).
+  */
+ const Line&
+  getLine(uint64_t sequence) const {
+  return m_lines[(m_first + static_cast<std::size_t>(sequence - getFirstSequence())) % m_lines.size()];
+ }
+
+ /**
+  * @brief Gets the text of a line (not null-terminated).
+  */
+ std::string_view
+  getText(const Line& line) const { return std::string_view(m_text.data() + line.textOffset, line.textLength); }
+
+private:
+ /**
+  * @brief Discards the oldest line.
+  */
+ void
+  popFront();
+
+ std::vector<Line> m_lines;      ///< Line ring (grows up to m_maxLines).
+ std::size_t m_first = 0;        ///< Slot of the oldest line.
+ std::size_t m_count = 0;        ///< Lines kept.
+ std::size_t m_maxLines;         ///< Line capacity.
+ std::vector<char> m_text;       ///< Text ring (grows up to m_maxText).
+ std::size_t m_textHead = 0;     ///< Where the next text goes.
+ std::size_t m_maxText;          ///< Text capacity.
+ uint64_t m_nextSequence = 0;    ///< Sequence of the next line.
+};
+
+/**
+ * @class Logger
+ * @brief Collects records from every thread and formats them in the background (singleton).
+ */
+class
+ Logger {
+private:
+ Logger();
+ ~Logger();
+
+public:
+ Logger(const Logger&) = delete;
+ Logger& operator=(const Logger&) = delete;
+
+ /**
+  * @brief Provides access to the single Logger instance.
+  */
+ static Logger& getInstance() {
+  static Logger instance;
+  return instance;
+ }
+
+ /** @brief Records each thread ring can hold before dropping. */
+ static constexpr std::size_t RING_CAPACITY = 1024;
+ /** @brief Bytes of argument data per record (longer strings are truncated). */
+ static constexpr std::size_t ARGUMENT_BYTES = 224;
+ /** @brief Distinct categories; later ones share the last slot. */
+ static constexpr std::size_t MAX_CATEGORIES = 128;
+
+ /**
+  * @brief Registers a category (or finds it) and returns its index.
+  * @param name Category name, usually the class that logs.
+  */
+ uint16_t
+  registerCategory(const char* name);
+
+ /**
+  * @brief True if a message of this severity and category passes the runtime filters.
+  */
+ bool
+  isEnabled(LogSeverity severity, uint16_t category) const {
+  return severity >= m_level.load(std::memory_order_relaxed) &&
+         severity >= m_categories[category].level.load(std::memory_order_relaxed);
+ }
+
+ /**
+  * @brief Queues a message; formatting happens on the logger thread.
+  * @param severity Message severity.
+  * @param category Index from @ref registerCategory.
+  * @param format Text where each `{}` is replaced by the next argument.
+  * @param args Arithmetic values, strings, sf::Vector2 or pointers.
+  */
+ template<typename... Args>
+ void
+  write(LogSeverity severity, uint16_t category, const char* format, const Args&... args) {
+  Record record;
+  record.severity = static_cast<uint8_t>(severity);
+  record.category = category;
+  record.format = format;
+  (appendArgument(record, args), ...);
+  push(record);
+ }
+
+ /**
+  * @brief Blocks until every message queued so far reached the sinks.
+  */
+ void
+  flush();
+
+ /**
+  * @brief Flushes and stops the logger thread; later messages are dropped.
+  */
+ void
+  shutdown();
+
+ /**
+  * @brief Sets the global minimum severity.
+  */
+ void
+  setLevel(LogSeverity severity) { m_level.store(severity, std::memory_order_relaxed); }
+
+ /**
+  * @brief Gets the global minimum severity.
+  */
+ LogSeverity
+  getLevel() const { return m_level.load(std::memory_order_relaxed); }
+
+ /**
+  * @brief Sets the minimum severity of one category.
+  * @param category Index from @ref registerCategory.
+  */
+ void
+  setCategoryLevel(uint16_t category, LogSeverity severity);
+
+ /**
+  * @brief Gets the minimum severity of one category.
+  */
+ LogSeverity
+  getCategoryLevel(uint16_t category) const { return m_categories[category].level.load(std::memory_order_relaxed); }
+
+ /**
+  * @brief Gets the number of registered categories.
+  */
+ uint16_t
+  getCategoryCount() const;
+
+ /**
+  * @brief Gets the name of a category.
+  */
+ const char*
+  getCategoryName(uint16_t category) const;
+
+ /**
+  * @brief Sets the minimum severity of a sink (@ref LOG_SEVERITY_OFF disables it).
+  */
+ void
+  setSinkLevel(LogSinkType sink, LogSeverity severity) { m_sinkLevels[sink].store(severity, std::memory_order_relaxed); }
+
+ /**
+  * @brief Opens (truncates) the log file; an empty name closes it.
+  * @return True if the file is open.
+  */
+ bool
+  setFile(const std::string& fileName);
+
+ /**
+  * @brief Calls a function with the console lines, locked against the logger thread.
+  * @param reader Callable taking a `const LogBuffer&`; keep it short (visible lines only).
+  */
+ template<typename Reader>
+ void
+  readConsole(Reader&& reader) {
+  std::lock_guard<std::mutex> lock(m_consoleMutex);
+  reader(static_cast<const LogBuffer&>(m_console));
+ }
+
+ /**
+  * @brief Discards the console lines.
+  */
+ void
+  clearConsole();
+
+ /**
+  * @brief Gets the number of records dropped because a ring was full.
+  */
+ uint64_t
+  getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+ /**
+  * @brief Gets the display name of a severity.
+  */
+ static const char*
+  getSeverityName(LogSeverity severity);
+
+ /**
+  * @brief Parses a severity name ("trace", "debug", "info", "warning", "error", "off").
+  * @return False if the name is unknown.
+  */
+ static bool
+  parseSeverity(const std::string& name, LogSeverity& severity);
+
+private:
+ /**
+  * @enum ArgumentType
+  * @brief Tag written before each argument of a record.
+  */
+ enum
+ ArgumentType : uint8_t {
+  ARGUMENT_INT = 0,
+  ARGUMENT_UINT = 1,
+  ARGUMENT_DOUBLE = 2,
+  ARGUMENT_BOOL = 3,
+  ARGUMENT_CHAR = 4,
+  ARGUMENT_STRING = 5,
+  ARGUMENT_POINTER = 6,
+  ARGUMENT_VECTOR2 = 7
+ };
+
+ /**
+  * @brief Unformatted message as stored in the rings (256 bytes).
+  */
+ struct
+  Record {
+  uint64_t time = 0;                     ///< Nanoseconds since the logger started.
+  const char* format = nullptr;          ///< Format string (literal).
+  uint32_t thread = 0;                   ///< Writing thread index.
+  uint32_t sequence = 0;                 ///< Per-thread counter, orders records with equal time.
+  uint16_t category = 0;                 ///< Category index.
+  uint8_t severity = 0;                  ///< LogSeverity.
+  uint8_t truncated = 0;                 ///< Some argument did not fit.
+  uint16_t used = 0;                     ///< Bytes used in @ref arguments.
+  char arguments[ARGUMENT_BYTES];        ///< Tagged arguments.
+ };
+
+ /**
+  * @brief Single-producer single-consumer ring of one thread.
+  */
+ struct
+  ThreadBuffer {
+  Record records[RING_CAPACITY];             ///< Slots.
+  std::atomic<std::size_t> head{ 0 };        ///< Next slot to write (producer).
+  std::atomic<std::size_t> tail{ 0 };        ///< Next slot to read (consumer).
+  uint32_t index = 0;                        ///< Thread index.
+  uint32_t sequence = 0;                     ///< Records written by the thread.
+ };
+
+ /**
+  * @brief Registered category.
+  */
+ struct
+  Category {
+  std::atomic<const char*> name{ nullptr };                      ///< Category name.
+  std::atomic<LogSeverity> level{ LOG_SEVERITY_TRACE };          ///< Minimum severity.
+ };
+
+ /**
+  * @brief Copies raw bytes of one argument into the record.
+  */
+ static void
+  appendBytes(Record& record, ArgumentType type, const void* data, std::size_t size);
+
+ /**
+  * @brief Copies a string argument, truncated to the space left.
+  */
+ static void
+  appendString(Record& record, std::string_view text);
+
+ template<typename T>
+ struct IsVector2 : std::false_type {};
+ template<typename T>
+ struct IsVector2<sf::Vector2<T>> : std::true_type {};
+
+ /**
+  * @brief Encodes one argument according to its type.
+  */
+ template<typename T>
+ static void
+  appendArgument(Record& record, const T& value) {
+  using Type = std::decay_t<T>;
+  if constexpr (std::is_same_v<Type, bool>) {
+   appendBytes(record, ARGUMENT_BOOL, &value, sizeof(bool));
+  }
+  else if constexpr (std::is_same_v<Type, char>) {
+   appendBytes(record, ARGUMENT_CHAR, &value, sizeof(char));
+  }
+  else if constexpr (std::is_enum_v<Type>) {
+   const int64_t number = static_cast<int64_t>(value);
+   appendBytes(record, ARGUMENT_INT, &number, sizeof(number));
+  }
+  else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+   const int64_t number = value;
+   appendBytes(record, ARGUMENT_INT, &number, sizeof(number));
+  }
+  else if constexpr (std::is_integral_v<Type>) {
+   const uint64_t number = value;
+   appendBytes(record, ARGUMENT_UINT, &number, sizeof(number));
+  }
+  else if constexpr (std::is_floating_point_v<Type>) {
+   const double number = value;
+   appendBytes(record, ARGUMENT_DOUBLE, &number, sizeof(number));
+  }
+  else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+   appendString(record, value != nullptr ? std::string_view(value) : std::string_view("(null)"));
+  }
+  else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+   appendString(record, std::string_view(value));
+  }
+  else if constexpr (IsVector2<Type>::value) {
+   const double pair[2] = { static_cast<double>(value.x), static_cast<double>(value.y) };
+   appendBytes(record, ARGUMENT_VECTOR2, pair, sizeof(pair));
+  }
+  else if constexpr (std::is_pointer_v<Type>) {
+   const uint64_t address = reinterpret_cast<uintptr_t>(value);
+   appendBytes(record, ARGUMENT_POINTER, &address, sizeof(address));
+  }
+  else {
+   static_assert(std::is_pointer_v<Type>, "Logger: unsupported argument type");
+  }
+ }
+
+ /**
+  * @brief Stamps a record and copies it into the ring of the calling thread.
+  */
+ void
+  push(Record& record);
+
+ /**
+  * @brief Ring of the calling thread (registered on first use).
+  */
+ ThreadBuffer*
+  threadBuffer();
+
+ /**
+  * @brief Logger thread: drains, formats and dispatches until shutdown.
+  */
+ void
+  threadMain();
+
+ /**
+  * @brief Moves every queued record to the sinks.
+  */
+ void
+  drain();
+
+ /**
+  * @brief Expands the format string of a record.
+  */
+ void
+  format(const Record& record, std::string& out) const;
+
+ /**
+  * @brief Sends one formatted message to the sinks that accept its severity.
+  */
+ void
+  dispatch(const Record& record, const std::string& text);
+
+ std::chrono::steady_clock::time_point m_start;                 ///< Time origin of the records.
+ std::atomic<LogSeverity> m_level{ LOG_SEVERITY_TRACE };        ///< Global runtime level.
+ std::atomic<LogSeverity> m_sinkLevels[LOG_SINK_COUNT];         ///< Minimum severity per sink.
+ Category m_categories[MAX_CATEGORIES];                         ///< Registered categories.
+ std::atomic<uint16_t> m_categoryCount{ 0 };                    ///< Used entries of @ref m_categories.
+ std::mutex m_categoryMutex;                                    ///< Serializes category registration.
+
+ std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;          ///< Rings of every thread that logged.
+ std::mutex m_buffersMutex;                                     ///< Guards @ref m_buffers.
+ std::atomic<uint64_t> m_dropped{ 0 };                          ///< Records lost to full rings.
+ uint64_t m_reportedDropped = 0;                                ///< Drops already reported (logger thread).
+ std::vector<Record> m_pending;                                 ///< Drained records being sorted (logger thread).
+ std::string m_line;                                            ///< Formatting buffer (logger thread).
+
+ std::thread m_thread;                                          ///< Logger thread.
+ std::mutex m_wakeMutex;                                        ///< Guards the wake and flush state.
+ std::condition_variable m_wake;                                ///< Wakes the logger thread.
+ std::condition_variable m_flushed;                             ///< Signals completed flushes.
+ uint64_t m_flushRequests = 0;                                  ///< Flushes requested.
+ uint64_t m_flushesDone = 0;                                    ///< Flushes completed.
+ bool m_stop = false;                                           ///< Ends the logger thread.
+ std::atomic<bool> m_running{ false };                          ///< Accepting records.
+
+ std::ofstream m_file;                                          ///< File sink.
+ std::mutex m_fileMutex;                                        ///< Guards @ref m_file.
+ LogBuffer m_console;                                           ///< Console sink.
+ std::mutex m_consoleMutex;                                     ///< Guards @ref m_console.
+};
+
+/**
+ * @brief Logs a message if it passes the category and global levels.
+ * @param severity LogSeverity of the message.
+ * @param category Category name (string literal).
+ */
+#define ENGINE_LOG(severity, category, ...)                                              \
+ do {                                                                                    \
+  static const uint16_t logCategory_ = Logger::getInstance().registerCategory(category); \
+  if (Logger::getInstance().isEnabled(severity, logCategory_)) {                         \
+   Logger::getInstance().write(severity, logCategory_, __VA_ARGS__);                     \
+  }                                                                                      \
+ } while (0)
+
+#if ENGINE_LOG_LEVEL <= 0
+#define LOG_TRACE(category, ...) ENGINE_LOG(LOG_SEVERITY_TRACE, category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ((void)0)
+#endif
+
+#if ENGINE_LOG_LEVEL <= 1
+#define LOG_DEBUG(category, ...) ENGINE_LOG(LOG_SEVERITY_DEBUG, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if ENGINE_LOG_LEVEL <= 2
+#define LOG_INFO(category, ...) ENGINE_LOG(LOG_SEVERITY_INFO, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if ENGINE_LOG_LEVEL <= 3
+#define LOG_WARNING(category, ...) ENGINE_LOG(LOG_SEVERITY_WARNING, category, __VA_ARGS__)
+#else
+#define LOG_WARNING(category, ...) ((void)0)
+#endif
+
+#if ENGINE_LOG_LEVEL <= 4
+#define LOG_ERROR(category, ...) ENGINE_LOG(LOG_SEVERITY_ERROR, category, __VA_ARGS__)
+#else
+#define LOG_ERROR(category, ...) ((void)0)
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * @details
+ * The file contents are paged in by the OS on first access, so opening a large
+ * file costs the same as opening a small one and untouched parts never reach
+ * memory. Uses `CreateFileMapping` on Windows and `mmap` elsewhere.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @class MappedFile
+ * @brief Owns a read-only view of a file.
+ */
+class
+ MappedFile {
+public:
+ /**
+  * @brief Default constructor (nothing mapped).
+  */
+ MappedFile() = default;
+
+ /**
+  * @brief Unmaps the file.
+  */
+ ~MappedFile();
+
+ MappedFile(const MappedFile&) = delete;
+ MappedFile& operator=(const MappedFile&) = delete;
+
+ /**
+  * @brief Maps a file.
+  * @param fileName File to map.
+  * @return True on success (an empty file fails).
+  */
+ bool
+  open(const std::string& fileName);
+
+ /**
+  * @brief Unmaps the file.
+  */
+ void
+  close();
+
+ /**
+  * @brief Returns true if a file is mapped.
+  */
+ bool
+  isOpen() const { return m_data != nullptr; }
+
+ /**
+  * @brief Gets the first byte of the mapping.
+  */
+ const uint8_t*
+  getData() const { return m_data; }
+
+ /**
+  * @brief Gets the mapping size in bytes.
+  */
+ std::size_t
+  getSize() const { return m_size; }
+
+private:
+ const uint8_t* m_data = nullptr;  ///< Mapped view.
+ std::size_t m_size = 0;           ///< View size.
+#if defined(_WIN32)
+ void* m_file = nullptr;           ///< File handle.
+ void* m_mapping = nullptr;        ///< Mapping handle.
+#endif
+};
@@ -0,0 +1,189 @@
+/**
+ * @file MemoryTracker.h
+ * @brief Allocation tracking: global new/delete hooks, per-type and per-frame counters.
+ *
+ * @details
+ * The global `operator new`/`operator delete` (plain, array and nothrow forms)
+ * are replaced: blocks come straight from `malloc` and their size and type are
+ * kept in a side table keyed by address, so frees are attributed correctly even
+ * through a base pointer. Counters are relaxed atomics and the table is split
+ * in spin-locked shards, so any thread may allocate.
+ *
+ * Safe configuration: the engine and every module that may free its blocks
+ * share one CRT heap, i.e. the shared runtime (/MD, the default of the project
+ * and what the SFML DLLs need) or SFML linked statically. Nothing is read in
+ * front of a pointer: a block missing from the table (allocated by another
+ * module) goes straight to `free`. A block the engine allocated and a DLL frees
+ * with its own `delete` stays counted as live until its address is reused.
+ * Do not enable the hooks with a static CRT (/MT) and DLL dependencies: each
+ * module would then own a different heap.
+ *
+ * The type comes from @ref EngineUtilities::MakeShared and
+ * @ref EngineUtilities::MakeUnique, which tag the next allocation of their
+ * thread; everything else (containers, strings, raw `new`) is counted as
+ * "untyped". Aligned `new` (over-aligned types) and `malloc` are not hooked.
+ *
+ * Once per frame @ref MemoryTracker::endFrame takes the allocations made since
+ * the previous frame by the frame thread (see @ref MemoryTracker::setFrameThread);
+ * other threads (logger, workers, render thread) only count in the totals. With
+ * @ref MemoryTracker::setSteadyStateAssert any allocation of the frame thread
+ * after the warm-up frames prints the culprits and stops the program.
+ *
+ * Compiled in when `ENGINE_MEMORY_TRACKING` is 1 (the default in Debug builds,
+ * see Memory/AllocationTag.h). With 0 the hooks are not installed and the
+ * MEMORY_ macros expand to nothing.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+#if ENGINE_MEMORY_TRACKING
+
+/**
+ * @class MemoryTracker
+ * @brief Reads and aggregates the allocation counters (singleton).
+ */
+class
+ MemoryTracker {
+private:
+ MemoryTracker() = default;
+ ~MemoryTracker() = default;
+
+public:
+ MemoryTracker(const MemoryTracker&) = delete;
+ MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+ /**
+  * @brief Provides access to the single MemoryTracker instance.
+  */
+ static MemoryTracker& getInstance() {
+  static MemoryTracker instance;
+  return instance;
+ }
+
+ /** @brief Types that can be registered; later types are counted as untyped. */
+ static constexpr uint32_t MAX_TYPES = 512;
+
+ /** @brief Frames kept in the allocation history. */
+ static constexpr std::size_t HISTORY_FRAMES = 240;
+
+ /**
+  * @brief Counters of the whole process.
+  */
+ struct
+  Totals {
+  uint64_t allocations = 0;       ///< Allocations since start.
+  uint64_t frees = 0;             ///< Frees since start.
+  int64_t liveBytes = 0;          ///< Bytes allocated and not freed.
+  int64_t peakBytes = 0;          ///< Highest @ref liveBytes.
+  uint64_t frameAllocations = 0;  ///< Allocations in the last frame.
+  uint64_t frameBytes = 0;        ///< Bytes allocated in the last frame.
+ };
+
+ /**
+  * @brief Counters of one type.
+  */
+ struct
+  TypeStats {
+  const char* name = nullptr;     ///< Type name as given by typeid.
+  std::size_t size = 0;           ///< sizeof the type (0 for untyped).
+  uint64_t allocations = 0;       ///< Allocations since start.
+  uint64_t frees = 0;             ///< Frees since start.
+  int64_t liveBytes = 0;          ///< Bytes allocated and not freed.
+  int64_t peakBytes = 0;          ///< Highest @ref liveBytes.
+  uint64_t frameAllocations = 0;  ///< Allocations in the last frame.
+ };
+
+ /**
+  * @brief Closes the frame: moves the allocations made since the previous call to the last frame.
+  *
+  * @details
+  * Call once per frame from the main loop. In steady-state assert mode a frame
+  * that allocated after the warm-up stops the program.
+  */
+ void
+  endFrame();
+
+ /**
+  * @brief Makes the calling thread the one whose allocations count per frame.
+  *
+  * @details
+  * Call it from the simulation thread before the loop. Threads that allocate
+  * on their own schedule (the logger thread formatting a line, a worker
+  * decoding a texture) would otherwise land in whatever frame is open.
+  */
+ void
+  setFrameThread();
+
+ /**
+  * @brief Makes any allocation after the warm-up frames an error.
+  * @param warmupFrames Frames allowed to allocate (loading, caches, pools growing).
+  */
+ void
+  setSteadyStateAssert(uint32_t warmupFrames);
+
+ /**
+  * @brief True while the steady-state assert is armed.
+  */
+ bool
+  isSteadyStateAssert() const { return m_assertEnabled; }
+
+ /**
+  * @brief Gets the process counters.
+  */
+ Totals
+  getTotals() const;
+
+ /**
+  * @brief Copies the counters of every registered type.
+  * @param out Destination, reused between calls (it does not allocate once it has grown).
+  */
+ void
+  getTypeStats(std::vector<TypeStats>& out) const;
+
+ /**
+  * @brief Ring of allocations per frame (for ImGui::PlotLines).
+  */
+ const float*
+  getHistory() const { return m_history; }
+
+ /**
+  * @brief Index of the oldest sample in @ref getHistory.
+  */
+ int
+  getHistoryOffset() const { return static_cast<int>(m_historyNext); }
+
+ /**
+  * @brief Gets the number of closed frames.
+  */
+ uint64_t
+  getFrameCount() const { return m_frame; }
+
+private:
+ /**
+  * @brief Prints the types that allocated in the last frame.
+  */
+ void
+  printFrameAllocations(std::ostream& out) const;
+
+ uint64_t m_frame = 0;                      ///< Frames closed.
+ uint64_t m_frameAllocations = 0;           ///< Allocations of the last frame.
+ uint64_t m_frameBytes = 0;                 ///< Bytes of the last frame.
+ uint64_t m_typeFrame[MAX_TYPES] = {};      ///< Allocations per type in the last frame.
+ float m_history[HISTORY_FRAMES] = {};      ///< Allocations of the last frames.
+ std::size_t m_historyNext = 0;             ///< Next slot of the ring.
+ bool m_assertEnabled = false;              ///< Steady-state assert armed.
+ uint64_t m_assertFrom = 0;                 ///< First frame that must not allocate.
+};
+
+/** @brief Counts the frame allocations of the calling thread. */
+#define MEMORY_FRAME_THREAD() MemoryTracker::getInstance().setFrameThread()
+/** @brief Closes the allocation counters of the frame. */
+#define MEMORY_END_FRAME() MemoryTracker::getInstance().endFrame()
+
+#else
+
+#define MEMORY_FRAME_THREAD() ((void)0)
+#define MEMORY_END_FRAME() ((void)0)
+
+#endif
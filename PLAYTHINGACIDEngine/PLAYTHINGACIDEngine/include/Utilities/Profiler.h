@@ -0,0 +1,345 @@
+/**
+ * @file Profiler.h
+ * @brief Hierarchical CPU profiler with per-thread ring buffers.
+ *
+ * @details
+ * Code is instrumented with @ref PROFILE_SCOPE / @ref PROFILE_FUNCTION. A scope
+ * reads `std::chrono::steady_clock` when it opens and, when it closes, writes
+ * one event (name, start, end, depth) into the ring buffer of its thread. Each
+ * ring has a single writer (its thread) and a single reader (the main thread),
+ * so recording takes no lock; when a ring is full new events are dropped and
+ * counted.
+ *
+ * Once per frame @ref Profiler::endFrame drains every ring and folds the events
+ * into a call tree per thread: each node keeps its time in the last frame and
+ * a history of per-frame times, from which min/avg/max/p99 are computed. The
+ * events of the last frame are kept for the flame graph.
+ *
+ * @ref PROFILE_COUNTER records a value sample through the same rings. A
+ * capture (@ref Profiler::startCapture) copies the drained events of the next
+ * N frames, with their frame boundaries, into one bounded buffer and writes it
+ * as Chrome trace-event JSON when the last frame ends; the file opens in
+ * chrome://tracing and ui.perfetto.dev.
+ *
+ * The profiler is compiled in when `ENGINE_PROFILER` is 1 (the default). With
+ * 0 the macros expand to nothing and the Profiler class does not exist.
+ *
+ * @note Scope names must be string literals (or otherwise outlive the profiler).
+ * @note Instrument systems, not entities: a scope per actor overflows the
+ * ring (8192 events per thread and frame) in stress scenes and drops the end
+ * events of the enclosing scopes. Time entity loops as one scope.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+
+#ifndef ENGINE_PROFILER
+#define ENGINE_PROFILER 1
+#endif
+
+#if ENGINE_PROFILER
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * @class Profiler
+ * @brief Collects scope timings from every thread and aggregates them per frame (singleton).
+ */
+class
+ Profiler {
+private:
+ Profiler() = default;
+ ~Profiler();
+
+public:
+ Profiler(const Profiler&) = delete;
+ Profiler& operator=(const Profiler&) = delete;
+
+ /**
+  * @brief Provides access to the single Profiler instance.
+  */
+ static Profiler& getInstance() {
+  static Profiler instance;
+  return instance;
+ }
+
+ /** @brief Frames kept in the history of every scope. */
+ static constexpr std::size_t HISTORY_FRAMES = 240;
+
+ /** @brief Events a capture may hold (32 bytes each, reserved when it starts); a capture that fills it ends early. */
+ static constexpr std::size_t MAX_CAPTURE_EVENTS = std::size_t(1) << 20;
+
+ /** @brief Depth that marks a counter sample; its value is stored in Event::end. */
+ static constexpr uint32_t COUNTER_DEPTH = UINT32_MAX;
+
+ /**
+  * @brief Timed scope as stored in the rings and in the last frame.
+  */
+ struct
+  Event {
+  const char* name = nullptr;  ///< Scope or counter name.
+  uint64_t start = 0;          ///< Opening time (ns).
+  uint64_t end = 0;            ///< Closing time (ns), or the value of a counter.
+  uint32_t depth = 0;          ///< Nesting level on its thread, or @ref COUNTER_DEPTH.
+  uint32_t thread = 0;         ///< Thread index.
+ };
+
+ /**
+  * @brief Node of the aggregated call tree.
+  */
+ struct
+  Node {
+  const char* name = nullptr;           ///< Scope name (null for thread roots, see @ref getThreadName).
+  int parent = -1;                      ///< Parent node, -1 for thread roots.
+  uint32_t thread = 0;                  ///< Thread index.
+  std::vector<int> children;            ///< Child nodes.
+  uint64_t frameTime = 0;               ///< Time in the last frame (ns).
+  uint32_t frameCalls = 0;              ///< Calls in the last frame.
+  std::vector<uint64_t> history;        ///< Per-frame times, ring of HISTORY_FRAMES.
+  std::size_t historyNext = 0;          ///< Next slot of @ref history.
+ };
+
+ /**
+  * @brief Statistics of a node over its history.
+  */
+ struct
+  Stats {
+  double minMs = 0.0;  ///< Fastest frame.
+  double avgMs = 0.0;  ///< Average frame.
+  double maxMs = 0.0;  ///< Slowest frame.
+  double p99Ms = 0.0;  ///< 99th percentile.
+ };
+
+ /**
+  * @brief Monotonic time in nanoseconds.
+  */
+ static uint64_t
+  now();
+
+ /**
+  * @brief Opens a scope on the calling thread (used by @ref PROFILE_SCOPE).
+  */
+ static void
+  enter();
+
+ /**
+  * @brief Closes the innermost scope of the calling thread and records it.
+  * @param name Scope name.
+  * @param start Time returned by @ref now when the scope opened.
+  */
+ static void
+  leave(const char* name, uint64_t start);
+
+ /**
+  * @brief Records a counter sample on the calling thread.
+  * @param name Counter name.
+  * @param value Sampled value.
+  */
+ static void
+  counter(const char* name, uint64_t value);
+
+ /**
+  * @brief Names the calling thread.
+  */
+ void
+  setThreadName(const std::string& name);
+
+ /**
+  * @brief Drains the rings and aggregates the frame that just ended (main thread).
+  */
+ void
+  endFrame();
+
+ /**
+  * @brief Starts capturing the next frames to a trace file.
+  * @param frames Frames to capture.
+  * @param fileName Chrome trace file written when the capture ends.
+  *
+  * @details
+  * Ignored while another capture is running.
+  */
+ void
+  startCapture(uint32_t frames, const std::string& fileName);
+
+ /**
+  * @brief Returns true while a capture is running.
+  */
+ bool
+  isCapturing() const { return m_captureTarget > 0; }
+
+ /**
+  * @brief Gets the frames captured so far.
+  */
+ uint32_t
+  getCapturedFrames() const { return static_cast<uint32_t>(m_captureFrames.size()); }
+
+ /**
+  * @brief Gets the frames the running capture is waiting for.
+  */
+ uint32_t
+  getCaptureTarget() const { return m_captureTarget; }
+
+ /**
+  * @brief Freezes the statistics (the rings keep being drained).
+  */
+ void
+  setPaused(bool paused) { m_paused = paused; }
+
+ /**
+  * @brief Returns true if the statistics are frozen.
+  */
+ bool
+  isPaused() const { return m_paused; }
+
+ /**
+  * @brief Gets the nodes of the call tree (thread roots have parent -1).
+  */
+ const std::vector<Node>&
+  getNodes() const { return m_nodes; }
+
+ /**
+  * @brief Computes min/avg/max/p99 of a node.
+  */
+ Stats
+  getStats(const Node& node) const;
+
+ /**
+  * @brief Gets the events of the last aggregated frame.
+  */
+ const std::vector<Event>&
+  getLastFrame() const { return m_lastFrame; }
+
+ /**
+  * @brief Gets the start of the last aggregated frame (ns).
+  */
+ uint64_t
+  getLastFrameStart() const { return m_lastFrameStart; }
+
+ /**
+  * @brief Gets the end of the last aggregated frame (ns).
+  */
+ uint64_t
+  getLastFrameEnd() const { return m_lastFrameEnd; }
+
+ /**
+  * @brief Gets the number of registered threads.
+  */
+ std::size_t
+  getThreadCount() const;
+
+ /**
+  * @brief Gets the name of a thread.
+  */
+ std::string
+  getThreadName(uint32_t thread) const;
+
+ /**
+  * @brief Gets the number of events dropped because a ring was full.
+  */
+ uint64_t
+  getDroppedCount() const;
+
+private:
+ struct ThreadBuffer;
+
+ /**
+  * @brief Ring of the calling thread, registered on first use.
+  */
+ static ThreadBuffer&
+  threadBuffer();
+
+ /**
+  * @brief Writes one event into a ring, or counts it as dropped when full.
+  */
+ static void
+  push(ThreadBuffer& buffer, const char* name, uint64_t start, uint64_t end, uint32_t depth);
+
+ /**
+  * @brief Child of @p parent named @p name, created if missing.
+  */
+ int
+  findChild(int parent, const char* name, uint32_t thread);
+
+ /**
+  * @brief Adds the drained events to the capture and ends it when done.
+  */
+ void
+  captureFrame(uint64_t frameEnd);
+
+ /**
+  * @brief Writes the capture as Chrome trace-event JSON and releases it.
+  */
+ void
+  finishCapture();
+
+ /**
+  * @brief Frame boundaries recorded by a capture.
+  */
+ struct
+  FrameMark {
+  uint64_t start = 0;  ///< Frame start (ns).
+  uint64_t end = 0;    ///< Frame end (ns).
+ };
+
+ /**
+  * @brief Scope still open while the drained events of a thread are folded into the tree.
+  */
+ struct
+  OpenScope {
+  int node;            ///< Node of the scope.
+  uint32_t depth;      ///< Nesting depth of its event.
+ };
+
+ mutable std::mutex m_threadsMutex;          ///< Guards @ref m_threads.
+ std::vector<ThreadBuffer*> m_threads;       ///< Rings by thread index.
+ std::vector<Node> m_nodes;                  ///< Call tree (main thread).
+ std::vector<int> m_roots;                   ///< Root node of every thread.
+ std::vector<Event> m_drained;               ///< Scratch for the drained events.
+ std::vector<OpenScope> m_openScopes;        ///< Scratch stack of endFrame (keeps its capacity).
+ std::vector<Event> m_lastFrame;             ///< Events of the last frame.
+ uint64_t m_frameStart = 0;                  ///< Start of the current frame.
+ uint64_t m_lastFrameStart = 0;              ///< Start of the last aggregated frame.
+ uint64_t m_lastFrameEnd = 0;                ///< End of the last aggregated frame.
+ bool m_paused = false;                      ///< Statistics frozen.
+ uint32_t m_captureTarget = 0;               ///< Frames to capture, 0 when idle.
+ std::string m_captureFile;                  ///< Trace file of the running capture.
+ std::vector<Event> m_capture;               ///< Captured events.
+ std::vector<FrameMark> m_captureFrames;     ///< Captured frame boundaries.
+};
+
+/**
+ * @class ProfileScope
+ * @brief Times the enclosing block.
+ */
+class
+ ProfileScope {
+public:
+ explicit ProfileScope(const char* name) : m_name(name), m_start(Profiler::now()) { Profiler::enter(); }
+ ~ProfileScope() { Profiler::leave(m_name, m_start); }
+ ProfileScope(const ProfileScope&) = delete;
+ ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+ const char* m_name;  ///< Scope name.
+ uint64_t m_start;    ///< Opening time.
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#define PROFILE_SCOPE(name)        ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_FUNCTION()         PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_COUNTER(name, value) Profiler::counter(name, static_cast<uint64_t>(value))
+#define PROFILE_THREAD_NAME(name)  Profiler::getInstance().setThreadName(name)
+#define PROFILE_END_FRAME()        Profiler::getInstance().endFrame()
+
+#else
+
+#define PROFILE_SCOPE(name)        ((void)0)
+#define PROFILE_FUNCTION()         ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#define PROFILE_THREAD_NAME(name)  ((void)0)
+#define PROFILE_END_FRAME()        ((void)0)
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file SpatialGrid.h
+ * @brief Uniform hash grid over item bounds, for point and rectangle queries.
+ *
+ * @details
+ * Items are small integer ids (e.g. actor indices) with an axis-aligned box.
+ * Each item is stored in every cell its box overlaps; a query only visits the
+ * cells it overlaps, so its cost depends on the local density and not on the
+ * item count. Moving an item that stays in the same cells only stores the new
+ * box. A cell that empties keeps its node and capacity, so items moving over
+ * cells they (or others) visited before do not allocate; only @ref clear
+ * releases them. Items covering more than @ref MAX_ITEM_CELLS cells are kept apart and
+ * tested on every query.
+ *
+ * Queries use an internal stamp to report each item once, so they must not run
+ * concurrently with each other or with updates.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include <unordered_map>
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform grid of item ids, keyed by cell.
+ */
+class
+ SpatialGrid {
+public:
+ /** @brief Items spanning more cells than this go to the oversized list. */
+ static constexpr int MAX_ITEM_CELLS = 64;
+
+ /**
+  * @param cellSize Side of a cell in world units (about the size of a typical item).
+  */
+ explicit SpatialGrid(float cellSize = 64.f);
+
+ /**
+  * @brief Removes every item and releases the cells (keeps the cell size).
+  */
+ void
+  clear();
+
+ /**
+  * @brief Changes the cell size; only allowed while the grid is empty.
+  */
+ void
+  setCellSize(float cellSize);
+
+ /**
+  * @brief Inserts, moves or removes an item.
+  * @param id Item id (ids index an internal array: keep them dense).
+  * @param bounds New box; an empty box removes the item.
+  */
+ void
+  update(int id, const sf::FloatRect& bounds);
+
+ /**
+  * @brief Removes an item (no-op if absent).
+  */
+ void
+  remove(int id);
+
+ /**
+  * @brief Collects the items whose box contains a point.
+  * @param point World position.
+  * @param out Ids are appended, each once.
+  */
+ void
+  queryPoint(const sf::Vector2f& point, std::vector<int>& out) const;
+
+ /**
+  * @brief Collects the items whose box overlaps a rectangle.
+  * @param rect World rectangle.
+  * @param out Ids are appended, each once.
+  */
+ void
+  queryRect(const sf::FloatRect& rect, std::vector<int>& out) const;
+
+ /**
+  * @brief Gets the number of items stored.
+  */
+ std::size_t
+  size() const { return m_count; }
+
+ /**
+  * @brief Gets the number of cells created (emptied cells are kept until @ref clear).
+  */
+ std::size_t
+  getCellCount() const { return m_cells.size(); }
+
+private:
+ /**
+  * @brief Stored state of an item.
+  */
+ struct
+  Item {
+  sf::FloatRect bounds;     ///< Last box.
+  int minX = 0;             ///< First cell column.
+  int minY = 0;             ///< First cell row.
+  int maxX = -1;            ///< Last cell column.
+  int maxY = -1;            ///< Last cell row.
+  bool stored = false;      ///< In the grid (or the oversized list).
+  bool oversized = false;   ///< In the oversized list.
+ };
+
+ /**
+  * @brief Packs cell coordinates into a map key.
+  */
+ static uint64_t
+  cellKey(int x, int y) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+ }
+
+ /**
+  * @brief Cell containing a world coordinate.
+  */
+ int
+  cellOf(float value) const;
+
+ /**
+  * @brief Takes an item out of its cells.
+  */
+ void
+  unlink(int id, Item& item);
+
+ /**
+  * @brief Appends @p id to @p out unless it was already reported by this query.
+  */
+ void
+  report(int id, std::vector<int>& out) const;
+
+ float m_cellSize;                                       ///< Side of a cell.
+ float m_inverseCell;                                    ///< 1 / m_cellSize.
+ std::unordered_map<uint64_t, std::vector<int>> m_cells; ///< Ids per cell (kept when empty).
+ std::vector<Item> m_items;                              ///< Items by id.
+ std::vector<int> m_oversized;                           ///< Items tested on every query.
+ std::size_t m_count = 0;                                ///< Items stored.
+ mutable std::vector<uint32_t> m_stamps;                 ///< Last query that reported each id.
+ mutable uint32_t m_query = 0;                           ///< Current query stamp.
+};
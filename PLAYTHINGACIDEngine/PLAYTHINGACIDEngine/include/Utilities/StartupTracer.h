@@ -0,0 +1,178 @@
+/**
+ * @file StartupTracer.h
+ * @brief Timeline of the engine start-up (window, ImGui, texture loads, actors).
+ *
+ * @details
+ * Spans are opened and closed with @ref STARTUP_SCOPE from any thread; each
+ * thread keeps its own nesting. Times come from `std::chrono::steady_clock`,
+ * relative to the first use of the tracer. Span names are static strings;
+ * @ref STARTUP_SCOPE_DETAIL appends a runtime detail (a file name), which is
+ * only copied into the span while recording.
+ *
+ * Recording stops at @ref StartupTracer::finish, which can write the spans as
+ * Chrome trace-event JSON (open it in chrome://tracing or ui.perfetto.dev) and
+ * print a summary table. After that, scopes cost one atomic load.
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+/**
+ * @class StartupTracer
+ * @brief Records nested start-up spans (singleton, thread-safe).
+ */
+class
+ StartupTracer {
+private:
+ /**
+  * @brief Sets the time origin.
+  */
+ StartupTracer();
+
+ ~StartupTracer() = default;
+
+public:
+ StartupTracer(const StartupTracer&) = delete;
+ StartupTracer& operator=(const StartupTracer&) = delete;
+
+ /**
+  * @brief Provides access to the single StartupTracer instance.
+  */
+ static StartupTracer& getInstance() {
+  static StartupTracer instance;
+  return instance;
+ }
+
+ /**
+  * @brief Opens a span on the calling thread (ignored after @ref finish).
+  * @param name Span name.
+  * @param detail Optional text appended to the name (e.g. a file name).
+  */
+ void
+  begin(const char* name, const std::string* detail = nullptr);
+
+ /**
+  * @brief Closes the innermost open span of the calling thread.
+  */
+ void
+  end();
+
+ /**
+  * @brief Names the calling thread in the trace.
+  */
+ void
+  setThreadName(const std::string& name);
+
+ /**
+  * @brief Returns true until @ref finish is called.
+  */
+ bool
+  isRecording() const { return m_recording.load(std::memory_order_acquire); }
+
+ /**
+  * @brief Stops recording and writes the results.
+  * @param traceFile Chrome trace file to write (empty: none).
+  * @param printSummary Print the summary table to stdout.
+  *
+  * @details
+  * Spans still open are closed at the current time.
+  */
+ void
+  finish(const std::string& traceFile, bool printSummary);
+
+ /**
+  * @brief Writes the recorded spans as Chrome trace-event JSON.
+  * @param fileName Output file.
+  * @return True on success.
+  */
+ bool
+  writeChromeTrace(const std::string& fileName) const;
+
+ /**
+  * @brief Prints every span per thread, indented by depth, with its total and self time.
+  * @param out Output stream.
+  */
+ void
+  printSummary(std::ostream& out) const;
+
+ /**
+  * @class Scope
+  * @brief Opens a span for the lifetime of the object, if the tracer is recording.
+  */
+ class
+  Scope {
+ public:
+  explicit Scope(const char* name) : m_tracer(StartupTracer::getInstance()), m_open(m_tracer.isRecording()) {
+   if (m_open) {
+    m_tracer.begin(name);
+   }
+  }
+  Scope(const char* name, const std::string& detail) : m_tracer(StartupTracer::getInstance()), m_open(m_tracer.isRecording()) {
+   if (m_open) {
+    m_tracer.begin(name, &detail);
+   }
+  }
+  ~Scope() {
+   if (m_open) {
+    m_tracer.end();
+   }
+  }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  StartupTracer& m_tracer;  ///< Tracer instance.
+  bool m_open;              ///< A span was opened (recording at construction).
+ };
+
+private:
+ /**
+  * @brief Recorded span (times in microseconds since the origin).
+  */
+ struct
+  Span {
+  std::string name;     ///< Span name.
+  uint32_t thread = 0;  ///< Index into @ref m_threadNames.
+  uint32_t depth = 0;   ///< Nesting level on its thread.
+  uint64_t start = 0;   ///< Opening time.
+  uint64_t end = 0;     ///< Closing time (0 while open).
+ };
+
+ /**
+  * @brief Microseconds since the origin.
+  */
+ uint64_t
+  now() const;
+
+ /**
+  * @brief Index of the calling thread; registers it on first use (lock held).
+  */
+ uint32_t
+  threadIndex();
+
+ std::chrono::steady_clock::time_point m_origin;              ///< Time zero.
+ std::atomic<bool> m_recording{ true };                       ///< False after finish.
+ mutable std::mutex m_mutex;                                  ///< Guards the members below.
+ std::vector<Span> m_spans;                                   ///< Spans in opening order.
+ std::vector<std::string> m_threadNames;                      ///< Thread names by index.
+ std::unordered_map<std::thread::id, uint32_t> m_threads;     ///< Thread index by id.
+};
+
+#define STARTUP_CONCAT_(a, b) a##b
+#define STARTUP_CONCAT(a, b) STARTUP_CONCAT_(a, b)
+
+/**
+ * @brief Records the enclosing block as a start-up span.
+ * @param name Static span name (`const char*`).
+ */
+#define STARTUP_SCOPE(name) StartupTracer::Scope STARTUP_CONCAT(startupScope_, __LINE__)(name)
+
+/**
+ * @brief Records the enclosing block as a start-up span named `name detail`.
+ * @param name Static span name (`const char*`).
+ * @param detail `const std::string&` appended to the name; only copied while recording.
+ */
+#define STARTUP_SCOPE_DETAIL(name, detail) StartupTracer::Scope STARTUP_CONCAT(startupScope_, __LINE__)(name, detail)
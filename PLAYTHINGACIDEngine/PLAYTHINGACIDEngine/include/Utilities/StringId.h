@@ -0,0 +1,175 @@
+/**
+ * @file StringId.h
+ * @brief 64-bit hashed identifiers for names and resource keys.
+ *
+ * @details
+ * A StringId is the 64-bit FNV-1a hash of a string. Comparing and hashing ids
+ * is an integer operation, so maps keyed by ids avoid hashing and comparing
+ * whole strings on every lookup.
+ *
+ * - Ids built from string literals are hashed at compile time
+ *   (`getTexture("Sprites/WhiteCamo")` costs no hashing at run time). Any
+ *   character array is hashed up to its first NUL, so a `char buffer[64]`
+ *   gives the same id as the `std::string` it holds.
+ * - Ids built from runtime strings are interned: the text is stored once in
+ *   the global @ref StringIdTable, so equal names share their storage and
+ *   @ref StringId::getString can give it back (GUI, logs).
+ *
+ * Literal ids can show their text once the same string has been interned
+ * (resources are interned when they are loaded).
+ */
+
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+
+/**
+ * @class StringId
+ * @brief Hashed identifier of a string.
+ */
+class
+ StringId {
+public:
+ /**
+  * @brief Null id (hash 0).
+  */
+ constexpr StringId() = default;
+
+ /**
+  * @brief Builds an id from a string literal (hashed at compile time) or a character array.
+  * @param literal Characters up to the first NUL (or the whole array) are hashed.
+  * @note Not interned: @ref getString only knows the text once an equal runtime string was.
+  */
+ template<std::size_t N>
+ constexpr StringId(const char (&literal)[N]) : m_hash(hash(literal, length(literal, N))) {}
+
+ /**
+  * @brief Builds an id from a runtime string and interns the text.
+  * @param text String to hash.
+  */
+ explicit StringId(const std::string& text);
+
+ /**
+  * @brief Wraps an existing hash.
+  */
+ static constexpr StringId
+  fromHash(uint64_t value) {
+  StringId id;
+  id.m_hash = value;
+  return id;
+ }
+
+ /**
+  * @brief Length of a string stored in an array of @p capacity characters.
+  */
+ static constexpr std::size_t
+  length(const char* text, std::size_t capacity) {
+  std::size_t size = 0;
+  while (size < capacity && text[size] != '\0') {
+   ++size;
+  }
+  return size;
+ }
+
+ /**
+  * @brief FNV-1a 64 hash of a character range.
+  */
+ static constexpr uint64_t
+  hash(const char* text, std::size_t length) {
+  uint64_t value = 14695981039346656037ull;
+  for (std::size_t i = 0; i < length; ++i) {
+   value ^= static_cast<uint8_t>(text[i]);
+   value *= 1099511628211ull;
+  }
+  return value;
+ }
+
+ /**
+  * @brief Gets the hash.
+  */
+ constexpr uint64_t
+  getHash() const { return m_hash; }
+
+ /**
+  * @brief Returns true for the null id.
+  */
+ constexpr bool
+  isNull() const { return m_hash == 0; }
+
+ /**
+  * @brief Gets the interned text.
+  * @return The text, or an empty string if it was never interned.
+  */
+ const std::string&
+  getString() const;
+
+ constexpr bool operator==(const StringId& other) const { return m_hash == other.m_hash; }
+ constexpr bool operator!=(const StringId& other) const { return m_hash != other.m_hash; }
+ constexpr bool operator<(const StringId& other) const { return m_hash < other.m_hash; }
+
+private:
+ uint64_t m_hash = 0; ///< FNV-1a hash of the text.
+};
+
+/**
+ * @brief Writes the interned text, or the hash in hex if the text is unknown.
+ */
+std::ostream&
+operator<<(std::ostream& stream, const StringId& id);
+
+namespace std {
+ template<>
+ struct
+  hash<StringId> {
+  std::size_t
+   operator()(const StringId& id) const noexcept { return static_cast<std::size_t>(id.getHash()); }
+ };
+}
+
+/**
+ * @class StringIdTable
+ * @brief Global intern table of the texts behind runtime ids (singleton, thread-safe).
+ */
+class
+ StringIdTable {
+private:
+ StringIdTable() = default;
+ ~StringIdTable() = default;
+
+public:
+ StringIdTable(const StringIdTable&) = delete;
+ StringIdTable& operator=(const StringIdTable&) = delete;
+
+ /**
+  * @brief Provides access to the single StringIdTable instance.
+  */
+ static StringIdTable& getInstance() {
+  static StringIdTable instance;
+  return instance;
+ }
+
+ /**
+  * @brief Stores the text of a hash (once); reports hash collisions.
+  * @param hash Hash of @p text.
+  * @param text Text to store.
+  */
+ void
+  intern(uint64_t hash, const std::string& text);
+
+ /**
+  * @brief Finds the text of a hash.
+  * @return Stored text, or null if unknown. Stays valid for the program lifetime.
+  */
+ const std::string*
+  find(uint64_t hash) const;
+
+ /**
+  * @brief Gets the number of interned strings.
+  */
+ std::size_t
+  getCount() const;
+
+private:
+ mutable std::mutex m_mutex;                           ///< Guards @ref m_strings.
+ std::unordered_map<uint64_t, std::string> m_strings;  ///< Text by hash (nodes never move).
+};
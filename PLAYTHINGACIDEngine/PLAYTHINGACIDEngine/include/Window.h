@@ -1,5 +1,6 @@
 #pragma once
 #include "Prerequisites.h"
+#include "Render/RenderBackend.h"
 
 class EngineGUI;
 
@@ -24,6 +25,15 @@ public:
   */
  Window(int width, int height, const std::string& title);
 
+ /**
+  * @brief Constructor that selects the rendering backend
+  * @param width
+  * @param height
+  * @param title
+  * @param backendType SFML_WINDOW opens a real window, SOFTWARE renders offscreen on the CPU
+  */
+ Window(int width, int height, const std::string& title, RenderBackendType backendType);
+
  /**
   * @brief Destructor
   */
@@ -58,6 +68,51 @@ public:
   draw(const sf::Drawable& drawable,
   const sf::RenderStates& states = sf::RenderStates::Default);
 
+ /**
+  * @brief Draws a range of already transformed vertices
+  * @param vertices Pointer to the first vertex
+  * @param vertexCount Number of vertices
+  * @param type Primitive type
+  * @param states Render states
+  */
+ void
+  draw(const sf::Vertex* vertices,
+  std::size_t vertexCount,
+  sf::PrimitiveType type,
+  const sf::RenderStates& states = sf::RenderStates::Default);
+
+ /**
+  * @brief Sets the view (camera) used by the following draws
+  * @param view View to apply
+  */
+ void
+  setView(const sf::View& view);
+
+ /**
+  * @brief Restores the default view, which maps one world unit to one pixel
+  */
+ void
+  resetView();
+
+ /**
+  * @brief Gets the size of the render target in pixels
+  * @return Window or framebuffer size
+  */
+ sf::Vector2u
+  getSize() const;
+
+ /**
+  * @brief Activates or deactivates the window's OpenGL context on the calling thread
+  * @param active True to make the context current, false to release it
+  * @return True on success
+  *
+  * @details
+  * Only one thread may own the context at a time; the render thread takes it
+  * while it runs and gives it back when stopped.
+  */
+ bool
+  setActive(bool active);
+
  /**
   * @brief Shows what was drawn
   */
@@ -82,8 +137,33 @@ public:
  void
   destroy();
 
+ /**
+  * @brief Asks the main loop to end, like the close event (the window is closed in @ref destroy).
+  */
+ void
+  requestClose() { m_closeRequested = true; }
+
+ /**
+  * @brief Gets the backend that receives the draw calls
+  * @return Backend pointer (null if the window failed to initialize)
+  */
+ RenderBackend*
+  getBackend() { return m_backend.get(); }
+
+ /**
+  * @brief Gets the type of backend the window was created with
+  */
+ RenderBackendType
+  getBackendType() const { return m_backendType; }
+
 private:
+ /** @brief Backend every draw call is forwarded to. */
+ EngineUtilities::TUniquePtr<RenderBackend> m_backend;
+ RenderBackendType m_backendType = SFML_WINDOW;
+ /** @brief Default view covering the whole target at the creation size. */
  sf::View m_view;
+ /** @brief Set by the close event; the window is closed later in @ref destroy. */
+ bool m_closeRequested = false;
 public:
 	EngineUtilities::TUniquePtr < sf::RenderWindow> m_windowPtr;
  sf::Time deltaTime;
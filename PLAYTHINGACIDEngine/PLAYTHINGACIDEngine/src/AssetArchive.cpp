@@ -0,0 +1,201 @@
+#include "AssetArchive.h"
+#include "Utilities/Compression.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+ constexpr uint32_t ARCHIVE_VERSION = 1;
+
+ static_assert(sizeof(AssetArchive::Header) == 40, "Header layout is part of the file format");
+ static_assert(sizeof(AssetArchive::Entry) == 40, "Entry layout is part of the file format");
+
+ //orden del indice: hash y, si colisionan, nombre
+ bool
+  entryLess(const AssetArchive::Entry& a, uint64_t hash) {
+  return a.hash < hash;
+ }
+
+ void
+  pad(std::ofstream& out, uint64_t alignment) {
+  static const char zeros[4096] = {};
+  uint64_t position = static_cast<uint64_t>(out.tellp());
+  uint64_t padding = (alignment - position % alignment) % alignment;
+  while (padding > 0) {
+   const uint64_t chunk = std::min<uint64_t>(padding, sizeof(zeros));
+   out.write(zeros, static_cast<std::streamsize>(chunk));
+   padding -= chunk;
+  }
+ }
+}
+
+bool
+AssetArchive::open(const std::string& fileName) {
+ close();
+ if (!m_file.open(fileName)) {
+  return false;
+ }
+
+ //solo se valida la cabecera: abrir no depende del numero de entradas
+ const uint8_t* base = m_file.getData();
+ const std::size_t size = m_file.getSize();
+ Header header;
+ if (size < sizeof(Header)) {
+  close();
+  return false;
+ }
+ std::memcpy(&header, base, sizeof(Header));
+ const uint64_t indexBytes = static_cast<uint64_t>(header.entryCount) * sizeof(Entry);
+ if (std::memcmp(header.magic, "PAK1", 4) != 0 || header.version != ARCHIVE_VERSION
+     || header.indexOffset % alignof(Entry) != 0
+     || header.indexOffset > size || indexBytes > size - header.indexOffset
+     || header.namesOffset > size || header.namesSize > size - header.namesOffset) {
+  close();
+  return false;
+ }
+
+ m_index = reinterpret_cast<const Entry*>(base + header.indexOffset);
+ m_names = reinterpret_cast<const char*>(base + header.namesOffset);
+ m_namesSize = static_cast<std::size_t>(header.namesSize);
+ m_entryCount = header.entryCount;
+ return true;
+}
+
+void
+AssetArchive::close() {
+ m_file.close();
+ m_index = nullptr;
+ m_names = nullptr;
+ m_namesSize = 0;
+ m_entryCount = 0;
+}
+
+const AssetArchive::Entry*
+AssetArchive::find(const std::string& name) const {
+ if (!isOpen()) {
+  return nullptr;
+ }
+ const std::string normalized = normalizeName(name);
+ const uint64_t hash = hashName(normalized);
+ const Entry* end = m_index + m_entryCount;
+ for (const Entry* it = std::lower_bound(m_index, end, hash, entryLess); it != end && it->hash == hash; ++it) {
+  //mismo hash: se confirma con el nombre
+  if (it->nameOffset < m_namesSize
+      && std::strncmp(m_names + it->nameOffset, normalized.c_str(), m_namesSize - it->nameOffset) == 0) {
+   return it;
+  }
+ }
+ return nullptr;
+}
+
+ByteSpan
+AssetArchive::getBytes(const Entry& entry, std::vector<uint8_t>& storage) const {
+ const std::size_t size = m_file.getSize();
+ if (!isOpen() || entry.offset > size || entry.storedSize > size - entry.offset) {
+  return ByteSpan();
+ }
+ const uint8_t* stored = m_file.getData() + entry.offset;
+ if ((entry.flags & FLAG_COMPRESSED) == 0) {
+  return ByteSpan{ stored, static_cast<std::size_t>(entry.storedSize) };
+ }
+
+ storage.resize(static_cast<std::size_t>(entry.size));
+ if (!Compression::decompress(stored, static_cast<std::size_t>(entry.storedSize),
+                              storage.data(), storage.size())) {
+  return ByteSpan();
+ }
+ return ByteSpan{ storage.data(), storage.size() };
+}
+
+uint64_t
+AssetArchive::hashName(const std::string& name) {
+ //mismo hash que StringId: el formato del archivo no cambia
+ return StringId::hash(name.data(), name.size());
+}
+
+std::string
+AssetArchive::normalizeName(const std::string& name) {
+ std::string normalized = name;
+ std::replace(normalized.begin(), normalized.end(), '\\', '/');
+ while (normalized.compare(0, 2, "./") == 0) {
+  normalized.erase(0, 2);
+ }
+ return normalized;
+}
+
+bool
+AssetArchive::build(const std::string& outputFile, const std::vector<BuildInput>& inputs,
+                    bool compress, uint32_t alignment) {
+ if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+  return false;
+ }
+ std::ofstream out(outputFile, std::ios::binary | std::ios::trunc);
+ if (!out) {
+  return false;
+ }
+
+ Header header = {};
+ std::memcpy(header.magic, "PAK1", 4);
+ header.version = ARCHIVE_VERSION;
+ header.alignment = alignment;
+ out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+ std::vector<Entry> index;
+ std::vector<std::string> names;
+ std::string nameTable;
+ std::vector<uint8_t> packed;
+ for (const BuildInput& input : inputs) {
+  std::ifstream in(input.sourceFile, std::ios::binary);
+  if (!in) {
+   return false;
+  }
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  Entry entry = {};
+  const std::string name = normalizeName(input.name);
+  entry.hash = hashName(name);
+  entry.size = bytes.size();
+  entry.nameOffset = static_cast<uint32_t>(nameTable.size());
+  nameTable += name;
+  nameTable.push_back('\0');
+
+  //si no se gana espacio se guarda tal cual (lectura sin copia)
+  const std::vector<uint8_t>* payload = &bytes;
+  if (compress && !bytes.empty()) {
+   Compression::compress(bytes.data(), bytes.size(), packed);
+   if (packed.size() < bytes.size()) {
+    payload = &packed;
+    entry.flags |= FLAG_COMPRESSED;
+   }
+  }
+
+  pad(out, alignment);
+  entry.offset = static_cast<uint64_t>(out.tellp());
+  entry.storedSize = payload->size();
+  out.write(reinterpret_cast<const char*>(payload->data()), static_cast<std::streamsize>(payload->size()));
+  index.push_back(entry);
+  names.push_back(name);
+ }
+
+ header.namesOffset = static_cast<uint64_t>(out.tellp());
+ header.namesSize = nameTable.size();
+ out.write(nameTable.data(), static_cast<std::streamsize>(nameTable.size()));
+
+ //indice ordenado para busqueda binaria
+ std::vector<std::size_t> order(index.size());
+ for (std::size_t i = 0; i < order.size(); ++i) {
+  order[i] = i;
+ }
+ std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+  return index[a].hash != index[b].hash ? index[a].hash < index[b].hash : names[a] < names[b];
+ });
+ pad(out, alignof(Entry));
+ header.indexOffset = static_cast<uint64_t>(out.tellp());
+ header.entryCount = static_cast<uint32_t>(index.size());
+ for (const std::size_t i : order) {
+  out.write(reinterpret_cast<const char*>(&index[i]), sizeof(Entry));
+ }
+
+ out.seekp(0);
+ out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+ return static_cast<bool>(out);
+}
@@ -3,36 +3,176 @@
 #include "ECS/Texture.h"
 #include "ResourceManager.h"
 #include "A_Racer.h"
+#include "Render/DebugDraw.h"
+#include "Utilities/StartupTracer.h"
+#include "Utilities/Profiler.h"
+#include "Utilities/MemoryTracker.h"
 #include <imgui.h>
+#include <chrono>
+#include <cstdlib>
 
 
 BaseApp::~BaseApp() {
 }
 
 int
-BaseApp::run() {
+BaseApp::run(int argc, char* argv[]) {
+ //--startup-trace[=archivo.json], --startup-summary, --capture-frames=N, --capture-file=archivo.json
+ //--frame-stats=archivo.csv (vacio: sin csv), --stress=N, --stress-ticks=T, --stress-seed=S, --headless
+ //--assert-no-alloc[=frames de calentamiento], --log-level=trace|debug|info|warning|error|off
+ //y --log-file=archivo.log (vacio: sin archivo)
+ for (int i = 1; i < argc; ++i) {
+  const std::string arg = argv[i];
+  if (arg == "--startup-trace") {
+   m_startupTraceFile = "startup_trace.json";
+  }
+  else if (arg.rfind("--startup-trace=", 0) == 0) {
+   m_startupTraceFile = arg.substr(16);
+  }
+  else if (arg == "--startup-summary") {
+   m_printStartupSummary = true;
+  }
+  else if (arg.rfind("--capture-frames=", 0) == 0) {
+   m_captureFrameCount = static_cast<uint32_t>(std::strtoul(arg.c_str() + 17, nullptr, 10));
+  }
+  else if (arg.rfind("--capture-file=", 0) == 0) {
+   m_captureFile = arg.substr(15);
+  }
+  else if (arg.rfind("--frame-stats=", 0) == 0) {
+   m_frameStatsFile = arg.substr(14);
+  }
+  else if (arg.rfind("--stress=", 0) == 0) {
+   m_stress.racers = static_cast<uint32_t>(std::strtoul(arg.c_str() + 9, nullptr, 10));
+  }
+  else if (arg.rfind("--stress-ticks=", 0) == 0) {
+   m_stress.ticks = static_cast<uint32_t>(std::strtoul(arg.c_str() + 15, nullptr, 10));
+  }
+  else if (arg.rfind("--stress-seed=", 0) == 0) {
+   m_stress.seed = static_cast<uint32_t>(std::strtoul(arg.c_str() + 14, nullptr, 10));
+  }
+  else if (arg == "--headless") {
+   m_stress.headless = true;
+  }
+  else if (arg == "--assert-no-alloc") {
+   m_assertNoAlloc = true;
+  }
+  else if (arg.rfind("--assert-no-alloc=", 0) == 0) {
+   m_assertNoAlloc = true;
+   m_assertNoAllocWarmup = static_cast<uint32_t>(std::strtoul(arg.c_str() + 18, nullptr, 10));
+  }
+  else if (arg.rfind("--log-level=", 0) == 0) {
+   if (!Logger::parseSeverity(arg.substr(12), m_logLevel)) {
+    LOG_WARNING("BaseApp", "Unknown log level {}", arg.substr(12));
+   }
+  }
+  else if (arg.rfind("--log-file=", 0) == 0) {
+   m_logFile = arg.substr(11);
+  }
+ }
+
+ Logger& logger = Logger::getInstance();
+ logger.setLevel(m_logLevel);
+ if (!m_logFile.empty() && !logger.setFile(m_logFile)) {
+  LOG_WARNING("BaseApp", "Can't open the log file {}", m_logFile);
+ }
+
+ //el bucle del frame corre en este hilo (tambien en headless)
+ MEMORY_FRAME_THREAD();
+
+ //el hilo del logger se para aqui y no en los destructores estaticos:
+ //el Profiler, que usa al registrar el hilo, se destruye antes que el Logger
+ if (m_stress.headless) {
+  if (m_stress.racers == 0) {
+   LOG_ERROR("BaseApp", "--headless needs --stress=N");
+   logger.shutdown();
+   return 1;
+  }
+  const int result = runHeadless();
+  logger.shutdown();
+  return result;
+ }
+
+ PROFILE_THREAD_NAME("Main thread");
+
  if (!init()) {
   ERROR("BaseApp",
 	    "run",
 		"Initializes result on a false statement, check method validations");
+  logger.shutdown();
+  return 1;
+ }
+
+ if (m_threadedRendering) {
+  STARTUP_SCOPE("Render thread start");
+  m_renderThread.start(m_windowPtr, &m_engineGUI);
  }
 
+ if (m_captureFrameCount > 0) {
+#if ENGINE_PROFILER
+  Profiler::getInstance().startCapture(m_captureFrameCount, m_captureFile);
+#else
+  LOG_WARNING("BaseApp", "--capture-frames needs ENGINE_PROFILER");
+#endif
+ }
+ if (!m_frameStatsFile.empty() && !m_frameStats.openCsv(m_frameStatsFile)) {
+  LOG_ERROR("BaseApp", "Can't write {}", m_frameStatsFile);
+ }
+ armAllocationAssert();
+
+ //en modo stress cada fase del frame es una fila del informe
+ int stressPhases[FRAME_STAT_COUNT] = {};
+ if (m_stressScene) {
+  stressPhases[FRAME_STAT_SIMULATION] = m_stressScene->addPhase("Simulation");
+  stressPhases[FRAME_STAT_GUI] = m_stressScene->addPhase("GUI");
+  stressPhases[FRAME_STAT_RENDER] = m_stressScene->addPhase("Render");
+  stressPhases[FRAME_STAT_FRAME] = m_stressScene->addPhase("Frame");
+ }
+ uint32_t stressTicks = 0;
+
  while (m_windowPtr->isOpen()) {
-  m_windowPtr->handleEvents(m_engineGUI);
+  m_frameStats.beginFrame();
   update();
+  m_frameStats.mark(FRAME_STAT_SIMULATION);
+  updateGUI();
+  m_frameStats.mark(FRAME_STAT_GUI);
   render();
+  m_frameStats.mark(FRAME_STAT_RENDER);
+  m_frameStats.endFrame();
+  PROFILE_END_FRAME();
+  MEMORY_END_FRAME();
+
+  if (m_stressScene) {
+   for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+    m_stressScene->addSample(stressPhases[c], m_frameStats.getLastMs(static_cast<FrameStatChannel>(c)));
+   }
+   if (++stressTicks >= m_stress.ticks) {
+    m_windowPtr->requestClose();
+   }
+  }
  }
 
+ if (m_stressScene) {
+  m_stressScene->printReport(std::cout, m_stressMemoryBefore, m_stressMemoryAfter);
+ }
  destroy();
  return 0;
 }
 
 bool
 BaseApp::init() {
+ STARTUP_SCOPE("BaseApp::init");
 
 	ResourceManager& resourceMan = ResourceManager::getInstance();
+ //si existe el paquete de assets se lee de ahi; si no, de los archivos sueltos
+ {
+  STARTUP_SCOPE("Mount archives");
+  resourceMan.mountArchive("Assets.pak");
+ }
 
- m_windowPtr = EngineUtilities::MakeShared<Window>(1920, 1080, "PLAYTHINGACIDEngine");
+ {
+  STARTUP_SCOPE("Window creation");
+  m_windowPtr = EngineUtilities::MakeShared<Window>(1920, 1080, "PLAYTHINGACIDEngine");
+ }
  if (!m_windowPtr) {
   ERROR("BaseApp",
 		"init",
@@ -41,11 +181,20 @@ BaseApp::init() {
  }
 
  //initialize imgui resource
- m_engineGUI.init(m_windowPtr);
+ {
+  STARTUP_SCOPE("ImGui init");
+  m_engineGUI.init(m_windowPtr);
+ }
+
+ //las texturas de los corredores se decodifican en segundo plano mientras carga la pista
+ resourceMan.loadTextureAsync("Sprites/BlueRegrowFortifiedCamo", "png");
+ resourceMan.loadTextureAsync("Sprites/WhiteCamo", "png");
+ resourceMan.loadTextureAsync("Sprites/DreadRockBloonEliteDS3", "png");
 
  //create track actor
  m_ATrack = EngineUtilities::MakeShared<Actor>("Track Actor");
  if (m_ATrack) {
+     STARTUP_SCOPE("Track actor");
      m_ATrack->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
      m_ATrack->getComponent<CShape>()->setFillColor(sf::Color::White);
      m_ATrack->getComponent<Transform>()->setPosition(sf::Vector2f(0.f, 0.f));
@@ -58,6 +207,16 @@ BaseApp::init() {
      }
      m_ATrack->setTexture(resourceMan.getTexture("Sprites/SpaPits"));
      //m_ACircle->setName("Circle Actor");
+
+     //la pista se dibuja como tilemap por chunks (mismo tamano que el rectangulo escalado)
+     auto trackMap = EngineUtilities::MakeShared<CTilemap>();
+     trackMap->createFromImage(resourceMan.getTexture("Sprites/SpaPits"),
+                               sf::Vector2u(64, 64),
+                               sf::Vector2f(1500.f, 969.f));
+     m_ATrack->addComponent(trackMap);
+
+     //aplica el transform para conocer los limites del mundo
+     m_ATrack->update(0.f);
  }
  else {
      ERROR("BaseApp",
@@ -68,6 +227,53 @@ BaseApp::init() {
 
 
  
+ if (m_stress.racers > 0) {
+  STARTUP_SCOPE("Stress scene");
+  createStressScene(m_ATrack->getComponent<CTilemap>()->getWorldBounds());
+ }
+ else {
+  STARTUP_SCOPE("Racer actors");
+  createDemoScene();
+ }
+
+ //camaras: la principal sigue al lider, la vista general muestra toda la pista
+ const sf::Vector2u targetSize = m_windowPtr->getSize();
+ const sf::FloatRect worldBounds = m_ATrack->getComponent<CTilemap>()->getWorldBounds();
+
+ Camera mainCamera("Main", targetSize);
+ mainCamera.setWorldBounds(worldBounds);
+ mainCamera.setFollowMode(CAMERA_FOLLOW_LEADER);
+ mainCamera.snapZoom(1.5f);
+ m_cameras.push_back(mainCamera);
+
+ Camera overview("Overview", targetSize);
+ overview.setViewport(sf::FloatRect({ 0.74f, 0.70f }, { 0.25f, 0.28f }));
+ overview.fitRect(worldBounds);
+ m_cameras.push_back(overview);
+
+ //la pista en alta resolucion se transmite por tiles; si falta la piramide la genera un worker
+ {
+  STARTUP_SCOPE("Virtual texture");
+  m_trackTexture.setWorldRect(worldBounds);
+  m_trackTexture.openOrBuild("Sprites/SpaPits.png", "Sprites/SpaPits.vtex");
+  m_renderThread.addVirtualTexture(&m_trackTexture);
+ }
+
+ {
+  STARTUP_SCOPE("Particles");
+  createEffects();
+ }
+ if (m_stressScene) {
+  m_stressMemoryAfter = StressScene::getProcessMemory();
+ }
+
+ return true;
+}
+
+void
+BaseApp::createDemoScene() {
+ ResourceManager& resourceMan = ResourceManager::getInstance();
+
  //los waypoints (no me gusta vivir)
  m_waypoints.push_back(sf::Vector2f(479.f, 350.f));
  m_waypoints.push_back(sf::Vector2f(650.f, 408.f));
@@ -91,7 +297,6 @@ BaseApp::init() {
  r1->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
  r1->getComponent<CShape>()->setFillColor(sf::Color::White);
  r1->getComponent<Transform>()->setScale(sf::Vector2f(.86f, .75f));
- if (!resourceMan.loadTexture("Sprites/BlueRegrowFortifiedCamo", "png")) { /* ... */ }
  r1->setTexture(resourceMan.getTexture("Sprites/BlueRegrowFortifiedCamo"));
 
  m_racers.push_back(r1);         // <-- necesitas declarar m_racers en BaseApp.h
@@ -103,7 +308,6 @@ BaseApp::init() {
  r2->getComponent<CShape>()->setFillColor(sf::Color::White);
  r2->getComponent<Transform>()->setScale(sf::Vector2f(.4f, .55f));
  r2->getComponent<Transform>()->setPosition(sf::Vector2f(1000.f, 100.f));
- if (!resourceMan.loadTexture("Sprites/WhiteCamo", "png")) { /* ... */ }
  r2->setTexture(resourceMan.getTexture("Sprites/WhiteCamo"));
 
  m_racers.push_back(r2);         // <-- necesitas declarar m_racers en BaseApp.h
@@ -114,7 +318,6 @@ BaseApp::init() {
  r3->getComponent<CShape>()->createShape(ShapeType::RECTANGLE);
  r3->getComponent<CShape>()->setFillColor(sf::Color::White);
  r3->getComponent<Transform>()->setScale(sf::Vector2f(.6f, .75f));
- if (!resourceMan.loadTexture("Sprites/DreadRockBloonEliteDS3", "png")) { /* ... */ }
  r3->setTexture(resourceMan.getTexture("Sprites/DreadRockBloonEliteDS3"));
 
  m_racers.push_back(r3);         // <-- necesitas declarar m_racers en BaseApp.h
@@ -122,6 +325,11 @@ BaseApp::init() {
 
  for (auto& r : m_racers) r->setWaypoints(m_waypoints);
 
+ //grupo en el outliner; va al final para que CPU_1 siga siendo la seleccion inicial
+ auto racersGroup = EngineUtilities::MakeShared<Actor>("Racers");
+ for (auto& r : m_racers) r->setParent(racersGroup.get());
+ m_actors.push_back(racersGroup);
+
  // parrilla 2x2 de ejemplo
  float rowGap = 100.f;   // distancia hacia atrs entre filas
  float laneGap = 40.f;  // separacin lateral entre carriles
@@ -134,53 +342,484 @@ BaseApp::init() {
  if (m_racers.size() > 2) m_racers[2]->spawnRelative(0, rowGap, -laneGap);
  // r4: fila 1 carril +1
  if (m_racers.size() > 3) m_racers[3]->spawnRelative(0, rowGap, +laneGap);
+}
 
- return true;
+void
+BaseApp::createStressScene(const sf::FloatRect& area) {
+ m_stressScene = EngineUtilities::MakeShared<StressScene>(m_stress);
+ m_stressMemoryBefore = StressScene::getProcessMemory();
+
+ //con ventana se reparten las libreas de la demo; headless solo color
+ std::vector<EngineUtilities::TSharedPointer<Texture>> liveries;
+ if (!m_stress.headless) {
+  ResourceManager& resourceMan = ResourceManager::getInstance();
+  liveries.push_back(resourceMan.getTexture("Sprites/BlueRegrowFortifiedCamo"));
+  liveries.push_back(resourceMan.getTexture("Sprites/WhiteCamo"));
+  liveries.push_back(resourceMan.getTexture("Sprites/DreadRockBloonEliteDS3"));
+ }
+
+ m_waypoints = m_stressScene->generateTrack(area);
+ m_racers = m_stressScene->spawnRacers(m_waypoints, liveries);
+
+ //el outliner es virtual: todos los corredores cuelgan de un grupo (cerrado por defecto)
+ if (!m_stress.headless) {
+  auto racersGroup = EngineUtilities::MakeShared<Actor>("Stress racers");
+  m_actors.reserve(m_racers.size() + 1);
+  m_actors.push_back(racersGroup);
+  for (auto& r : m_racers) {
+   r->setParent(racersGroup.get());
+   m_actors.push_back(r);
+  }
+ }
+}
+
+void
+BaseApp::createEffects() {
+ //efectos: humo de llantas y chispas detras de cada corredor
+ const int smokeLayer = m_particles.createLayer("Tire smoke", 200000);
+ const int sparkLayer = m_particles.createLayer("Sparks", 50000);
+
+ ParticleEmitterDesc smoke;
+ smoke.rate = 90.f;
+ smoke.lifetimeMin = 0.6f;
+ smoke.lifetimeMax = 1.4f;
+ smoke.speedMin = 10.f;
+ smoke.speedMax = 40.f;
+ smoke.spread = 50.f;
+ smoke.emitBackwards = true;
+ smoke.drag = 1.5f;
+ smoke.sizeStart = 6.f;
+ smoke.sizeEnd = 26.f;
+ smoke.colorStart = sf::Color(190, 190, 190, 140);
+ smoke.colorEnd = sf::Color(120, 120, 120, 0);
+
+ ParticleEmitterDesc sparks;
+ sparks.rate = 25.f;
+ sparks.lifetimeMin = 0.15f;
+ sparks.lifetimeMax = 0.35f;
+ sparks.speedMin = 120.f;
+ sparks.speedMax = 260.f;
+ sparks.spread = 70.f;
+ sparks.emitBackwards = true;
+ sparks.drag = 3.f;
+ sparks.sizeStart = 2.f;
+ sparks.sizeEnd = 1.f;
+ sparks.stretch = 0.03f;
+ sparks.colorStart = sf::Color(255, 220, 120, 255);
+ sparks.colorEnd = sf::Color(255, 90, 20, 0);
+
+ for (auto& r : m_racers) {
+  m_particles.attachEmitter(m_particles.createEmitter(smokeLayer, smoke), r);
+  m_particles.attachEmitter(m_particles.createEmitter(sparkLayer, sparks), r);
+ }
+}
+
+int
+BaseApp::runHeadless() {
+ using Clock = std::chrono::steady_clock;
+
+ //mismo mundo que la pista de la demo, sin ventana ni texturas
+ createStressScene(sf::FloatRect({ 0.f, 0.f }, { 1500.f, 969.f }));
+ createEffects();
+ m_stressMemoryAfter = StressScene::getProcessMemory();
+
+ StressScene& scene = *m_stressScene;
+ const int racersPhase = scene.addPhase("Racers");
+ const int rankingPhase = scene.addPhase("Ranking");
+ const int particlesPhase = scene.addPhase("Particles");
+ const int recordPhase = scene.addPhase("Record");
+ armAllocationAssert();
+
+ Clock::time_point last;
+ auto lap = [&last]() {
+  const Clock::time_point now = Clock::now();
+  const double ms = std::chrono::duration<double, std::milli>(now - last).count();
+  last = now;
+  return ms;
+ };
+
+ for (uint32_t tick = 0; tick < m_stress.ticks; ++tick) {
+  last = Clock::now();
+  for (auto& r : m_racers) {
+   r->update(StressScene::TICK);
+  }
+  scene.addSample(racersPhase, lap());
+
+  A_Racer::updatePlaces(m_racers, m_placeScratch);
+  scene.addSample(rankingPhase, lap());
+
+  m_particles.update(StressScene::TICK);
+  scene.addSample(particlesPhase, lap());
+
+  //grabar la escena completa mide el coste de CPU del render sin tocar la GPU
+  m_frameCommands.clear();
+  recordScene(m_frameCommands, nullptr);
+  scene.addSample(recordPhase, lap());
+  MEMORY_END_FRAME();
+ }
+
+ scene.printReport(std::cout, m_stressMemoryBefore, m_stressMemoryAfter);
+ return 0;
+}
+
+void
+BaseApp::armAllocationAssert() {
+ if (!m_assertNoAlloc) {
+  return;
+ }
+#if ENGINE_MEMORY_TRACKING
+ MemoryTracker::getInstance().setSteadyStateAssert(m_assertNoAllocWarmup);
+#else
+ LOG_WARNING("BaseApp", "--assert-no-alloc needs ENGINE_MEMORY_TRACKING");
+#endif
 }
 
 void BaseApp::update() {
+    PROFILE_SCOPE("Update");
+#if ENGINE_DEBUG_DRAW
+    //las primitivas de debug viven un frame
+    DebugDraw::getInstance().clear();
+#endif
+
     if (!m_windowPtr.isNull()) {
         m_windowPtr->update();
     }
 
+    //suelta las cargas de texturas que ya terminaron
+    ResourceManager::getInstance().update();
+    PROFILE_COUNTER("Pending textures", ResourceManager::getInstance().getPendingTextureCount());
+
+    //el arranque termina cuando ya no quedan texturas cargandose
+    StartupTracer& startup = StartupTracer::getInstance();
+    if (startup.isRecording() && ResourceManager::getInstance().getPendingTextureCount() == 0) {
+        startup.finish(m_startupTraceFile, m_printStartupSummary);
+    }
+
+    if (!m_ATrack.isNull())
+        m_ATrack->update(m_windowPtr->deltaTime.asSeconds());
+
+    //en modo stress el paso es fijo para que las corridas sean comparables
+    const float dt = m_stressScene ? StressScene::TICK : m_windowPtr->deltaTime.asSeconds();
+    {
+        PROFILE_SCOPE("Racers");
+        for (auto& r : m_racers)
+            r->update(dt);
+    }
+
+    // leaderboard
+    {
+        PROFILE_SCOPE("Ranking");
+        A_Racer::updatePlaces(m_racers, m_placeScratch);
+    }
+
+    updatePickIndex();
+
+    {
+        PROFILE_SCOPE("Particles");
+        m_particles.update(dt);
+        PROFILE_COUNTER("Live particles", m_particles.getLiveCount());
+    }
+    {
+        PROFILE_SCOPE("Cameras");
+        updateCameras(dt);
+    }
+    {
+        PROFILE_SCOPE("Virtual texture");
+        m_trackTexture.update(m_cameras);
+    }
+
+    //debug: recorrido, indices de waypoint y bounds de los corredores
+    for (size_t i = 0; i < m_waypoints.size(); ++i) {
+        DEBUG_LINE(m_waypoints[i], m_waypoints[(i + 1) % m_waypoints.size()], sf::Color::Cyan);
+        DEBUG_TEXT(m_waypoints[i], std::to_string(i), sf::Color::Cyan);
+    }
+    if (!m_stressScene) {
+        for (auto& r : m_racers)
+            DEBUG_RECT(r->getComponent<CShape>()->getGlobalBounds(), sf::Color::Magenta);
+    }
+}
+
+void
+BaseApp::updateCameras(float deltaTime) {
+ EngineUtilities::TSharedPointer<CShape> leaderShape;
+ for (auto& r : m_racers) {
+  if (r->getPlace() == 1) {
+   leaderShape = r->getComponent<CShape>();
+   break;
+  }
+ }
+
+ EngineUtilities::TSharedPointer<CShape> selectedShape;
+ const int selected = m_engineGUI.getSelectedActorIndex();
+ if (selected >= 0 && selected < (int)m_actors.size() && m_actors[selected]) {
+  selectedShape = m_actors[selected]->getComponent<CShape>();
+ }
+
+ for (Camera& camera : m_cameras) {
+  EngineUtilities::TSharedPointer<CShape> target;
+  if (camera.getFollowMode() == CAMERA_FOLLOW_LEADER) {
+   target = leaderShape;
+  }
+  else if (camera.getFollowMode() == CAMERA_FOLLOW_SELECTED) {
+   target = selectedShape;
+  }
+
+  if (target) {
+   const sf::FloatRect bounds = target->getGlobalBounds();
+   camera.setTarget(bounds.position + bounds.size * 0.5f);
+  }
+  camera.update(deltaTime);
+ }
+}
+
+void
+BaseApp::updatePickIndex() {
+ PROFILE_SCOPE("Pick index");
+ //lista nueva: el indice se rehace, los shapes se cachean y cada actor recibe su id
+ //(la misma senal que el outliner: buffer, tamano y version de actores)
+ if (m_actors.data() != m_pickSource || m_pickShapes.size() != m_actors.size()
+     || Actor::getHierarchyVersion() != m_pickVersion) {
+  m_pickSource = m_actors.data();
+  m_pickVersion = Actor::getHierarchyVersion();
+  m_pickGrid.clear();
+  m_pickShapes.assign(m_actors.size(), nullptr);
+  for (size_t i = 0; i < m_actors.size(); ++i) {
+   if (!m_actors[i]) continue;
+   m_pickShapes[i] = m_actors[i]->getComponent<CShape>().get();
+   m_actors[i]->setBoundsId(m_pickShapes[i] != nullptr ? static_cast<int>(i) : -1);
+   if (m_pickShapes[i] != nullptr) {
+    m_pickGrid.update(static_cast<int>(i), m_pickShapes[i]->getGlobalBounds());
+   }
+  }
+  //lo que se movio antes de la reconstruccion ya esta en la rejilla
+  Actor::takeDirtyBounds(m_pickDirty);
+  m_pickDirty.clear();
+  m_pickMoved.clear();
+  m_pickMoved.reserve(m_actors.size());
+  m_pickQueued.assign(m_actors.size(), 0);
+ }
+
+ //los actores que Actor::update marco se encolan una vez (sin recorrer m_actors);
+ //la rejilla solo se toca al consultarla: mover por celdas nuevas reserva memoria
+ Actor::takeDirtyBounds(m_pickDirty);
+ for (int id : m_pickDirty) {
+  if (id < static_cast<int>(m_pickShapes.size()) && m_pickShapes[id] != nullptr && !m_pickQueued[id]) {
+   m_pickQueued[id] = 1;
+   m_pickMoved.push_back(id);
+  }
+ }
+ PROFILE_COUNTER("Pick updates", m_pickDirty.size());
+
+ //seleccion en amarillo (con tope para no llenar el debug draw)
+ const std::vector<int>& selection = m_engineGUI.getSelection();
+ for (size_t s = 0; s < selection.size() && s < 256; ++s) {
+  const int index = selection[s];
+  if (index < static_cast<int>(m_pickShapes.size()) && m_pickShapes[index] != nullptr) {
+   DEBUG_RECT(m_pickShapes[index]->getGlobalBounds(), sf::Color::Yellow);
+  }
+ }
+}
+
+void
+BaseApp::syncPickGrid() {
+ PROFILE_SCOPE("Pick sync");
+ for (int id : m_pickMoved) {
+  m_pickGrid.update(id, m_pickShapes[id]->getGlobalBounds());
+  m_pickQueued[id] = 0;
+ }
+ m_pickMoved.clear();
+}
+
+void
+BaseApp::updatePicking() {
+ ImGuiIO& io = ImGui::GetIO();
+ const sf::Vector2f mouse = { io.MousePos.x, io.MousePos.y };
+
+ //el clic cuenta si empieza fuera de los paneles; manda la camara de arriba
+ if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !io.WantCaptureMouse) {
+  m_pickCamera = -1;
+  for (int c = static_cast<int>(m_cameras.size()) - 1; c >= 0; --c) {
+   if (m_cameras[c].isEnabled() && m_cameras[c].containsScreenPoint(mouse)) {
+    m_pickCamera = c;
+    break;
+   }
+  }
+  m_pickStart = mouse;
+ }
+ if (m_pickCamera < 0 || m_pickCamera >= static_cast<int>(m_cameras.size())) {
+  return;
+ }
+
+ const sf::Vector2f drag = mouse - m_pickStart;
+ const bool box = std::abs(drag.x) > 4.f || std::abs(drag.y) > 4.f;
+ if (ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
+  if (box) {
+   const ImVec2 from(std::min(m_pickStart.x, mouse.x), std::min(m_pickStart.y, mouse.y));
+   const ImVec2 to(std::max(m_pickStart.x, mouse.x), std::max(m_pickStart.y, mouse.y));
+   ImDrawList* drawList = ImGui::GetForegroundDrawList();
+   drawList->AddRectFilled(from, to, IM_COL32(80, 140, 255, 40));
+   drawList->AddRect(from, to, IM_COL32(80, 140, 255, 200));
+  }
+  return;
+ }
+
+ //boton soltado: la rejilla da candidatos y el contorno del shape decide
+ PROFILE_SCOPE("Pick");
+ const Camera& camera = m_cameras[m_pickCamera];
+ m_pickCamera = -1;
+ syncPickGrid();
+ m_pickCandidates.clear();
+ m_pickResult.clear();
+ if (!box) {
+  const sf::Vector2f world = camera.screenToWorld(mouse);
+  m_pickGrid.queryPoint(world, m_pickCandidates);
+  //el de mas arriba es el ultimo que se dibuja
+  int hit = -1;
+  for (int id : m_pickCandidates) {
+   if (id > hit && m_pickShapes[id]->containsPoint(world)) hit = id;
+  }
+  if (hit >= 0) m_pickResult.push_back(hit);
+ }
+ else {
+  const sf::Vector2f a = camera.screenToWorld(m_pickStart);
+  const sf::Vector2f b = camera.screenToWorld(mouse);
+  const sf::FloatRect rect({ std::min(a.x, b.x), std::min(a.y, b.y) }, { std::abs(b.x - a.x), std::abs(b.y - a.y) });
+  m_pickGrid.queryRect(rect, m_pickCandidates);
+  std::sort(m_pickCandidates.begin(), m_pickCandidates.end());
+  for (int id : m_pickCandidates) {
+   if (m_pickShapes[id]->intersectsRect(rect)) m_pickResult.push_back(id);
+  }
+ }
+
+ const bool additive = io.KeyShift || io.KeyCtrl;
+ if (!m_pickResult.empty() || !additive) {
+  m_engineGUI.selectActors(m_pickResult, additive);
+ }
+ LOG_DEBUG("BaseApp", "Picked {} of {} candidates", m_pickResult.size(), m_pickCandidates.size());
+}
+
+void
+BaseApp::updateGUI() {
+ PROFILE_SCOPE("GUI");
+ //ImGui es global: el frame anterior tiene que estar dibujado antes de tocarlo
+ if (m_renderThread.isRunning()) {
+  m_renderThread.waitForGuiIdle();
+ }
+
+ m_windowPtr->handleEvents(m_engineGUI);
+
 	//update ImGui
 	m_engineGUI.update(m_windowPtr, m_windowPtr->deltaTime);
+	updatePicking();
 	m_engineGUI.outliner(m_actors);
     m_engineGUI.inspector(m_actors);
     m_engineGUI.leaderboard(m_racers);
+    m_engineGUI.cameras(m_cameras);
+    m_engineGUI.frameStats(m_frameStats);
 
-    ImGui::ShowDemoWindow();
+#if ENGINE_DEBUG_DRAW
+    //etiquetas de debug proyectadas con la camara principal
+    if (!m_cameras.empty()) {
+        DebugDraw::getInstance().drawText(m_cameras[0]);
+    }
+#endif
 
-    if (!m_ATrack.isNull())
-        m_ATrack->update(m_windowPtr->deltaTime.asSeconds());
+    ImGui::ShowDemoWindow();
+}
 
-    const float dt = m_windowPtr->deltaTime.asSeconds();
-    for (auto& r : m_racers)
-        r->update(dt);
+void
+BaseApp::recordFrame(DrawCommandList& commandList) {
+ bool anyCamera = false;
+ for (const Camera& camera : m_cameras) {
+  if (!camera.isEnabled()) {
+   continue;
+  }
+  commandList.setView(camera.getView());
+  recordScene(commandList, &camera);
+  anyCamera = true;
+ }
 
-   // leaderboard
-   struct Node { float prog; EngineUtilities::TSharedPointer<A_Racer> r; };
-   std::vector<Node> nodes; nodes.reserve(m_racers.size());
-   for (auto& r : m_racers) nodes.push_back({ r->getProgressMeters(), r });
-    std::sort(nodes.begin(), nodes.end(), [](auto& a, auto& b){ return a.prog > b.prog; });
-     for (int i=0;i<(int)nodes.size();++i) nodes[i].r->setPlace(i+1);
+ //sin camaras activas se dibuja todo con la vista por defecto
+ if (!anyCamera) {
+  recordScene(commandList, nullptr);
+ }
 }
 
+void
+BaseApp::recordScene(DrawCommandList& commandList, const Camera* camera) {
+ //culling contra el rectangulo visible y LOD: lo que mide menos de un pixel no se dibuja
+ auto visible = [camera](const CShape& shape) {
+  if (camera == nullptr) {
+   return true;
+  }
+  const sf::FloatRect bounds = shape.getGlobalBounds();
+  const float pixels = std::max(bounds.size.x, bounds.size.y) * camera->getPixelsPerUnit();
+  return pixels >= 1.f && camera->isVisible(bounds);
+ };
+
+ if (m_trackTexture.isOpen() && camera != nullptr) {
+  //tiles residentes de la piramide, un solo batch con el atlas
+  m_trackTexture.record(commandList, *camera);
+ }
+ else if (!m_ATrack.isNull()) {
+  //solo los chunks de la pista que ve la camara
+  auto trackMap = m_ATrack->getComponent<CTilemap>();
+  auto trackShape = m_ATrack->getComponent<CShape>();
+  if (trackMap) {
+   trackMap->record(commandList, camera != nullptr ? &camera->getVisibleRect() : nullptr);
+  }
+  else if (trackShape && visible(*trackShape)) {
+   trackShape->record(commandList);
+  }
+ }
+
+ //particulas debajo de los corredores, un batch por capa
+ m_particles.record(commandList, camera != nullptr ? &camera->getVisibleRect() : nullptr);
+
+ for (auto& r : m_racers) {
+  auto shape = r->getComponent<CShape>();
+  if (shape && visible(*shape)) {
+   shape->record(commandList);
+  }
+ }
+
+#if ENGINE_DEBUG_DRAW
+ //todas las lineas de debug en un solo batch
+ DebugDraw::getInstance().record(commandList);
+#endif
+}
 
 void
 BaseApp::render() {
+ PROFILE_SCOPE("Render");
  if (!m_windowPtr) {
   return;
  }
 
- m_windowPtr->clear();
+ if (m_renderThread.isRunning()) {
+  DrawCommandList& frame = m_renderThread.beginFrame();
+  {
+   PROFILE_SCOPE("Record frame");
+   recordFrame(frame);
+  }
+  frame.setGuiPass(true);
+  m_renderThread.submit();
+  return;
+ }
 
- if (!m_ATrack.isNull()) {
-     m_ATrack->getComponent<CShape>()->render(m_windowPtr);
+ //sin render thread: misma lista, ejecutada en este hilo
+ m_frameCommands.clear();
+ {
+  PROFILE_SCOPE("Record frame");
+  recordFrame(m_frameCommands);
  }
 
- for (auto& r : m_racers)
-     r->getComponent<CShape>()->render(m_windowPtr);
+ //sin render thread las texturas pendientes se suben aqui
+ ResourceManager::getInstance().processUploads(sf::milliseconds(2));
+ m_trackTexture.processUploads();
+
+ m_windowPtr->clear(m_frameCommands.getClearColor());
+ m_frameCommands.execute(*m_windowPtr);
 
  m_windowPtr->render();
 
@@ -192,8 +831,29 @@ BaseApp::render() {
 
 void
 BaseApp::destroy() {
+ //el render thread devuelve el contexto GL a este hilo
+ m_renderThread.stop();
+
+ //estadisticas de frames de la sesion
+ if (m_frameStats.getFrameCount() > 0) {
+  m_frameStats.printSummary(std::cout);
+ }
+ if (m_frameStats.isCsvOpen()) {
+  if (m_frameStats.closeCsv()) {
+   LOG_INFO("BaseApp", "Frame stats written to {}", m_frameStatsFile);
+  }
+  else {
+   LOG_ERROR("BaseApp", "Can't write {}", m_frameStatsFile);
+  }
+ }
+
 	//destroy ImGui resources
 	m_engineGUI.destroy();
 
- //m_window->destroy();
+ if (!m_windowPtr.isNull()) {
+  m_windowPtr->destroy();
+ }
+
+ //lo que quede en los rings del logger sale y el hilo se para antes de los destructores estaticos
+ Logger::getInstance().shutdown();
 }
\ No newline at end of file
@@ -1,10 +1,45 @@
 #include "CShape.h"
 #include "Window.h"
 #include "ECS\Texture.h"
+#include "Render\DrawCommandList.h"
+#include <algorithm>
+
+namespace {
+ //Liang-Barsky: true si el segmento a-b toca el rectangulo
+ bool
+ segmentTouchesRect(const sf::Vector2f& a, const sf::Vector2f& b, const sf::FloatRect& rect) {
+  const sf::Vector2f d = b - a;
+  const float p[4] = { -d.x, d.x, -d.y, d.y };
+  const float q[4] = { a.x - rect.position.x, rect.position.x + rect.size.x - a.x,
+                       a.y - rect.position.y, rect.position.y + rect.size.y - a.y };
+  float enter = 0.f;
+  float exit = 1.f;
+  for (int i = 0; i < 4; ++i) {
+   if (p[i] == 0.f) {
+    if (q[i] < 0.f) {
+     return false;
+    }
+    continue;
+   }
+   const float t = q[i] / p[i];
+   if (p[i] < 0.f) {
+    enter = std::max(enter, t);
+   }
+   else {
+    exit = std::min(exit, t);
+   }
+   if (enter > exit) {
+    return false;
+   }
+  }
+  return true;
+ }
+}
 
 void
 CShape::createShape(ShapeType type) {
  m_shapeType = type;
+ ++m_shapeRevision;
  switch (type) {
   case ShapeType::CIRCLE: {
    auto circleSP = EngineUtilities::MakeShared<sf::CircleShape>(100.f);
@@ -51,6 +86,11 @@ void
 
 void
  CShape::update(float deltaTime){
+ //una textura cargada en segundo plano cambia de tamano al terminar
+ if (m_texture && m_shapePtr && m_texture->getRevision() != m_textureRevision) {
+  m_textureRevision = m_texture->getRevision();
+  m_shapePtr->setTexture(&m_texture->getTexture(), true);
+ }
  }
 
 void
@@ -60,6 +100,61 @@ void
  }
  }
 
+void
+ CShape::record(DrawCommandList& commandList) const {
+ if (m_shapePtr) {
+  commandList.addShape(*m_shapePtr, m_texture ? m_texture->getBlendMode() : sf::BlendAlpha);
+ }
+ }
+
+sf::FloatRect
+ CShape::getGlobalBounds() const {
+ if (m_shapePtr) {
+  return m_shapePtr->getGlobalBounds();
+ }
+ return sf::FloatRect();
+ }
+
+bool
+ CShape::containsPoint(const sf::Vector2f& point) const {
+ if (!m_shapePtr || m_shapePtr->getPointCount() < 3 || !m_shapePtr->getGlobalBounds().contains(point)) {
+  return false;
+ }
+ //par-impar contra el contorno transformado (el mismo que se dibuja)
+ const sf::Transform& transform = m_shapePtr->getTransform();
+ const std::size_t count = m_shapePtr->getPointCount();
+ sf::Vector2f previous = transform.transformPoint(m_shapePtr->getPoint(count - 1));
+ bool inside = false;
+ for (std::size_t i = 0; i < count; ++i) {
+  const sf::Vector2f current = transform.transformPoint(m_shapePtr->getPoint(i));
+  if ((current.y > point.y) != (previous.y > point.y)
+      && point.x < (previous.x - current.x) * (point.y - current.y) / (previous.y - current.y) + current.x) {
+   inside = !inside;
+  }
+  previous = current;
+ }
+ return inside;
+ }
+
+bool
+ CShape::intersectsRect(const sf::FloatRect& rect) const {
+ if (!m_shapePtr || m_shapePtr->getPointCount() < 3 || !m_shapePtr->getGlobalBounds().findIntersection(rect)) {
+  return false;
+ }
+ //algun lado toca el rectangulo, o el rectangulo queda dentro del contorno
+ const sf::Transform& transform = m_shapePtr->getTransform();
+ const std::size_t count = m_shapePtr->getPointCount();
+ sf::Vector2f previous = transform.transformPoint(m_shapePtr->getPoint(count - 1));
+ for (std::size_t i = 0; i < count; ++i) {
+  const sf::Vector2f current = transform.transformPoint(m_shapePtr->getPoint(i));
+  if (segmentTouchesRect(previous, current, rect)) {
+   return true;
+  }
+  previous = current;
+ }
+ return containsPoint(rect.position);
+ }
+
 void 
  CShape::destroy() {
 }
@@ -101,6 +196,8 @@ void
 void
  CShape::setTexture(const EngineUtilities::TSharedPointer<Texture>& texture) {
  if (!texture.isNull()) {
+        m_texture = texture;
+        m_textureRevision = texture->getRevision();
         m_shapePtr->setTexture(&texture->getTexture());
  }
 }
\ No newline at end of file
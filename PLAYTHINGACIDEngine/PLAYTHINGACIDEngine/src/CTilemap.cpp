@@ -0,0 +1,247 @@
+#include "CTilemap.h"
+#include "Window.h"
+#include "Render\DrawCommandList.h"
+#include <algorithm>
+#include <cmath>
+
+void
+CTilemap::create(unsigned int width, unsigned int height, const sf::Vector2f& tileSize, unsigned int chunkSize) {
+ if (width == 0 || height == 0 || chunkSize == 0) {
+  ERROR("CTilemap", "create", "Tilemap dimensions must be greater than zero");
+  return;
+ }
+ m_width = width;
+ m_height = height;
+ m_tileSize = tileSize;
+ m_chunkSize = chunkSize;
+ m_chunksX = (width + chunkSize - 1) / chunkSize;
+ m_chunksY = (height + chunkSize - 1) / chunkSize;
+ m_tiles.assign(static_cast<std::size_t>(width) * height, EMPTY_TILE);
+ m_chunks.clear();
+ m_chunks.resize(static_cast<std::size_t>(m_chunksX) * m_chunksY);
+ m_residentChunks = 0;
+}
+
+void
+CTilemap::setTileset(const EngineUtilities::TSharedPointer<Texture>& texture, const sf::Vector2u& tilePixels) {
+ if (texture.isNull() || tilePixels.x == 0 || tilePixels.y == 0) {
+  ERROR("CTilemap", "setTileset", "Invalid tileset");
+  return;
+ }
+ m_tileset = texture;
+ m_tilePixels = tilePixels;
+ m_tilesetColumns = std::max(1u, (texture->getTexture().getSize().x + tilePixels.x - 1) / tilePixels.x);
+ for (Chunk& chunk : m_chunks) {
+  chunk.dirty = true;
+ }
+}
+
+void
+CTilemap::createFromImage(const EngineUtilities::TSharedPointer<Texture>& texture,
+                          const sf::Vector2u& tilePixels,
+                          const sf::Vector2f& worldSize,
+                          unsigned int chunkSize) {
+ if (texture.isNull() || tilePixels.x == 0 || tilePixels.y == 0) {
+  ERROR("CTilemap", "createFromImage", "Invalid image");
+  return;
+ }
+ const sf::Vector2u imageSize = texture->getTexture().getSize();
+ const unsigned int columns = (imageSize.x + tilePixels.x - 1) / tilePixels.x;
+ const unsigned int rows = (imageSize.y + tilePixels.y - 1) / tilePixels.y;
+
+ //tamano en mundo de una celda completa
+ const sf::Vector2f tileSize(worldSize.x * tilePixels.x / imageSize.x,
+                             worldSize.y * tilePixels.y / imageSize.y);
+ create(columns, rows, tileSize, chunkSize);
+ setTileset(texture, tilePixels);
+ for (unsigned int y = 0; y < rows; ++y) {
+  for (unsigned int x = 0; x < columns; ++x) {
+   m_tiles[static_cast<std::size_t>(y) * columns + x] = static_cast<uint16_t>(y * columns + x);
+  }
+ }
+}
+
+void
+CTilemap::update(float /*deltaTime*/) {
+ ++m_frame;
+ if (m_evictionFrames == 0) {
+  return;
+ }
+ //liberar chunks que llevan tiempo fuera de camara
+ for (Chunk& chunk : m_chunks) {
+  if (!chunk.vertices.empty() && chunk.lastVisibleFrame + m_evictionFrames < m_frame) {
+   std::vector<sf::Vertex>().swap(chunk.vertices);
+   chunk.dirty = true;
+   --m_residentChunks;
+  }
+ }
+}
+
+void
+CTilemap::render(const EngineUtilities::TSharedPointer<Window>& window) {
+ if (window.isNull()) {
+  return;
+ }
+ sf::RenderStates states;
+ states.texture = m_tileset ? &m_tileset->getTexture() : nullptr;
+ for (unsigned int cy = 0; cy < m_chunksY; ++cy) {
+  for (unsigned int cx = 0; cx < m_chunksX; ++cx) {
+   const Chunk& chunk = touchChunk(cx, cy);
+   if (!chunk.vertices.empty()) {
+    window->draw(chunk.vertices.data(), chunk.vertices.size(), sf::PrimitiveType::Triangles, states);
+   }
+  }
+ }
+}
+
+void
+CTilemap::record(DrawCommandList& commandList, const sf::FloatRect* visibleRect) {
+ m_visibleChunks = 0;
+ if (m_chunks.empty()) {
+  return;
+ }
+
+ //rango de chunks que tocan el rectangulo visible, sin recorrer todo el mapa
+ unsigned int x0 = 0, y0 = 0, x1 = m_chunksX, y1 = m_chunksY;
+ if (visibleRect != nullptr) {
+  const sf::Vector2f chunkWorld(m_tileSize.x * m_chunkSize, m_tileSize.y * m_chunkSize);
+  const float left = (visibleRect->position.x - m_origin.x) / chunkWorld.x;
+  const float top = (visibleRect->position.y - m_origin.y) / chunkWorld.y;
+  const float right = (visibleRect->position.x + visibleRect->size.x - m_origin.x) / chunkWorld.x;
+  const float bottom = (visibleRect->position.y + visibleRect->size.y - m_origin.y) / chunkWorld.y;
+  if (right < 0.f || bottom < 0.f || left >= m_chunksX || top >= m_chunksY) {
+   return;
+  }
+  x0 = static_cast<unsigned int>(std::max(0.f, std::floor(left)));
+  y0 = static_cast<unsigned int>(std::max(0.f, std::floor(top)));
+  x1 = std::min(m_chunksX, static_cast<unsigned int>(std::floor(right)) + 1);
+  y1 = std::min(m_chunksY, static_cast<unsigned int>(std::floor(bottom)) + 1);
+ }
+
+ const sf::Texture* texture = m_tileset ? &m_tileset->getTexture() : nullptr;
+ const sf::BlendMode blendMode = m_tileset ? m_tileset->getBlendMode() : sf::BlendAlpha;
+ for (unsigned int cy = y0; cy < y1; ++cy) {
+  for (unsigned int cx = x0; cx < x1; ++cx) {
+   Chunk& chunk = touchChunk(cx, cy);
+   chunk.lastVisibleFrame = m_frame;
+   if (!chunk.vertices.empty()) {
+    //misma textura y triangulos: todos los chunks terminan en un batch
+    commandList.addVertices(chunk.vertices.data(), chunk.vertices.size(),
+                            sf::PrimitiveType::Triangles, texture, blendMode);
+    ++m_visibleChunks;
+   }
+  }
+ }
+}
+
+void
+CTilemap::destroy() {
+ m_tiles.clear();
+ m_chunks.clear();
+ m_tileset.reset();
+ m_width = m_height = m_chunksX = m_chunksY = 0;
+ m_residentChunks = 0;
+}
+
+void
+CTilemap::setTile(unsigned int x, unsigned int y, uint16_t tile) {
+ if (x >= m_width || y >= m_height) {
+  return;
+ }
+ uint16_t& cell = m_tiles[static_cast<std::size_t>(y) * m_width + x];
+ if (cell != tile) {
+  cell = tile;
+  m_chunks[static_cast<std::size_t>(y / m_chunkSize) * m_chunksX + x / m_chunkSize].dirty = true;
+ }
+}
+
+uint16_t
+CTilemap::getTile(unsigned int x, unsigned int y) const {
+ if (x >= m_width || y >= m_height) {
+  return EMPTY_TILE;
+ }
+ return m_tiles[static_cast<std::size_t>(y) * m_width + x];
+}
+
+void
+CTilemap::setOrigin(const sf::Vector2f& origin) {
+ if (origin == m_origin) {
+  return;
+ }
+ m_origin = origin;
+ for (Chunk& chunk : m_chunks) {
+  chunk.dirty = true;
+ }
+}
+
+sf::FloatRect
+CTilemap::getWorldBounds() const {
+ return sf::FloatRect(m_origin, { m_tileSize.x * m_width, m_tileSize.y * m_height });
+}
+
+CTilemap::Chunk&
+CTilemap::touchChunk(unsigned int chunkX, unsigned int chunkY) {
+ Chunk& chunk = m_chunks[static_cast<std::size_t>(chunkY) * m_chunksX + chunkX];
+ if (chunk.dirty) {
+  buildChunk(chunkX, chunkY);
+ }
+ return chunk;
+}
+
+void
+CTilemap::buildChunk(unsigned int chunkX, unsigned int chunkY) {
+ Chunk& chunk = m_chunks[static_cast<std::size_t>(chunkY) * m_chunksX + chunkX];
+ const bool wasResident = !chunk.vertices.empty();
+ chunk.vertices.clear();
+ chunk.dirty = false;
+
+ const sf::Vector2u texSize = m_tileset ? m_tileset->getTexture().getSize() : sf::Vector2u(0, 0);
+ const unsigned int tx0 = chunkX * m_chunkSize;
+ const unsigned int ty0 = chunkY * m_chunkSize;
+ const unsigned int tx1 = std::min(m_width, tx0 + m_chunkSize);
+ const unsigned int ty1 = std::min(m_height, ty0 + m_chunkSize);
+ chunk.vertices.reserve(static_cast<std::size_t>(tx1 - tx0) * (ty1 - ty0) * 6);
+
+ for (unsigned int y = ty0; y < ty1; ++y) {
+  for (unsigned int x = tx0; x < tx1; ++x) {
+   const uint16_t tile = m_tiles[static_cast<std::size_t>(y) * m_width + x];
+   if (tile == EMPTY_TILE) {
+    continue;
+   }
+   //celda del tileset; las del borde se recortan a la textura
+   const float u0 = static_cast<float>((tile % m_tilesetColumns) * m_tilePixels.x);
+   const float v0 = static_cast<float>((tile / m_tilesetColumns) * m_tilePixels.y);
+   float u1 = u0 + m_tilePixels.x;
+   float v1 = v0 + m_tilePixels.y;
+   float fracX = 1.f, fracY = 1.f;
+   if (texSize.x > 0 && u1 > texSize.x) {
+    fracX = (texSize.x - u0) / m_tilePixels.x;
+    u1 = static_cast<float>(texSize.x);
+   }
+   if (texSize.y > 0 && v1 > texSize.y) {
+    fracY = (texSize.y - v0) / m_tilePixels.y;
+    v1 = static_cast<float>(texSize.y);
+   }
+   if (fracX <= 0.f || fracY <= 0.f) {
+    continue;
+   }
+
+   const sf::Vector2f p0(m_origin.x + x * m_tileSize.x, m_origin.y + y * m_tileSize.y);
+   const sf::Vector2f p1(p0.x + m_tileSize.x * fracX, p0.y + m_tileSize.y * fracY);
+   const sf::Vertex a{ p0, sf::Color::White, { u0, v0 } };
+   const sf::Vertex b{ { p1.x, p0.y }, sf::Color::White, { u1, v0 } };
+   const sf::Vertex c{ p1, sf::Color::White, { u1, v1 } };
+   const sf::Vertex d{ { p0.x, p1.y }, sf::Color::White, { u0, v1 } };
+   chunk.vertices.push_back(a);
+   chunk.vertices.push_back(b);
+   chunk.vertices.push_back(c);
+   chunk.vertices.push_back(a);
+   chunk.vertices.push_back(c);
+   chunk.vertices.push_back(d);
+  }
+ }
+
+ const bool isResident = !chunk.vertices.empty();
+ if (isResident && !wasResident) ++m_residentChunks;
+ if (!isResident && wasResident) --m_residentChunks;
+}
@@ -0,0 +1,194 @@
+//gl.h necesita windows.h, que trae el ERROR de wingdi: se incluye antes que el motor
+#include <SFML/OpenGL.hpp>
+#ifdef ERROR
+#undef ERROR
+#endif
+#include "CookedTexture.h"
+#include "Utilities/Compression.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+
+namespace {
+ constexpr uint32_t COOKED_VERSION = 1;
+
+ static_assert(sizeof(CookedTexture::Header) == 40, "Header layout is part of the file format");
+
+ uint64_t
+  levelBytes(uint32_t width, uint32_t height) {
+  return static_cast<uint64_t>(width) * height * 4;
+ }
+
+ //bytes de todos los niveles, o 0 si las dimensiones no son validas
+ uint64_t
+  chainBytes(uint32_t width, uint32_t height, uint32_t mipCount) {
+  uint64_t total = 0;
+  for (uint32_t level = 0; level < mipCount; ++level) {
+   if (width == 0 || height == 0) {
+    return 0;
+   }
+   total += levelBytes(width, height);
+   width = std::max(1u, width / 2);
+   height = std::max(1u, height / 2);
+  }
+  return total;
+ }
+
+ //filtro de caja 2x2; en lados impares se repite la ultima columna/fila
+ void
+  downsample(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination) {
+  const uint32_t outWidth = std::max(1u, width / 2);
+  const uint32_t outHeight = std::max(1u, height / 2);
+  for (uint32_t y = 0; y < outHeight; ++y) {
+   const uint32_t y0 = std::min(y * 2, height - 1);
+   const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+   for (uint32_t x = 0; x < outWidth; ++x) {
+    const uint32_t x0 = std::min(x * 2, width - 1);
+    const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+    const uint8_t* a = source + (static_cast<std::size_t>(y0) * width + x0) * 4;
+    const uint8_t* b = source + (static_cast<std::size_t>(y0) * width + x1) * 4;
+    const uint8_t* c = source + (static_cast<std::size_t>(y1) * width + x0) * 4;
+    const uint8_t* d = source + (static_cast<std::size_t>(y1) * width + x1) * 4;
+    uint8_t* out = destination + (static_cast<std::size_t>(y) * outWidth + x) * 4;
+    for (int channel = 0; channel < 4; ++channel) {
+     out[channel] = static_cast<uint8_t>((a[channel] + b[channel] + c[channel] + d[channel] + 2) / 4);
+    }
+   }
+  }
+ }
+}
+
+bool
+CookedTexture::parse(ByteSpan blob) {
+ m_pixels = nullptr;
+ m_storage.clear();
+ if (blob.empty() || blob.size < sizeof(Header)) {
+  return false;
+ }
+ std::memcpy(&m_header, blob.data, sizeof(Header));
+ const uint64_t stored = blob.size - sizeof(Header);
+ if (std::memcmp(m_header.magic, "CTX1", 4) != 0 || m_header.version != COOKED_VERSION
+     || m_header.mipCount == 0 || m_header.storedBytes > stored
+     || chainBytes(m_header.width, m_header.height, m_header.mipCount) != m_header.pixelBytes) {
+  return false;
+ }
+
+ const uint8_t* data = blob.data + sizeof(Header);
+ if ((m_header.flags & FLAG_COMPRESSED) == 0) {
+  if (m_header.storedBytes != m_header.pixelBytes) {
+   return false;
+  }
+  m_pixels = data;
+  return true;
+ }
+
+ m_storage.resize(static_cast<std::size_t>(m_header.pixelBytes));
+ if (!Compression::decompress(data, static_cast<std::size_t>(m_header.storedBytes),
+                              m_storage.data(), m_storage.size())) {
+  m_storage.clear();
+  return false;
+ }
+ m_pixels = m_storage.data();
+ return true;
+}
+
+bool
+CookedTexture::upload(sf::Texture& texture) const {
+ if (!isValid()) {
+  return false;
+ }
+ const sf::Vector2u size = getSize();
+ if (texture.getSize() != size && !texture.resize(size)) {
+  return false;
+ }
+ texture.update(m_pixels);
+ if (m_header.mipCount == 1) {
+  return true;
+ }
+
+ //SFML no sube niveles propios: se escriben con GL sobre la textura ya creada
+ sf::Texture::bind(&texture);
+ const uint8_t* level = m_pixels + levelBytes(size.x, size.y);
+ uint32_t width = size.x;
+ uint32_t height = size.y;
+ for (uint32_t mip = 1; mip < m_header.mipCount; ++mip) {
+  width = std::max(1u, width / 2);
+  height = std::max(1u, height / 2);
+  glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(mip), GL_RGBA,
+               static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+               GL_RGBA, GL_UNSIGNED_BYTE, level);
+  level += levelBytes(width, height);
+ }
+ glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_header.mipCount - 1));
+ glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                 texture.isSmooth() ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR);
+ sf::Texture::bind(nullptr);
+ return true;
+}
+
+bool
+CookedTexture::cook(const sf::Image& image, const CookOptions& options, std::vector<uint8_t>& output) {
+ const sf::Vector2u size = image.getSize();
+ if (size.x == 0 || size.y == 0) {
+  return false;
+ }
+
+ uint32_t mipCount = 1;
+ if (options.mipmaps) {
+  for (uint32_t side = std::max(size.x, size.y); side > 1; side /= 2) {
+   ++mipCount;
+  }
+ }
+
+ Header header = {};
+ std::memcpy(header.magic, "CTX1", 4);
+ header.version = COOKED_VERSION;
+ header.width = size.x;
+ header.height = size.y;
+ header.mipCount = mipCount;
+ header.pixelBytes = chainBytes(size.x, size.y, mipCount);
+
+ std::vector<uint8_t> pixels(static_cast<std::size_t>(header.pixelBytes));
+ std::memcpy(pixels.data(), image.getPixelsPtr(), static_cast<std::size_t>(levelBytes(size.x, size.y)));
+ //se premultiplica antes de reducir para que los bordes transparentes no oscurezcan los mips
+ if (options.premultiply) {
+  header.flags |= FLAG_PREMULTIPLIED;
+  const std::size_t count = static_cast<std::size_t>(size.x) * size.y;
+  for (std::size_t i = 0; i < count; ++i) {
+   uint8_t* pixel = &pixels[i * 4];
+   for (int channel = 0; channel < 3; ++channel) {
+    pixel[channel] = static_cast<uint8_t>((pixel[channel] * pixel[3] + 127) / 255);
+   }
+  }
+ }
+
+ uint8_t* level = pixels.data();
+ uint32_t width = size.x;
+ uint32_t height = size.y;
+ for (uint32_t mip = 1; mip < mipCount; ++mip) {
+  uint8_t* next = level + levelBytes(width, height);
+  downsample(level, width, height, next);
+  level = next;
+  width = std::max(1u, width / 2);
+  height = std::max(1u, height / 2);
+ }
+
+ std::vector<uint8_t> packed;
+ const std::vector<uint8_t>* payload = &pixels;
+ if (options.compress) {
+  Compression::compress(pixels.data(), pixels.size(), packed);
+  if (packed.size() < pixels.size()) {
+   payload = &packed;
+   header.flags |= FLAG_COMPRESSED;
+  }
+ }
+ header.storedBytes = payload->size();
+
+ output.resize(sizeof(Header) + payload->size());
+ std::memcpy(output.data(), &header, sizeof(Header));
+ std::memcpy(output.data() + sizeof(Header), payload->data(), payload->size());
+ return true;
+}
@@ -1,5 +1,6 @@
 #include "A_Racer.h"
 #include "ECS/Transform.h"
+#include "Render/DebugDraw.h"
 #include <algorithm>
 
 static inline float length(const sf::Vector2f& v) { 
@@ -37,6 +38,17 @@ A_Racer::update(float dt) {
  if (m_waypoints.size() >= 2) steerPhysics(dt);
 }
 
+void
+A_Racer::updatePlaces(const std::vector<EngineUtilities::TSharedPointer<A_Racer>>& racers,
+                      std::vector<PlaceEntry>& scratch) {
+ //progreso leido una vez por corredor, luego se ordena
+ //el buffer es del llamador: reutilizado entre frames, el ranking no reserva memoria en el bucle
+ scratch.clear(); scratch.reserve(racers.size());
+ for (auto& r : racers) scratch.push_back({ r->getProgressMeters(), r.get() });
+ std::sort(scratch.begin(), scratch.end(), [](const PlaceEntry& a, const PlaceEntry& b){ return a.progress > b.progress; });
+ for (int i = 0; i < (int)scratch.size(); ++i) scratch[i].racer->setPlace(i + 1);
+}
+
 void
 A_Racer::steerPhysics(float dt) {
  auto tr = getComponent<Transform>();
@@ -76,6 +88,13 @@ A_Racer::steerPhysics(float dt) {
  // limitar velocidad y mover
  velocity = clampMag(velocity, maxSpeed);
  tr->setPosition(pos + velocity * dt);
+
+ // debug: objetivo, radios de llegada y vectores de steering
+ DEBUG_LINE(pos, target, sf::Color(200, 200, 200, 160));
+ DEBUG_CIRCLE(target, arriveRadius, sf::Color::Yellow);
+ DEBUG_CIRCLE(target, slowRadius, sf::Color(255, 140, 0));
+ DEBUG_ARROW(pos, pos + velocity * 0.25f, sf::Color::Green);
+ DEBUG_ARROW(pos, pos + steering * 0.1f, sf::Color::Red);
 }
 
 // ---------- progreso/leaderboard ----------
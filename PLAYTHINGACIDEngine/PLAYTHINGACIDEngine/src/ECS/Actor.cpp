@@ -1,8 +1,27 @@
 #include "Actor.h"
+#include <atomic>
+
+namespace {
+ //cambia con cada setParent y al crear o destruir un actor; el outliner y el indice de
+ //picking lo comparan para no rehacerse cada frame
+ std::atomic<uint32_t> g_hierarchyVersion{ 0 };
+ //actores cuyo shape se movio desde el ultimo takeDirtyBounds (conserva la capacidad)
+ std::vector<int> g_dirtyBounds;
+}
+
+Actor::Actor() {
+ g_hierarchyVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
+Actor::~Actor() {
+ g_hierarchyVersion.fetch_add(1, std::memory_order_relaxed);
+}
 
 Actor::Actor(const std::string& actorName) {
+ g_hierarchyVersion.fetch_add(1, std::memory_order_relaxed);
  //setup actorname
- m_name = actorName;
+ m_name = StringId(actorName);
+ m_nameText = &m_name.getString();
  //setup shape
  EngineUtilities::TSharedPointer<CShape> shape = EngineUtilities::MakeShared<CShape>();
  addComponent(shape);
@@ -17,9 +36,28 @@ Actor::update(float deltaTime) {
  auto shape = getComponent <CShape>();
 
  if (transform && shape) {
-  shape->setPosition(transform->getPosition());
-  shape->setRotation(transform->getRotation().x);
-  shape->setScale(transform->getScale());
+  //solo se copian los campos que cambiaron; un shape nuevo los necesita todos
+  uint32_t changed = transform->consumeChanges();
+  if (shape->getShapeRevision() != m_syncedShapeRevision) {
+   m_syncedShapeRevision = shape->getShapeRevision();
+   changed = TRANSFORM_FIELD_ALL;
+  }
+  if (changed & TRANSFORM_FIELD_POSITION) shape->setPosition(transform->getPosition());
+  if (changed & TRANSFORM_FIELD_ROTATION) shape->setRotation(transform->getRotation().x);
+  if (changed & TRANSFORM_FIELD_SCALE) shape->setScale(transform->getScale());
+  if (changed != 0 && m_boundsId >= 0) g_dirtyBounds.push_back(m_boundsId);
+ }
+ if (shape) {
+  shape->update(deltaTime);
+ }
+
+ //el tilemap se ancla en la posicion del actor
+ auto tilemap = getComponent <CTilemap>();
+ if (tilemap) {
+  if (transform) {
+   tilemap->setOrigin(transform->getPosition());
+  }
+  tilemap->update(deltaTime);
  }
 }
 
@@ -32,6 +70,33 @@ Actor::render(const EngineUtilities::TSharedPointer<Window>& window) {
  }
 }
 
+bool
+Actor::setParent(Actor* parent) {
+ //sin ciclos: el padre no puede ser este actor ni uno de sus descendientes
+ for (Actor* ancestor = parent; ancestor != nullptr; ancestor = ancestor->m_parent) {
+  if (ancestor == this) {
+   return false;
+  }
+ }
+ if (m_parent != parent) {
+  m_parent = parent;
+  g_hierarchyVersion.fetch_add(1, std::memory_order_relaxed);
+ }
+ return true;
+}
+
+uint32_t
+Actor::getHierarchyVersion() {
+ return g_hierarchyVersion.load(std::memory_order_relaxed);
+}
+
+void
+Actor::takeDirtyBounds(std::vector<int>& out) {
+ //intercambio: los dos buffers se alternan sin reservar memoria
+ out.clear();
+ out.swap(g_dirtyBounds);
+}
+
 void
 Actor::setTexture(const EngineUtilities::TSharedPointer<Texture>& texture) {
  auto shape = getComponent<CShape>();
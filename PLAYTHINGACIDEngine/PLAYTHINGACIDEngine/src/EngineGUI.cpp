@@ -3,6 +3,34 @@
 #include <imgui.h>
 #include "Actor.h" // Change from "ECS/Actor.h" to "Actor.h"
 #include "A_Racer.h"
+#include "ECS/Reflection.h"
+#include "Render/Camera.h"
+#include "Render/DebugDraw.h"
+#include "ResourceManager.h"
+#include "Utilities/Profiler.h"
+#include "Utilities/FrameStats.h"
+#include "Utilities/MemoryTracker.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+    // nombre de un componente sin reflexion
+    const char*
+    componentTypeName(ComponentType type) {
+        switch (type) {
+        case TRANSFORM: return "Transform";
+        case SPRITE: return "Sprite";
+        case RENDERER: return "Renderer";
+        case PHYSICS: return "Physics";
+        case AUDIOSOURCE: return "Audio source";
+        case SHAPE: return "Shape";
+        case TEXTURE: return "Texture";
+        case TILEMAP: return "Tilemap";
+        default: return "Component";
+        }
+    }
+}
 
 void
 EngineGUI::init(const EngineUtilities::TSharedPointer<Window>& window) {
@@ -39,70 +67,280 @@ EngineGUI::outliner(const std::vector<EngineUtilities::TSharedPointer<Actor>>& a
         ImGui::End();
         return;
     }
+    // -1 es "nada seleccionado" (clic en vacio): no se fuerza al primer actor
     if (selectedActorIndex >= total) selectedActorIndex = total - 1;
-    if (selectedActorIndex < 0)      selectedActorIndex = 0;
 
-    static ImGuiTextFilter filter;
-    filter.Draw("Search...", 180.0f);
+    const bool filterChanged = m_outlinerFilter.Draw("Search...", 180.0f);
     ImGui::Separator();
 
-    for (int i = 0; i < total; ++i) {
-        const auto& actor = actors[i];
-        const std::string actorName = actor ? actor->getName() : "Unnamed Actor";
-        if (!filter.PassFilter(actorName.c_str())) continue;
-
-        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick;
-        if (selectedActorIndex == i) flags |= ImGuiTreeNodeFlags_Selected;
+    // el arbol solo se rehace si cambia la lista de actores o algun padre
+    if (actors.data() != m_outlinerSource || actors.size() != m_outlinerSourceSize
+        || Actor::getHierarchyVersion() != m_outlinerVersion) {
+        rebuildOutlinerTree(actors);
+    }
+    if (filterChanged || m_outlinerRowsDirty) {
+        rebuildOutlinerRows(actors);
+    }
 
-        const bool nodeOpen = ImGui::TreeNodeEx((void*)(intptr_t)i, flags, "%s", actorName.c_str());
-        if (ImGui::IsItemClicked()) selectedActorIndex = i;
-        if (nodeOpen) ImGui::TreePop();
+    ImGui::BeginChild("HierarchyRows");
+    // solo se dibujan las filas visibles
+    const float indent = ImGui::GetStyle().IndentSpacing;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(m_outlinerRows.size()));
+    while (clipper.Step()) {
+        for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r) {
+            const OutlinerRow& row = m_outlinerRows[r];
+            const int i = row.actor;
+            const auto& actor = actors[i];
+
+            ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick
+                                     | ImGuiTreeNodeFlags_NoTreePushOnOpen | ImGuiTreeNodeFlags_SpanAvailWidth;
+            if (!row.hasChildren) flags |= ImGuiTreeNodeFlags_Leaf;
+            const bool selected = selectedActorIndex == i
+                || (i < static_cast<int>(m_selectedFlags.size()) && m_selectedFlags[i]);
+            if (selected) flags |= ImGuiTreeNodeFlags_Selected;
+
+            if (row.depth > 0) ImGui::Indent(indent * row.depth);
+            ImGui::SetNextItemOpen(m_outlinerOpen[i] != 0);
+            const bool nodeOpen = ImGui::TreeNodeEx((void*)(intptr_t)i, flags, "%s",
+                actor ? actor->getName().c_str() : "Unnamed Actor");
+            if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) selectActors({ i }, ImGui::GetIO().KeyCtrl);
+            if (row.depth > 0) ImGui::Unindent(indent * row.depth);
+
+            // abrir o cerrar cambia las filas: se rehacen en el siguiente frame
+            if (row.hasChildren && nodeOpen != (m_outlinerOpen[i] != 0)) {
+                m_outlinerOpen[i] = nodeOpen ? 1 : 0;
+                m_outlinerRowsDirty = true;
+            }
+        }
     }
+    clipper.End();
+    ImGui::EndChild();
     ImGui::End();
 }
 
-
 void
-EngineGUI::console(const std::map<ConsolErrorType, std::vector<std::string>>& programMessages) {
-    ImGui::Begin("Console");
+EngineGUI::selectActors(const std::vector<int>& indices, bool additive) {
+    if (!additive) {
+        for (int i : m_selection) {
+            if (i < static_cast<int>(m_selectedFlags.size())) m_selectedFlags[i] = 0;
+        }
+        m_selection.clear();
+    }
+    for (int i : indices) {
+        if (i < 0) continue;
+        if (i >= static_cast<int>(m_selectedFlags.size())) m_selectedFlags.resize(i + 1, 0);
+        if (m_selectedFlags[i]) continue;
+        m_selectedFlags[i] = 1;
+        m_selection.push_back(i);
+    }
+    if (!indices.empty()) selectedActorIndex = indices.back();
+    else if (!additive) selectedActorIndex = -1;
+}
 
-    static ImGuiTextFilter filter; // Filtro de bsqueda
-    filter.Draw("Filter (\"error\", \"warning\", etc.)", 180.0f);
+void
+EngineGUI::rebuildOutlinerTree(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors) {
+    PROFILE_SCOPE("Outliner tree");
+    const int total = static_cast<int>(actors.size());
+    std::unordered_map<const Actor*, int> indices;
+    indices.reserve(actors.size());
+    for (int i = 0; i < total; ++i) {
+        if (actors[i]) indices.emplace(actors[i].get(), i);
+    }
 
-    ImGui::Separator();
+    m_outlinerRoots.clear();
+    m_outlinerFirstChild.assign(actors.size(), -1);
+    m_outlinerNextSibling.assign(actors.size(), -1);
+    m_outlinerOpen.resize(actors.size(), 0);
+
+    // de atras hacia adelante para que los hijos queden en el orden de la lista
+    for (int i = total - 1; i >= 0; --i) {
+        const Actor* parent = actors[i] ? actors[i]->getParent() : nullptr;
+        const auto found = parent ? indices.find(parent) : indices.end();
+        if (found == indices.end()) {
+            m_outlinerRoots.push_back(i);
+            continue;
+        }
+        m_outlinerNextSibling[i] = m_outlinerFirstChild[found->second];
+        m_outlinerFirstChild[found->second] = i;
+    }
+    std::reverse(m_outlinerRoots.begin(), m_outlinerRoots.end());
 
-    ImGui::BeginChild("ScrollingRegion", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+    m_outlinerSource = actors.data();
+    m_outlinerSourceSize = actors.size();
+    m_outlinerVersion = Actor::getHierarchyVersion();
+    m_outlinerRowsDirty = true;
+}
 
-    for (const auto& pair : programMessages) {
-        // Establece color segn el tipo de mensaje
-        ImVec4 color;
-        switch (pair.first) {
-        case ConsolErrorType::ERROR:
-            color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f); // Rojo para errores
-            break;
-        case ConsolErrorType::WARNING:
-            color = ImVec4(1.0f, 1.0f, 0.4f, 1.0f); // Amarillo para advertencias
-            break;
-        case ConsolErrorType::INFO:
-        default:
-            color = ImVec4(0.8f, 0.8f, 0.8f, 1.0f); // Gris para mensajes de informacin
-            break;
+void
+EngineGUI::rebuildOutlinerRows(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors) {
+    PROFILE_SCOPE("Outliner rows");
+    m_outlinerRows.clear();
+    m_outlinerRowsDirty = false;
+
+    // con filtro la lista es plana: todas las coincidencias, esten o no plegadas
+    if (m_outlinerFilter.IsActive()) {
+        for (int i = 0; i < static_cast<int>(actors.size()); ++i) {
+            const char* name = actors[i] ? actors[i]->getName().c_str() : "Unnamed Actor";
+            if (m_outlinerFilter.PassFilter(name)) {
+                m_outlinerRows.push_back({ i, 0, false });
+            }
         }
+        return;
+    }
+
+    // recorrido en profundidad que solo baja por los nodos abiertos
+    std::vector<std::pair<int, int>> stack; // actor, profundidad
+    for (auto root = m_outlinerRoots.rbegin(); root != m_outlinerRoots.rend(); ++root) {
+        stack.push_back({ *root, 0 });
+    }
+    std::vector<int> children;
+    while (!stack.empty()) {
+        const auto [i, depth] = stack.back();
+        stack.pop_back();
+        const bool hasChildren = m_outlinerFirstChild[i] >= 0;
+        m_outlinerRows.push_back({ i, depth, hasChildren });
+        if (!hasChildren || !m_outlinerOpen[i]) continue;
+
+        children.clear();
+        for (int c = m_outlinerFirstChild[i]; c >= 0; c = m_outlinerNextSibling[c]) children.push_back(c);
+        for (auto c = children.rbegin(); c != children.rend(); ++c) stack.push_back({ *c, depth + 1 });
+    }
+}
+
 
-        for (const auto& message : pair.second) {
-            if (!filter.PassFilter(message.c_str())) continue; // Filtrar mensajes segn el filtro de bsqueda
+void
+EngineGUI::console(bool* open) {
+    if (!ImGui::Begin("Console", open)) {
+        ImGui::End();
+        return;
+    }
+
+    Logger& logger = Logger::getInstance();
+    static int minSeverity = LOG_SEVERITY_TRACE;
+    bool filterChanged = false;
+    const char* severities[] = { "Trace", "Debug", "Info", "Warning", "Error" };
+    ImGui::SetNextItemWidth(100.f);
+    filterChanged |= ImGui::Combo("Show", &minSeverity, severities, IM_ARRAYSIZE(severities));
+    ImGui::SameLine();
+    static ImGuiTextFilter filter; // Filtro de bsqueda
+    filterChanged |= filter.Draw("Filter", 180.0f);
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) {
+        logger.clearConsole();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Levels")) {
+        ImGui::OpenPopup("log_levels");
+    }
 
-            ImGui::PushStyleColor(ImGuiCol_Text, color);
-            ImGui::Text("[%d] %s", pair.first, message.c_str());
-            ImGui::PopStyleColor();
+    // niveles en tiempo de ejecucion: global y por categoria (se filtran en el punto de llamada)
+    if (ImGui::BeginPopup("log_levels")) {
+        const char* levels[] = { "Trace", "Debug", "Info", "Warning", "Error", "Off" };
+        int level = logger.getLevel();
+        ImGui::SetNextItemWidth(100.f);
+        if (ImGui::Combo("Global", &level, levels, IM_ARRAYSIZE(levels))) {
+            logger.setLevel(static_cast<LogSeverity>(level));
         }
+        ImGui::Separator();
+        for (uint16_t c = 0; c < logger.getCategoryCount(); ++c) {
+            int categoryLevel = logger.getCategoryLevel(c);
+            ImGui::SetNextItemWidth(100.f);
+            ImGui::PushID(c);
+            if (ImGui::Combo(logger.getCategoryName(c), &categoryLevel, levels, IM_ARRAYSIZE(levels))) {
+                logger.setCategoryLevel(c, static_cast<LogSeverity>(categoryLevel));
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndPopup();
     }
 
-    // Desplazamiento automtico al final
-    if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
-        ImGui::SetScrollHereY(1.0f);
+    // cache del filtro: secuencias que pasan, se completa solo con las lineas nuevas
+    static constexpr uint64_t SCAN_BUDGET = 100000; // lineas filtradas por frame como maximo
+    static std::vector<uint64_t> matches;
+    static std::size_t matchStart = 0;              // primera coincidencia que sigue en el anillo
+    static uint64_t scanned = 0;                    // siguiente secuencia por filtrar
+
+    // el anillo queda bloqueado solo mientras se filtra lo nuevo y se pintan las lineas visibles
+    logger.readConsole([&](const LogBuffer& buffer) {
+        const uint64_t first = buffer.getFirstSequence();
+        const uint64_t next = buffer.getNextSequence();
+        const bool filtering = minSeverity > LOG_SEVERITY_TRACE || filter.IsActive();
+
+        if (filterChanged) {
+            matches.clear();
+            matchStart = 0;
+            scanned = first;
+        }
+        if (filtering) {
+            scanned = std::max(scanned, first);
+            const uint64_t end = std::min(next, scanned + SCAN_BUDGET);
+            for (; scanned < end; ++scanned) {
+                const LogBuffer::Line& line = buffer.getLine(scanned);
+                if (line.severity < minSeverity) continue;
+                const std::string_view text = buffer.getText(line);
+                if (filter.PassFilter(text.data(), text.data() + text.size())
+                    || filter.PassFilter(logger.getCategoryName(line.category))) {
+                    matches.push_back(scanned);
+                }
+            }
+            // fuera las coincidencias que el anillo ya descarto
+            while (matchStart < matches.size() && matches[matchStart] < first) ++matchStart;
+            if (matchStart > 4096 && matchStart * 2 > matches.size()) {
+                matches.erase(matches.begin(), matches.begin() + matchStart);
+                matchStart = 0;
+            }
+        }
+        const std::size_t rows = filtering ? matches.size() - matchStart : buffer.size();
+
+        ImGui::TextDisabled("%zu lines, %zu shown%s | %llu older discarded, %llu dropped by full rings",
+            buffer.size(), rows, (filtering && scanned < next) ? " (filtering...)" : "",
+            static_cast<unsigned long long>(first), static_cast<unsigned long long>(logger.getDroppedCount()));
+        ImGui::Separator();
+
+        ImGui::BeginChild("ScrollingRegion", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+        // solo se tocan las lineas visibles (todas miden lo mismo)
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const uint64_t sequence = filtering ? matches[matchStart + row] : first + row;
+                const LogBuffer::Line& line = buffer.getLine(sequence);
+
+                // Establece color segn el tipo de mensaje
+                ImVec4 color;
+                switch (line.severity) {
+                case LOG_SEVERITY_ERROR:
+                    color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f); // Rojo para errores
+                    break;
+                case LOG_SEVERITY_WARNING:
+                    color = ImVec4(1.0f, 1.0f, 0.4f, 1.0f); // Amarillo para advertencias
+                    break;
+                case LOG_SEVERITY_INFO:
+                    color = ImVec4(0.8f, 0.8f, 0.8f, 1.0f); // Gris para mensajes de informacin
+                    break;
+                default:
+                    color = ImVec4(0.55f, 0.55f, 0.55f, 1.0f); // Gris oscuro para trace/debug
+                    break;
+                }
+
+                const std::string_view text = buffer.getText(line);
+                ImGui::PushStyleColor(ImGuiCol_Text, color);
+                ImGui::Text("[%8.3f] [%s]", line.time, logger.getCategoryName(line.category));
+                ImGui::SameLine();
+                ImGui::TextUnformatted(text.data(), text.data() + text.size());
+                ImGui::PopStyleColor();
+            }
+        }
+        clipper.End();
 
-    ImGui::EndChild();
+        // Desplazamiento automtico al final
+        if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+            ImGui::SetScrollHereY(1.0f);
+
+        ImGui::EndChild();
+    });
     ImGui::End();
 }
 
@@ -110,6 +348,22 @@ void
 EngineGUI::inspector(const std::vector<EngineUtilities::TSharedPointer<Actor>>& actors) {
     const int total = static_cast<int>(actors.size());
     if (total == 0 || selectedActorIndex < 0 || selectedActorIndex >= total) return;
+    const Actor* actor = actors[selectedActorIndex].get();
+    if (!actor) return;
+
+    // punteros a componentes cacheados: solo se rehacen si cambia la seleccion o su lista
+    const auto& components = actor->getComponents();
+    if (actor != m_inspectorActor || components.data() != m_inspectorSource
+        || components.size() != m_inspectorComponentCount) {
+        m_inspectorComponents.clear();
+        for (const auto& component : components) {
+            if (component) m_inspectorComponents.push_back({ component.get(), component->getReflection() });
+        }
+        m_inspectorActor = actor;
+        m_inspectorSource = components.data();
+        m_inspectorComponentCount = components.size();
+    }
+
     ImGui::Begin("Inspector");
     // Checkbox para Static
     bool isStatic = false;
@@ -118,7 +372,7 @@ EngineGUI::inspector(const std::vector<EngineUtilities::TSharedPointer<Actor>>&
 
     // Input text para el nombre del objeto
     char objectName[128];
-    std::string name = actors[selectedActorIndex]->getName();
+    std::string name = actor->getName();
     std::copy(name.begin(), name.end(), objectName);
     objectName[name.size()] = '\0';  // Asegurarse de terminar la cadena
 
@@ -149,18 +403,58 @@ EngineGUI::inspector(const std::vector<EngineUtilities::TSharedPointer<Actor>>&
 
     ImGui::Separator();
 
-    // Transform elements
-    vec2Control("Position", actors[selectedActorIndex]->getComponent<Transform>()->getPosData());
-    vec2Control("Rotation", actors[selectedActorIndex]->getComponent<Transform>()->getRotData());
-    vec2Control("Scale", actors[selectedActorIndex]->getComponent<Transform>()->getScaData());
+    // editores generados desde la reflexion de cada componente
+    for (const InspectorComponent& entry : m_inspectorComponents) {
+        ImGui::PushID(entry.component);
+        if (!entry.reflection) {
+            ImGui::TextDisabled("%s (no reflected fields)", componentTypeName(entry.component->getType()));
+        }
+        else if (ImGui::CollapsingHeader(entry.reflection->name, ImGuiTreeNodeFlags_DefaultOpen)) {
+            uint32_t changed = 0;
+            for (uint32_t f = 0; f < entry.reflection->fieldCount; ++f) {
+                if (fieldControl(entry.reflection->fields[f], entry.component)) changed |= 1u << f;
+            }
+            // solo los campos tocados invalidan a quien dependa de ellos
+            if (changed != 0) entry.component->markChanged(changed);
+        }
+        ImGui::PopID();
+    }
 
     ImGui::End();
 }
 
-void EngineGUI::vec2Control(const std::string& label,
+bool
+EngineGUI::fieldControl(const ReflectField& field, Component* component) {
+    void* address = field.address(component);
+    switch (field.type) {
+    case REFLECT_TYPE_BOOL:
+        return ImGui::Checkbox(field.name, static_cast<bool*>(address));
+    case REFLECT_TYPE_INT:
+        return ImGui::DragInt(field.name, static_cast<int*>(address), field.speed,
+            static_cast<int>(field.min), static_cast<int>(field.max));
+    case REFLECT_TYPE_UINT: {
+        const unsigned int minValue = static_cast<unsigned int>(field.min);
+        const unsigned int maxValue = static_cast<unsigned int>(field.max);
+        return ImGui::DragScalar(field.name, ImGuiDataType_U32, address, field.speed,
+            field.min < field.max ? &minValue : nullptr, field.min < field.max ? &maxValue : nullptr);
+    }
+    case REFLECT_TYPE_FLOAT:
+        return ImGui::DragFloat(field.name, static_cast<float*>(address), field.speed, field.min, field.max, "%.2f");
+    case REFLECT_TYPE_VEC2:
+        return vec2Control(field.name, static_cast<float*>(address), 0.0f, 100.0f, field.speed, field.min, field.max);
+    default:
+        return false;
+    }
+}
+
+bool EngineGUI::vec2Control(const std::string& label,
     float* values,
     float resetValues,
-    float columnWidth) {
+    float columnWidth,
+    float speed,
+    float minValue,
+    float maxValue) {
+    bool changed = false;
     ImGuiIO& io = ImGui::GetIO();
     ImFont* boldFont = (io.Fonts && !io.Fonts->Fonts.empty()) ? io.Fonts->Fonts[0] : nullptr;
 
@@ -182,13 +476,13 @@ void EngineGUI::vec2Control(const std::string& label,
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{ 0.9f, 0.2f, 0.2f, 1.0f });
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{ 0.8f, 0.1f, 0.15f, 1.0f });
     if (boldFont) ImGui::PushFont(boldFont);
-    if (ImGui::Button("X", buttonSize)) values[0] = resetValues;
+    if (ImGui::Button("X", buttonSize)) { values[0] = resetValues; changed = true; }
     if (boldFont) ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
     ImGui::PushItemWidth(itemWidth);
-    ImGui::DragFloat("##X", &values[0], 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##X", &values[0], speed, minValue, maxValue, "%.2f");
     ImGui::PopItemWidth();
     ImGui::SameLine();
 
@@ -197,18 +491,19 @@ void EngineGUI::vec2Control(const std::string& label,
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{ 0.3f, 0.8f, 0.3f, 1.0f });
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{ 0.2f, 0.7f, 0.2f, 1.0f });
     if (boldFont) ImGui::PushFont(boldFont);
-    if (ImGui::Button("Y", buttonSize)) values[1] = resetValues;
+    if (ImGui::Button("Y", buttonSize)) { values[1] = resetValues; changed = true; }
     if (boldFont) ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
     ImGui::PushItemWidth(itemWidth);
-    ImGui::DragFloat("##Y", &values[1], 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##Y", &values[1], speed, minValue, maxValue, "%.2f");
     ImGui::PopItemWidth();
 
     ImGui::PopStyleVar();
     ImGui::Columns(1);
     ImGui::PopID();
+    return changed;
 }
 
 
@@ -313,6 +608,10 @@ void EngineGUI::setupGUIStyle() {
 }
 
 void EngineGUI::barMenu() {
+    static bool show_prof = false;
+    static bool show_mem = false;
+    static bool show_console = true;
+
     if (ImGui::BeginMainMenuBar()) {
 
         if (ImGui::BeginMenu("File")) {
@@ -341,12 +640,14 @@ void EngineGUI::barMenu() {
 
         if (ImGui::BeginMenu("View")) {
             static bool show_demo = false;
-            static bool show_console = true;
-            static bool show_prof = false;
 
             ImGui::MenuItem("Show Demo Window", nullptr, &show_demo);
             ImGui::MenuItem("Console", nullptr, &show_console);
             ImGui::MenuItem("Profiler", nullptr, &show_prof);
+            ImGui::MenuItem("Memory", nullptr, &show_mem);
+#if ENGINE_DEBUG_DRAW
+            ImGui::MenuItem("Debug Draw", nullptr, DebugDraw::getInstance().getEnabledData());
+#endif
 
             if (ImGui::BeginMenu("Theme")) {
                 // Llama a tu setupGUIStyle() para cambiar
@@ -360,7 +661,17 @@ void EngineGUI::barMenu() {
         }
 
         if (ImGui::BeginMenu("Tools")) {
-            if (ImGui::MenuItem("Reload Assets", "F5")) { /* TODO */ }
+            if (ImGui::MenuItem("Reload Assets", "F5")) { ResourceManager::getInstance().reloadAll(); }
+            bool hotReload = ResourceManager::getInstance().isHotReloadEnabled();
+            if (ImGui::MenuItem("Watch Asset Files", nullptr, &hotReload)) {
+                ResourceManager::getInstance().setHotReload(hotReload);
+            }
+#if ENGINE_PROFILER
+            Profiler& profiler = Profiler::getInstance();
+            if (ImGui::MenuItem("Capture Trace (300 frames)", nullptr, false, !profiler.isCapturing())) {
+                profiler.startCapture(300, "frame_trace.json");
+            }
+#endif
             if (ImGui::MenuItem("Bake Lighting")) { /* TODO */ }
             ImGui::EndMenu();
         }
@@ -373,6 +684,21 @@ void EngineGUI::barMenu() {
         ImGui::EndMainMenuBar();
     }
 
+    if (show_prof) {
+        profiler(&show_prof);
+    }
+    if (show_mem) {
+        memory(&show_mem);
+    }
+    if (show_console) {
+        console(&show_console);
+    }
+
+    //atajo del menu Tools
+    if (ImGui::IsKeyPressed(ImGuiKey_F5, false) && !ImGui::GetIO().WantTextInput) {
+        ResourceManager::getInstance().reloadAll();
+    }
+
     // Ejemplo: mostrar la demo si est activada
     // if (show_demo) ImGui::ShowDemoWindow(&show_demo);
 }
@@ -436,6 +762,366 @@ void EngineGUI::leaderboard(
     ImGui::End();
 }
 
+void
+EngineGUI::cameras(std::vector<Camera>& cameras) {
+    ImGui::Begin("Cameras");
+
+    if (cameras.empty()) {
+        ImGui::TextDisabled("No cameras.");
+        ImGui::End();
+        return;
+    }
+
+    const char* modes[] = { "Free", "Follow leader", "Follow selected" };
+    for (int i = 0; i < (int)cameras.size(); ++i) {
+        Camera& camera = cameras[i];
+        ImGui::PushID(i);
+        if (ImGui::CollapsingHeader(camera.getName().c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::Checkbox("Enabled", camera.getEnabledData());
+
+            int mode = static_cast<int>(camera.getFollowMode());
+            if (ImGui::Combo("Mode", &mode, modes, IM_ARRAYSIZE(modes))) {
+                camera.setFollowMode(static_cast<CameraFollowMode>(mode));
+            }
+
+            float zoom = camera.getTargetZoom();
+            if (ImGui::SliderFloat("Zoom", &zoom, 0.1f, 8.0f, "%.2f", ImGuiSliderFlags_Logarithmic)) {
+                camera.setZoom(zoom);
+            }
+
+            float rate = camera.getFollowRate();
+            if (ImGui::SliderFloat("Follow rate", &rate, 0.0f, 20.0f, "%.1f")) {
+                camera.setFollowRate(rate);
+            }
+
+            // rectangulo visible (el que usa el culling)
+            const sf::FloatRect& visible = camera.getVisibleRect();
+            ImGui::Text("Visible: (%.0f, %.0f) %.0f x %.0f",
+                visible.position.x, visible.position.y, visible.size.x, visible.size.y);
+        }
+        ImGui::PopID();
+    }
+
+    ImGui::End();
+}
+
+#if ENGINE_PROFILER
+namespace {
+    //fila de la tabla del profiler y sus hijos
+    void
+    profilerRow(const Profiler& profiler, int index) {
+        const Profiler::Node& node = profiler.getNodes()[index];
+        const Profiler::Stats stats = profiler.getStats(node);
+        const std::string name = node.name != nullptr ? node.name : profiler.getThreadName(node.thread);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_DefaultOpen;
+        if (node.children.empty()) {
+            flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+        }
+        const bool open = ImGui::TreeNodeEx((void*)(intptr_t)index, flags, "%s", name.c_str());
+        ImGui::TableNextColumn(); ImGui::Text("%u", node.frameCalls);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", node.frameTime / 1e6);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.minMs);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.avgMs);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.maxMs);
+        ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.p99Ms);
+
+        if (open && !node.children.empty()) {
+            for (const int child : node.children) {
+                profilerRow(profiler, child);
+            }
+            ImGui::TreePop();
+        }
+    }
+}
+#endif
+
+void
+EngineGUI::profiler(bool* open) {
+    if (!ImGui::Begin("Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+
+#if ENGINE_PROFILER
+    Profiler& profiler = Profiler::getInstance();
+
+    bool paused = profiler.isPaused();
+    if (ImGui::Checkbox("Pause", &paused)) {
+        profiler.setPaused(paused);
+    }
+    const uint64_t frameStart = profiler.getLastFrameStart();
+    const uint64_t frameEnd = profiler.getLastFrameEnd();
+    const double frameMs = (frameEnd - frameStart) / 1e6;
+    ImGui::SameLine();
+    ImGui::Text("Frame: %.3f ms", frameMs);
+    ImGui::SameLine();
+    ImGui::Text("Dropped: %llu", static_cast<unsigned long long>(profiler.getDroppedCount()));
+
+    static int captureFrames = 300;
+    if (profiler.isCapturing()) {
+        ImGui::Text("Capturing frame %u / %u", profiler.getCapturedFrames(), profiler.getCaptureTarget());
+    }
+    else {
+        ImGui::SetNextItemWidth(120.f);
+        ImGui::InputInt("##captureFrames", &captureFrames);
+        captureFrames = std::max(captureFrames, 1);
+        ImGui::SameLine();
+        if (ImGui::Button("Capture trace")) {
+            profiler.startCapture(static_cast<uint32_t>(captureFrames), "frame_trace.json");
+        }
+    }
+
+    // hilo que se muestra en el flame graph
+    static int thread = 0;
+    const int threadCount = static_cast<int>(profiler.getThreadCount());
+    thread = std::min(thread, std::max(threadCount - 1, 0));
+    const std::string threadName = profiler.getThreadName(static_cast<uint32_t>(thread));
+    if (ImGui::BeginCombo("Thread", threadName.c_str())) {
+        for (int i = 0; i < threadCount; ++i) {
+            const std::string name = profiler.getThreadName(static_cast<uint32_t>(i));
+            ImGui::PushID(i);
+            if (ImGui::Selectable(name.c_str(), i == thread)) {
+                thread = i;
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndCombo();
+    }
+
+    // flame graph del ultimo frame: x = tiempo, y = profundidad
+    const std::vector<Profiler::Event>& events = profiler.getLastFrame();
+    uint32_t maxDepth = 0;
+    for (const Profiler::Event& event : events) {
+        if (event.thread == static_cast<uint32_t>(thread)) {
+            maxDepth = std::max(maxDepth, event.depth);
+        }
+    }
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 size(std::max(ImGui::GetContentRegionAvail().x, 1.f), rowHeight * (maxDepth + 1));
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(30, 30, 30, 255));
+    ImGui::InvisibleButton("flame", size);
+    const bool hovered = ImGui::IsItemHovered();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+    const double span = frameEnd > frameStart ? static_cast<double>(frameEnd - frameStart) : 1.0;
+    for (const Profiler::Event& event : events) {
+        if (event.thread != static_cast<uint32_t>(thread)) {
+            continue;
+        }
+        // los eventos de otros hilos pueden empezar antes del frame
+        const double start = event.start > frameStart ? static_cast<double>(event.start - frameStart) : 0.0;
+        const double end = event.end > frameStart ? static_cast<double>(event.end - frameStart) : 0.0;
+        const float x0 = origin.x + static_cast<float>(std::min(start / span, 1.0)) * size.x;
+        const float x1 = std::max(origin.x + static_cast<float>(std::min(end / span, 1.0)) * size.x, x0 + 1.f);
+        const float y0 = origin.y + event.depth * rowHeight;
+        const float y1 = y0 + rowHeight - 1.f;
+
+        // color estable por nombre
+        const uint64_t hash = StringId::hash(event.name, std::strlen(event.name));
+        const ImU32 color = IM_COL32(110 + (hash & 0x7F), 80 + ((hash >> 8) & 0x5F), 60 + ((hash >> 16) & 0x3F), 255);
+        drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), color);
+        if (x1 - x0 > ImGui::CalcTextSize(event.name).x + 4.f) {
+            drawList->AddText(ImVec2(x0 + 2.f, y0), IM_COL32(255, 255, 255, 255), event.name);
+        }
+        if (hovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1) {
+            ImGui::SetTooltip("%s\n%.3f ms", event.name, (event.end - event.start) / 1e6);
+        }
+    }
+
+    // arbol con estadisticas sobre los ultimos frames
+    ImGui::Text("Last %d frames (ms)", static_cast<int>(Profiler::HISTORY_FRAMES));
+    if (ImGui::BeginTable("prof_table", 7,
+        ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Last");
+        ImGui::TableSetupColumn("Min");
+        ImGui::TableSetupColumn("Avg");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableHeadersRow();
+
+        const std::vector<Profiler::Node>& nodes = profiler.getNodes();
+        for (int i = 0; i < static_cast<int>(nodes.size()); ++i) {
+            if (nodes[i].parent < 0) {
+                profilerRow(profiler, i);
+            }
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextDisabled("Profiler compiled out (ENGINE_PROFILER=0).");
+#endif
+
+    ImGui::End();
+}
+
+#if ENGINE_MEMORY_TRACKING
+namespace {
+    //bytes en la unidad mas legible
+    void
+    textBytes(int64_t bytes) {
+        const double value = static_cast<double>(bytes);
+        if (bytes >= 1024 * 1024 || bytes <= -1024 * 1024) {
+            ImGui::Text("%.2f MB", value / (1024.0 * 1024.0));
+        }
+        else if (bytes >= 1024 || bytes <= -1024) {
+            ImGui::Text("%.1f KB", value / 1024.0);
+        }
+        else {
+            ImGui::Text("%lld B", static_cast<long long>(bytes));
+        }
+    }
+}
+#endif
+
+void
+EngineGUI::memory(bool* open) {
+    if (!ImGui::Begin("Memory", open)) {
+        ImGui::End();
+        return;
+    }
+
+#if ENGINE_MEMORY_TRACKING
+    MemoryTracker& tracker = MemoryTracker::getInstance();
+    const MemoryTracker::Totals totals = tracker.getTotals();
+
+    ImGui::Text("Live:"); ImGui::SameLine(); textBytes(totals.liveBytes);
+    ImGui::SameLine(); ImGui::Text("  Peak:"); ImGui::SameLine(); textBytes(totals.peakBytes);
+    ImGui::Text("Allocations: %llu  Frees: %llu  Live blocks: %llu",
+        static_cast<unsigned long long>(totals.allocations),
+        static_cast<unsigned long long>(totals.frees),
+        static_cast<unsigned long long>(totals.allocations - totals.frees));
+    if (tracker.isSteadyStateAssert()) {
+        ImGui::TextColored(ImVec4(1.f, 0.5f, 0.2f, 1.f), "Steady-state assert armed");
+    }
+
+    // asignaciones por frame, el objetivo en estado estable es 0
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "last frame: %llu allocs, %llu bytes",
+        static_cast<unsigned long long>(totals.frameAllocations),
+        static_cast<unsigned long long>(totals.frameBytes));
+    float maxAllocs = 1.f;
+    for (std::size_t i = 0; i < MemoryTracker::HISTORY_FRAMES; ++i) {
+        maxAllocs = std::max(maxAllocs, tracker.getHistory()[i]);
+    }
+    ImGui::PlotHistogram("##allocs", tracker.getHistory(), static_cast<int>(MemoryTracker::HISTORY_FRAMES),
+        tracker.getHistoryOffset(), overlay, 0.f, maxAllocs * 1.1f, ImVec2(ImGui::GetContentRegionAvail().x, 80.f));
+
+    // tipos ordenados; el buffer se reutiliza para no asignar cada frame
+    static std::vector<MemoryTracker::TypeStats> types;
+    static int sortBy = 0;
+    tracker.getTypeStats(types);
+    ImGui::Combo("Sort by", &sortBy, "Live bytes\0Allocations this frame\0Total allocations\0Peak bytes\0");
+    std::sort(types.begin(), types.end(), [](const MemoryTracker::TypeStats& a, const MemoryTracker::TypeStats& b) {
+        switch (sortBy) {
+        case 1: return a.frameAllocations > b.frameAllocations;
+        case 2: return a.allocations > b.allocations;
+        case 3: return a.peakBytes > b.peakBytes;
+        default: return a.liveBytes > b.liveBytes;
+        }
+    });
+
+    if (ImGui::BeginTable("mem_table", 7,
+        ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("Live");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableSetupColumn("Objects");
+        ImGui::TableSetupColumn("Allocs");
+        ImGui::TableSetupColumn("Frame");
+        ImGui::TableHeadersRow();
+
+        for (const MemoryTracker::TypeStats& type : types) {
+            if (type.allocations == 0) {
+                continue;
+            }
+            // typeid de MSVC antepone "class " o "struct "
+            const char* name = type.name;
+            if (std::strncmp(name, "class ", 6) == 0) {
+                name += 6;
+            }
+            else if (std::strncmp(name, "struct ", 7) == 0) {
+                name += 7;
+            }
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", type.size);
+            ImGui::TableNextColumn(); textBytes(type.liveBytes);
+            ImGui::TableNextColumn(); textBytes(type.peakBytes);
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(type.allocations - type.frees));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(type.allocations));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(type.frameAllocations));
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextDisabled("Memory tracking compiled out (ENGINE_MEMORY_TRACKING=0).");
+#endif
+
+    ImGui::End();
+}
+
+void
+EngineGUI::frameStats(const FrameStats& stats) {
+    ImGui::Begin("Frame Stats");
+
+    static int channel = FRAME_STAT_FRAME;
+    const char* names[FRAME_STAT_COUNT];
+    for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+        names[c] = FrameStats::getChannelName(static_cast<FrameStatChannel>(c));
+    }
+    ImGui::Combo("Graph", &channel, names, FRAME_STAT_COUNT);
+
+    // grafica de la ventana con referencias a 60 y 30 fps
+    const FrameStats::Summary window = stats.getWindowSummary(static_cast<FrameStatChannel>(channel));
+    const float scale = std::max(33.4f, static_cast<float>(window.max) * 1.1f);
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "p99 %.2f ms  max %.2f ms", window.p99, window.max);
+    const ImVec2 graphPos = ImGui::GetCursorScreenPos();
+    const ImVec2 graphSize(ImGui::GetContentRegionAvail().x, 100.f);
+    ImGui::PlotLines("##frametimes", stats.getWindowData(static_cast<FrameStatChannel>(channel)),
+        static_cast<int>(FrameStats::WINDOW_FRAMES), stats.getWindowOffset(), overlay, 0.f, scale, graphSize);
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (const float budget : { 16.7f, 33.3f }) {
+        const float y = graphPos.y + graphSize.y * (1.f - budget / scale);
+        drawList->AddLine(ImVec2(graphPos.x, y), ImVec2(graphPos.x + graphSize.x, y), IM_COL32(255, 80, 80, 120));
+    }
+
+    if (ImGui::BeginTable("fs_table", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+                const FrameStatChannel id = static_cast<FrameStatChannel>(c);
+                const FrameStats::Summary summary = pass == 0 ? stats.getWindowSummary(id) : stats.getTotalSummary(id);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s%s", names[c], pass == 0 ? "" : " (run)");
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", summary.p50);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", summary.p95);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", summary.p99);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", summary.max);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::Text("Last %d frames / %zu frames total", static_cast<int>(FrameStats::WINDOW_FRAMES), stats.getFrameCount());
+
+    ImGui::End();
+}
+
 void
 EngineGUI::destroy() {
 	ImGui::SFML::Shutdown();
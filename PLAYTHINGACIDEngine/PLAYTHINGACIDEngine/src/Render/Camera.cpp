@@ -0,0 +1,147 @@
+#include "Render/Camera.h"
+#include <cmath>
+#include <algorithm>
+
+Camera::Camera(const std::string& name, const sf::Vector2u& targetSize)
+ : m_name(name), m_targetSize(targetSize) {
+ m_center = { targetSize.x * 0.5f, targetSize.y * 0.5f };
+ m_target = m_center;
+ rebuild();
+}
+
+void
+Camera::update(float deltaTime) {
+ //suavizado exponencial: independiente del framerate
+ if (m_followMode != CAMERA_FREE && m_hasTarget) {
+  const float t = 1.f - std::exp(-m_followRate * deltaTime);
+  m_center += (m_target - m_center) * t;
+ }
+
+ const float z = 1.f - std::exp(-m_zoomRate * deltaTime);
+ m_zoom += (m_targetZoom - m_zoom) * z;
+
+ rebuild();
+}
+
+void
+Camera::setTarget(const sf::Vector2f& target) {
+ //el primer target coloca la camara directamente
+ if (!m_hasTarget) {
+  m_center = target;
+ }
+ m_target = target;
+ m_hasTarget = true;
+}
+
+void
+Camera::setCenter(const sf::Vector2f& center) {
+ m_center = center;
+ m_target = center;
+ rebuild();
+}
+
+void
+Camera::setZoom(float zoom) {
+ m_targetZoom = std::clamp(zoom, m_minZoom, m_maxZoom);
+}
+
+void
+Camera::snapZoom(float zoom) {
+ setZoom(zoom);
+ m_zoom = m_targetZoom;
+ rebuild();
+}
+
+void
+Camera::setZoomLimits(float minZoom, float maxZoom) {
+ if (minZoom <= 0.f || maxZoom < minZoom) {
+  ERROR("Camera", "setZoomLimits", "Invalid zoom range");
+  return;
+ }
+ m_minZoom = minZoom;
+ m_maxZoom = maxZoom;
+ m_targetZoom = std::clamp(m_targetZoom, m_minZoom, m_maxZoom);
+ m_zoom = std::clamp(m_zoom, m_minZoom, m_maxZoom);
+}
+
+void
+Camera::fitRect(const sf::FloatRect& worldRect) {
+ if (worldRect.size.x <= 0.f || worldRect.size.y <= 0.f) {
+  return;
+ }
+ const float pixelsX = m_targetSize.x * m_viewport.size.x;
+ const float pixelsY = m_targetSize.y * m_viewport.size.y;
+ snapZoom(std::min(pixelsX / worldRect.size.x, pixelsY / worldRect.size.y));
+ setCenter(worldRect.position + worldRect.size * 0.5f);
+}
+
+void
+Camera::setViewport(const sf::FloatRect& viewport) {
+ m_viewport = viewport;
+ rebuild();
+}
+
+void
+Camera::setTargetSize(const sf::Vector2u& targetSize) {
+ m_targetSize = { std::max(targetSize.x, 1u), std::max(targetSize.y, 1u) };
+ rebuild();
+}
+
+void
+Camera::setWorldBounds(const sf::FloatRect& bounds) {
+ m_worldBounds = bounds;
+ rebuild();
+}
+
+bool
+Camera::isVisible(const sf::FloatRect& worldRect) const {
+ return m_visibleRect.findIntersection(worldRect).has_value();
+}
+
+sf::Vector2f
+Camera::worldToScreen(const sf::Vector2f& world) const {
+ const sf::Vector2f local = world - m_visibleRect.position;
+ return { (m_viewport.position.x + local.x / m_visibleRect.size.x * m_viewport.size.x) * m_targetSize.x,
+          (m_viewport.position.y + local.y / m_visibleRect.size.y * m_viewport.size.y) * m_targetSize.y };
+}
+
+sf::Vector2f
+Camera::screenToWorld(const sf::Vector2f& screen) const {
+ const sf::Vector2f normalized = { screen.x / m_targetSize.x, screen.y / m_targetSize.y };
+ return { m_visibleRect.position.x + (normalized.x - m_viewport.position.x) / m_viewport.size.x * m_visibleRect.size.x,
+          m_visibleRect.position.y + (normalized.y - m_viewport.position.y) / m_viewport.size.y * m_visibleRect.size.y };
+}
+
+bool
+Camera::containsScreenPoint(const sf::Vector2f& screen) const {
+ return m_viewport.contains({ screen.x / m_targetSize.x, screen.y / m_targetSize.y });
+}
+
+sf::Vector2f
+Camera::visibleSize() const {
+ return { m_targetSize.x * m_viewport.size.x / m_zoom,
+          m_targetSize.y * m_viewport.size.y / m_zoom };
+}
+
+void
+Camera::rebuild() {
+ const sf::Vector2f size = visibleSize();
+
+ //si el mundo es mas chico que la vista se centra en ese eje
+ if (m_worldBounds.size.x > 0.f && m_worldBounds.size.y > 0.f) {
+  const sf::Vector2f half = size * 0.5f;
+  const sf::Vector2f minB = m_worldBounds.position;
+  const sf::Vector2f maxB = m_worldBounds.position + m_worldBounds.size;
+  m_center.x = size.x >= m_worldBounds.size.x
+             ? minB.x + m_worldBounds.size.x * 0.5f
+             : std::clamp(m_center.x, minB.x + half.x, maxB.x - half.x);
+  m_center.y = size.y >= m_worldBounds.size.y
+             ? minB.y + m_worldBounds.size.y * 0.5f
+             : std::clamp(m_center.y, minB.y + half.y, maxB.y - half.y);
+ }
+
+ m_view.setCenter(m_center);
+ m_view.setSize(size);
+ m_view.setViewport(m_viewport);
+ m_visibleRect = sf::FloatRect(m_center - size * 0.5f, size);
+}
@@ -0,0 +1,113 @@
+#include "Render/DebugDraw.h"
+
+#if ENGINE_DEBUG_DRAW
+
+#include "Render/Camera.h"
+#include "Render/DrawCommandList.h"
+#include <imgui.h>
+#include <cmath>
+
+void
+DebugDraw::line(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color& color) {
+ if (!m_enabled) {
+  return;
+ }
+ m_lines.push_back(sf::Vertex{ from, color });
+ m_lines.push_back(sf::Vertex{ to, color });
+}
+
+void
+DebugDraw::circle(const sf::Vector2f& center, float radius, const sf::Color& color, int segments) {
+ if (!m_enabled || segments < 3) {
+  return;
+ }
+ const float step = 6.2831853f / static_cast<float>(segments);
+ sf::Vector2f prev(center.x + radius, center.y);
+ for (int i = 1; i <= segments; ++i) {
+  const float angle = step * static_cast<float>(i);
+  const sf::Vector2f next(center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius);
+  m_lines.push_back(sf::Vertex{ prev, color });
+  m_lines.push_back(sf::Vertex{ next, color });
+  prev = next;
+ }
+}
+
+void
+DebugDraw::arrow(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Color& color, float headSize) {
+ if (!m_enabled) {
+  return;
+ }
+ line(from, to, color);
+
+ const sf::Vector2f dir = to - from;
+ const float length = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+ if (length <= 0.0001f) {
+  return;
+ }
+ //dos trazos a +-150 grados de la direccion
+ const sf::Vector2f unit = dir / length;
+ const sf::Vector2f normal(-unit.y, unit.x);
+ const float head = std::min(headSize, length * 0.5f);
+ line(to, to - unit * head + normal * (head * 0.5f), color);
+ line(to, to - unit * head - normal * (head * 0.5f), color);
+}
+
+void
+DebugDraw::rect(const sf::FloatRect& rect, const sf::Color& color) {
+ if (!m_enabled) {
+  return;
+ }
+ const sf::Vector2f a = rect.position;
+ const sf::Vector2f b(rect.position.x + rect.size.x, rect.position.y);
+ const sf::Vector2f c = rect.position + rect.size;
+ const sf::Vector2f d(rect.position.x, rect.position.y + rect.size.y);
+ line(a, b, color);
+ line(b, c, color);
+ line(c, d, color);
+ line(d, a, color);
+}
+
+void
+DebugDraw::text(const sf::Vector2f& position, const std::string& text, const sf::Color& color) {
+ if (!m_enabled) {
+  return;
+ }
+ //cruz en el punto y etiqueta para la pasada de ImGui
+ const float s = 4.f;
+ line({ position.x - s, position.y }, { position.x + s, position.y }, color);
+ line({ position.x, position.y - s }, { position.x, position.y + s }, color);
+ m_texts.push_back({ position, color, text });
+}
+
+void
+DebugDraw::record(DrawCommandList& commandList) const {
+ if (!m_enabled || m_lines.empty()) {
+  return;
+ }
+ commandList.addVertices(m_lines.data(), m_lines.size(), sf::PrimitiveType::Lines);
+}
+
+void
+DebugDraw::drawText(const Camera& camera) const {
+ if (!m_enabled || m_texts.empty()) {
+  return;
+ }
+ ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+ for (const TextMarker& marker : m_texts) {
+  if (!camera.getVisibleRect().contains(marker.position)) {
+   continue;
+  }
+  const sf::Vector2f screen = camera.worldToScreen(marker.position);
+  drawList->AddText(ImVec2(screen.x + 6.f, screen.y - 6.f),
+                    IM_COL32(marker.color.r, marker.color.g, marker.color.b, marker.color.a),
+                    marker.text.c_str());
+ }
+}
+
+void
+DebugDraw::clear() {
+ m_lines.clear();
+ m_texts.clear();
+}
+
+#endif
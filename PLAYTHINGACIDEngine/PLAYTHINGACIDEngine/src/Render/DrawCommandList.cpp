@@ -0,0 +1,156 @@
+#include "Render/DrawCommandList.h"
+#include "Window.h"
+
+void
+DrawCommandList::clear() {
+ m_vertices.clear();
+ m_batches.clear();
+ m_views.clear();
+ m_currentView = -1;
+ m_hasGui = false;
+}
+
+void
+DrawCommandList::setView(const sf::View& view) {
+ m_views.push_back(view);
+ m_currentView = static_cast<int>(m_views.size()) - 1;
+}
+
+DrawBatch&
+DrawCommandList::batchFor(sf::PrimitiveType type, const sf::Texture* texture, const sf::BlendMode& blendMode) {
+ //solo las listas independientes se pueden concatenar
+ const bool mergeable = (type == sf::PrimitiveType::Triangles ||
+                         type == sf::PrimitiveType::Lines ||
+                         type == sf::PrimitiveType::Points);
+ if (mergeable && !m_batches.empty()) {
+  DrawBatch& last = m_batches.back();
+  if (last.type == type && last.texture == texture && last.view == m_currentView
+      && last.blendMode == blendMode) {
+   return last;
+  }
+ }
+ DrawBatch batch;
+ batch.texture = texture;
+ batch.type = type;
+ batch.first = m_vertices.size();
+ batch.count = 0;
+ batch.view = m_currentView;
+ batch.blendMode = blendMode;
+ m_batches.push_back(batch);
+ return m_batches.back();
+}
+
+void
+DrawCommandList::addShape(const sf::Shape& shape, const sf::BlendMode& blendMode) {
+ if (shape.getPointCount() < 3) {
+  return;
+ }
+ DrawBatch& batch = batchFor(sf::PrimitiveType::Triangles, shape.getTexture(), blendMode);
+ batch.count += tessellateShape(shape, m_vertices);
+}
+
+std::size_t
+DrawCommandList::tessellateShape(const sf::Shape& shape, std::vector<sf::Vertex>& out) {
+ const std::size_t pointCount = shape.getPointCount();
+ if (pointCount < 3) {
+  return 0;
+ }
+
+ //bounds locales para mapear las coordenadas de textura (igual que sf::Shape)
+ sf::Vector2f minP = shape.getPoint(0);
+ sf::Vector2f maxP = minP;
+ for (std::size_t i = 1; i < pointCount; ++i) {
+  const sf::Vector2f p = shape.getPoint(i);
+  minP.x = std::min(minP.x, p.x); minP.y = std::min(minP.y, p.y);
+  maxP.x = std::max(maxP.x, p.x); maxP.y = std::max(maxP.y, p.y);
+ }
+ const sf::Vector2f size = maxP - minP;
+ const sf::FloatRect texRect(shape.getTextureRect());
+ const sf::Transform& transform = shape.getTransform();
+ const sf::Color color = shape.getFillColor();
+
+ auto makeVertex = [&](const sf::Vector2f& p) {
+  const float xr = size.x > 0.f ? (p.x - minP.x) / size.x : 0.f;
+  const float yr = size.y > 0.f ? (p.y - minP.y) / size.y : 0.f;
+  return sf::Vertex{ transform.transformPoint(p),
+                     color,
+                     { texRect.position.x + texRect.size.x * xr,
+                       texRect.position.y + texRect.size.y * yr } };
+ };
+
+ //abanico convexo -> lista de triangulos (permite juntar varias shapes en un draw)
+ const sf::Vertex origin = makeVertex(shape.getPoint(0));
+ sf::Vertex prev = makeVertex(shape.getPoint(1));
+ for (std::size_t i = 2; i < pointCount; ++i) {
+  const sf::Vertex next = makeVertex(shape.getPoint(i));
+  out.push_back(origin);
+  out.push_back(prev);
+  out.push_back(next);
+  prev = next;
+ }
+ return (pointCount - 2) * 3;
+}
+
+void
+DrawCommandList::addVertices(const sf::Vertex* vertices,
+                             std::size_t count,
+                             sf::PrimitiveType type,
+                             const sf::Texture* texture,
+                             const sf::BlendMode& blendMode) {
+ if (vertices == nullptr || count == 0) {
+  return;
+ }
+ DrawBatch& batch = batchFor(type, texture, blendMode);
+ m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+ batch.count += count;
+}
+
+sf::Vertex*
+DrawCommandList::beginVertices(std::size_t maxCount,
+                               sf::PrimitiveType type,
+                               const sf::Texture* texture,
+                               const sf::BlendMode& blendMode) {
+ batchFor(type, texture, blendMode);
+ m_pendingBatch = m_batches.size() - 1;
+ m_pendingFirst = m_vertices.size();
+ m_vertices.resize(m_pendingFirst + maxCount);
+ return m_vertices.data() + m_pendingFirst;
+}
+
+void
+DrawCommandList::endVertices(std::size_t usedCount) {
+ const std::size_t reserved = m_vertices.size() - m_pendingFirst;
+ if (usedCount > reserved) {
+  usedCount = reserved;
+ }
+ m_vertices.resize(m_pendingFirst + usedCount);
+ m_batches[m_pendingBatch].count += usedCount;
+}
+
+void
+DrawCommandList::execute(Window& window) const {
+ int activeView = -1;
+ for (const DrawBatch& batch : m_batches) {
+  if (batch.count == 0) {
+   continue;
+  }
+  if (batch.view != activeView) {
+   activeView = batch.view;
+   if (activeView < 0) {
+    window.resetView();
+   }
+   else {
+    window.setView(m_views[activeView]);
+   }
+  }
+  sf::RenderStates states;
+  states.texture = batch.texture;
+  states.blendMode = batch.blendMode;
+  window.draw(&m_vertices[batch.first], batch.count, batch.type, states);
+ }
+
+ //la GUI y el siguiente frame usan la vista por defecto
+ if (activeView >= 0) {
+  window.resetView();
+ }
+}
@@ -0,0 +1,391 @@
+#include "Render/ParticleSystem.h"
+#include "Render/DrawCommandList.h"
+#include "Actor.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_PARTICLES_SSE2 1
+#include <emmintrin.h>
+#else
+#define ENGINE_PARTICLES_SSE2 0
+#endif
+
+namespace {
+
+ constexpr float kDegToRad = 3.14159265f / 180.f;
+
+ inline uint32_t
+  packColor(const sf::Color& c) {
+  return uint32_t(c.r) | (uint32_t(c.g) << 8) | (uint32_t(c.b) << 16) | (uint32_t(c.a) << 24);
+ }
+
+ //interpolacion por canal con peso de 8 bits
+ inline sf::Color
+  lerpColor(uint32_t a, uint32_t b, uint32_t t) {
+  auto channel = [t](uint32_t ca, uint32_t cb) {
+   return static_cast<std::uint8_t>((ca * (256 - t) + cb * t) >> 8);
+  };
+  return sf::Color(channel(a & 0xFF, b & 0xFF),
+                   channel((a >> 8) & 0xFF, (b >> 8) & 0xFF),
+                   channel((a >> 16) & 0xFF, (b >> 16) & 0xFF),
+                   channel(a >> 24, b >> 24));
+ }
+
+ inline std::size_t
+  padded(std::size_t count) {
+  return (count + 3) & ~std::size_t(3);
+ }
+
+}
+
+ParticleSystem::ParticleSystem(std::size_t maxEmitters)
+ : m_maxEmitters(maxEmitters),
+   m_emitterDesc(maxEmitters),
+   m_emitterLayer(maxEmitters, -1),
+   m_emitterPos(maxEmitters),
+   m_emitterPrevPos(maxEmitters),
+   m_emitterOffset(maxEmitters),
+   m_emitterAccum(maxEmitters, 0.f),
+   m_emitterAlive(maxEmitters, 0),
+   m_emitterActive(maxEmitters, 0),
+   m_emitterParent(maxEmitters) {
+ //los slots libres se toman desde el principio
+ m_freeEmitters.reserve(maxEmitters);
+ for (std::size_t i = maxEmitters; i > 0; --i) {
+  m_freeEmitters.push_back(static_cast<int>(i - 1));
+ }
+}
+
+int
+ParticleSystem::createLayer(const std::string& name, std::size_t capacity, const sf::Texture* texture) {
+ ParticleLayer layer;
+ layer.name = name;
+ layer.texture = texture;
+ if (texture != nullptr) {
+  layer.texSize = sf::Vector2f(texture->getSize());
+ }
+ layer.capacity = capacity;
+
+ const std::size_t size = padded(capacity);
+ for (std::vector<float>* stream : { &layer.posX, &layer.posY, &layer.velX, &layer.velY,
+                                     &layer.age, &layer.invLife, &layer.drag, &layer.gravity,
+                                     &layer.sizeStart, &layer.sizeEnd, &layer.stretch }) {
+  stream->assign(size, 0.f);
+ }
+ layer.colorStart.assign(size, 0);
+ layer.colorEnd.assign(size, 0);
+
+ m_layers.push_back(std::move(layer));
+ return static_cast<int>(m_layers.size()) - 1;
+}
+
+int
+ParticleSystem::createEmitter(int layer, const ParticleEmitterDesc& desc) {
+ if (layer < 0 || layer >= static_cast<int>(m_layers.size())) {
+  ERROR("ParticleSystem", "createEmitter", "Invalid particle layer");
+  return -1;
+ }
+ if (m_freeEmitters.empty()) {
+  return -1;
+ }
+ const int id = m_freeEmitters.back();
+ m_freeEmitters.pop_back();
+
+ m_emitterDesc[id] = desc;
+ m_emitterLayer[id] = layer;
+ m_emitterPos[id] = { 0.f, 0.f };
+ m_emitterPrevPos[id] = { 0.f, 0.f };
+ m_emitterOffset[id] = { 0.f, 0.f };
+ m_emitterAccum[id] = 0.f;
+ m_emitterAlive[id] = 1;
+ m_emitterActive[id] = 1;
+ m_emitterParent[id].reset();
+ return id;
+}
+
+void
+ParticleSystem::destroyEmitter(int emitter) {
+ if (emitter < 0 || emitter >= static_cast<int>(m_maxEmitters) || !m_emitterAlive[emitter]) {
+  return;
+ }
+ m_emitterAlive[emitter] = 0;
+ m_emitterActive[emitter] = 0;
+ m_emitterParent[emitter].reset();
+ m_freeEmitters.push_back(emitter);
+}
+
+void
+ParticleSystem::attachEmitter(int emitter,
+                              const EngineUtilities::TSharedPointer<Actor>& actor,
+                              const sf::Vector2f& offset) {
+ if (emitter < 0 || emitter >= static_cast<int>(m_maxEmitters) || !m_emitterAlive[emitter]) {
+  return;
+ }
+ m_emitterParent[emitter] = actor ? actor->getComponent<CShape>()
+                                  : EngineUtilities::TSharedPointer<CShape>();
+ m_emitterOffset[emitter] = offset;
+
+ //arranca en la posicion del actor para no dejar una estela desde el origen
+ if (m_emitterParent[emitter]) {
+  const sf::FloatRect bounds = m_emitterParent[emitter]->getGlobalBounds();
+  m_emitterPos[emitter] = bounds.position + bounds.size * 0.5f + offset;
+  m_emitterPrevPos[emitter] = m_emitterPos[emitter];
+ }
+}
+
+void
+ParticleSystem::setEmitterPosition(int emitter, const sf::Vector2f& position) {
+ if (emitter >= 0 && emitter < static_cast<int>(m_maxEmitters) && m_emitterAlive[emitter]) {
+  //salto directo: sin estela entre la posicion anterior y la nueva
+  m_emitterPos[emitter] = position;
+  m_emitterPrevPos[emitter] = position;
+ }
+}
+
+void
+ParticleSystem::setEmitterActive(int emitter, bool active) {
+ if (emitter >= 0 && emitter < static_cast<int>(m_maxEmitters) && m_emitterAlive[emitter]) {
+  m_emitterActive[emitter] = active ? 1 : 0;
+ }
+}
+
+void
+ParticleSystem::setEmitterDesc(int emitter, const ParticleEmitterDesc& desc) {
+ if (emitter >= 0 && emitter < static_cast<int>(m_maxEmitters) && m_emitterAlive[emitter]) {
+  m_emitterDesc[emitter] = desc;
+ }
+}
+
+void
+ParticleSystem::burst(int emitter, std::size_t count) {
+ if (emitter < 0 || emitter >= static_cast<int>(m_maxEmitters) || !m_emitterAlive[emitter]) {
+  return;
+ }
+ spawn(emitter, count, m_emitterPos[emitter], m_emitterPos[emitter], { 0.f, 0.f });
+}
+
+float
+ParticleSystem::random01() {
+ //xorshift32: suficiente para efectos
+ uint32_t x = m_rngState;
+ x ^= x << 13;
+ x ^= x >> 17;
+ x ^= x << 5;
+ m_rngState = x;
+ return (x >> 8) * (1.f / 16777216.f);
+}
+
+void
+ParticleSystem::spawn(int emitter, std::size_t count, const sf::Vector2f& from, const sf::Vector2f& to,
+                      const sf::Vector2f& motion) {
+ ParticleLayer& layer = m_layers[m_emitterLayer[emitter]];
+ const ParticleEmitterDesc& desc = m_emitterDesc[emitter];
+
+ //si el pool esta lleno las particulas nuevas se descartan
+ count = std::min(count, layer.capacity - layer.count);
+ if (count == 0) {
+  return;
+ }
+
+ float baseAngle = desc.direction * kDegToRad;
+ if (desc.emitBackwards && (motion.x != 0.f || motion.y != 0.f)) {
+  baseAngle = std::atan2(-motion.y, -motion.x);
+ }
+ const float spread = desc.spread * kDegToRad;
+ const uint32_t colorStart = packColor(desc.colorStart);
+ const uint32_t colorEnd = packColor(desc.colorEnd);
+
+ for (std::size_t k = 0; k < count; ++k) {
+  const std::size_t i = layer.count++;
+  //repartir a lo largo del segmento recorrido en el frame
+  const float t = static_cast<float>(k + 1) / static_cast<float>(count);
+  const float angle = baseAngle + (random01() - 0.5f) * spread;
+  const float speed = desc.speedMin + (desc.speedMax - desc.speedMin) * random01();
+  const float life = desc.lifetimeMin + (desc.lifetimeMax - desc.lifetimeMin) * random01();
+
+  layer.posX[i] = from.x + (to.x - from.x) * t;
+  layer.posY[i] = from.y + (to.y - from.y) * t;
+  layer.velX[i] = std::cos(angle) * speed + motion.x * desc.inheritVelocity;
+  layer.velY[i] = std::sin(angle) * speed + motion.y * desc.inheritVelocity;
+  layer.age[i] = 0.f;
+  layer.invLife[i] = life > 0.f ? 1.f / life : 1000.f;
+  layer.drag[i] = desc.drag;
+  layer.gravity[i] = desc.gravity;
+  layer.sizeStart[i] = desc.sizeStart;
+  layer.sizeEnd[i] = desc.sizeEnd;
+  layer.stretch[i] = desc.stretch;
+  layer.colorStart[i] = colorStart;
+  layer.colorEnd[i] = colorEnd;
+ }
+}
+
+void
+ParticleSystem::update(float deltaTime) {
+ if (deltaTime <= 0.f) {
+  return;
+ }
+
+ //emisores: seguir al actor y acumular particulas pendientes
+ for (std::size_t e = 0; e < m_maxEmitters; ++e) {
+  if (!m_emitterAlive[e]) {
+   continue;
+  }
+  if (m_emitterParent[e]) {
+   const sf::FloatRect bounds = m_emitterParent[e]->getGlobalBounds();
+   m_emitterPos[e] = bounds.position + bounds.size * 0.5f + m_emitterOffset[e];
+  }
+  const sf::Vector2f from = m_emitterPrevPos[e];
+  const sf::Vector2f to = m_emitterPos[e];
+  m_emitterPrevPos[e] = to;
+
+  if (!m_emitterActive[e]) {
+   m_emitterAccum[e] = 0.f;
+   continue;
+  }
+  m_emitterAccum[e] += m_emitterDesc[e].rate * deltaTime;
+  const std::size_t count = static_cast<std::size_t>(m_emitterAccum[e]);
+  if (count > 0) {
+   m_emitterAccum[e] -= static_cast<float>(count);
+   spawn(static_cast<int>(e), count, from, to, (to - from) / deltaTime);
+  }
+ }
+
+ for (ParticleLayer& layer : m_layers) {
+  integrate(layer, deltaTime);
+  retire(layer);
+ }
+}
+
+void
+ParticleSystem::integrate(ParticleLayer& layer, float deltaTime) {
+ //los arrays tienen padding a multiplo de 4: no hace falta cola escalar
+ const std::size_t n = padded(layer.count);
+ float* px = layer.posX.data();
+ float* py = layer.posY.data();
+ float* vx = layer.velX.data();
+ float* vy = layer.velY.data();
+ float* age = layer.age.data();
+ const float* invLife = layer.invLife.data();
+ const float* drag = layer.drag.data();
+ const float* gravity = layer.gravity.data();
+
+#if ENGINE_PARTICLES_SSE2
+ const __m128 dt = _mm_set1_ps(deltaTime);
+ const __m128 one = _mm_set1_ps(1.f);
+ const __m128 zero = _mm_setzero_ps();
+ for (std::size_t i = 0; i < n; i += 4) {
+  const __m128 damp = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(drag + i), dt)));
+  __m128 velX = _mm_mul_ps(_mm_loadu_ps(vx + i), damp);
+  __m128 velY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), damp),
+                           _mm_mul_ps(_mm_loadu_ps(gravity + i), dt));
+  _mm_storeu_ps(vx + i, velX);
+  _mm_storeu_ps(vy + i, velY);
+  _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(velX, dt)));
+  _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velY, dt)));
+  _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), _mm_mul_ps(_mm_loadu_ps(invLife + i), dt)));
+ }
+#else
+ for (std::size_t i = 0; i < n; ++i) {
+  const float damp = std::max(0.f, 1.f - drag[i] * deltaTime);
+  vx[i] *= damp;
+  vy[i] = vy[i] * damp + gravity[i] * deltaTime;
+  px[i] += vx[i] * deltaTime;
+  py[i] += vy[i] * deltaTime;
+  age[i] += invLife[i] * deltaTime;
+ }
+#endif
+}
+
+void
+ParticleSystem::retire(ParticleLayer& layer) {
+ std::size_t i = 0;
+ while (i < layer.count) {
+  if (layer.age[i] < 1.f) {
+   ++i;
+   continue;
+  }
+  //swap-remove: la ultima particula viva ocupa el hueco
+  const std::size_t last = --layer.count;
+  layer.posX[i] = layer.posX[last];
+  layer.posY[i] = layer.posY[last];
+  layer.velX[i] = layer.velX[last];
+  layer.velY[i] = layer.velY[last];
+  layer.age[i] = layer.age[last];
+  layer.invLife[i] = layer.invLife[last];
+  layer.drag[i] = layer.drag[last];
+  layer.gravity[i] = layer.gravity[last];
+  layer.sizeStart[i] = layer.sizeStart[last];
+  layer.sizeEnd[i] = layer.sizeEnd[last];
+  layer.stretch[i] = layer.stretch[last];
+  layer.colorStart[i] = layer.colorStart[last];
+  layer.colorEnd[i] = layer.colorEnd[last];
+ }
+}
+
+void
+ParticleSystem::record(DrawCommandList& commandList, const sf::FloatRect* visibleRect) const {
+ for (const ParticleLayer& layer : m_layers) {
+  if (layer.count == 0) {
+   continue;
+  }
+
+  sf::Vertex* out = commandList.beginVertices(layer.count * 6, sf::PrimitiveType::Triangles, layer.texture);
+  sf::Vertex* cursor = out;
+  const sf::Vector2f uv = layer.texSize;
+
+  for (std::size_t i = 0; i < layer.count; ++i) {
+   const float t = std::min(layer.age[i], 1.f);
+   const float half = 0.5f * (layer.sizeStart[i] + (layer.sizeEnd[i] - layer.sizeStart[i]) * t);
+   const sf::Vector2f center(layer.posX[i], layer.posY[i]);
+
+   if (visibleRect != nullptr &&
+       (center.x + half < visibleRect->position.x ||
+        center.y + half < visibleRect->position.y ||
+        center.x - half > visibleRect->position.x + visibleRect->size.x ||
+        center.y - half > visibleRect->position.y + visibleRect->size.y)) {
+    continue;
+   }
+
+   //ejes del quad: cuadrado o estirado segun la velocidad (chispas)
+   sf::Vector2f axisU(half, 0.f);
+   sf::Vector2f axisV(0.f, half);
+   if (layer.stretch[i] > 0.f) {
+    const float speed = std::sqrt(layer.velX[i] * layer.velX[i] + layer.velY[i] * layer.velY[i]);
+    if (speed > 0.0001f) {
+     const sf::Vector2f dir(layer.velX[i] / speed, layer.velY[i] / speed);
+     axisU = dir * (half + speed * layer.stretch[i]);
+     axisV = sf::Vector2f(-dir.y, dir.x) * half;
+    }
+   }
+
+   const sf::Color color = lerpColor(layer.colorStart[i], layer.colorEnd[i],
+                                     static_cast<uint32_t>(t * 256.f));
+   const sf::Vertex a{ center - axisU - axisV, color, { 0.f, 0.f } };
+   const sf::Vertex b{ center + axisU - axisV, color, { uv.x, 0.f } };
+   const sf::Vertex c{ center + axisU + axisV, color, { uv.x, uv.y } };
+   const sf::Vertex d{ center - axisU + axisV, color, { 0.f, uv.y } };
+   cursor[0] = a; cursor[1] = b; cursor[2] = c;
+   cursor[3] = a; cursor[4] = c; cursor[5] = d;
+   cursor += 6;
+  }
+
+  commandList.endVertices(static_cast<std::size_t>(cursor - out));
+ }
+}
+
+void
+ParticleSystem::clearParticles() {
+ for (ParticleLayer& layer : m_layers) {
+  layer.count = 0;
+ }
+}
+
+std::size_t
+ParticleSystem::getLiveCount() const {
+ std::size_t total = 0;
+ for (const ParticleLayer& layer : m_layers) {
+  total += layer.count;
+ }
+ return total;
+}
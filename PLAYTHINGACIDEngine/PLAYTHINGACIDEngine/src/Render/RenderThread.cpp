@@ -0,0 +1,157 @@
+#include "Render/RenderThread.h"
+#include "Window.h"
+#include "EngineGUI.h"
+#include "ResourceManager.h"
+#include "Render/VirtualTexture.h"
+#include "Utilities/StartupTracer.h"
+#include "Utilities/Profiler.h"
+
+RenderThread::~RenderThread() {
+ stop();
+}
+
+bool
+RenderThread::start(const EngineUtilities::TSharedPointer<Window>& window, EngineGUI* engineGUI) {
+ if (isRunning()) {
+  return true;
+ }
+ if (window.isNull()) {
+  ERROR("RenderThread", "start", "Window is null");
+  return false;
+ }
+
+ m_window = window;
+ m_engineGUI = engineGUI;
+ m_writeIndex = 0;
+ m_readyIndex = 1;
+ m_readIndex = 2;
+ m_hasReady = false;
+ m_guiPending = false;
+ m_stopRequested = false;
+
+ //el contexto GL solo puede estar activo en un hilo a la vez
+ if (!m_window->setActive(false)) {
+  ERROR("RenderThread", "start", "Failed to release the window context");
+  return false;
+ }
+
+ m_running.store(true, std::memory_order_release);
+ m_thread = std::thread(&RenderThread::threadMain, this);
+ MESSAGE("RenderThread", "start", "Render thread started");
+ return true;
+}
+
+void
+RenderThread::stop() {
+ if (!isRunning()) {
+  return;
+ }
+ {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stopRequested = true;
+ }
+ m_frameReady.notify_all();
+ if (m_thread.joinable()) {
+  m_thread.join();
+ }
+ m_running.store(false, std::memory_order_release);
+
+ {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_guiPending = false;
+ }
+ m_guiIdle.notify_all();
+
+ //devolver el contexto al hilo que creo la ventana
+ if (!m_window.isNull()) {
+  m_window->setActive(true);
+ }
+}
+
+DrawCommandList&
+RenderThread::beginFrame() {
+ //el slot de escritura es exclusivo de la simulacion, no hace falta lock
+ DrawCommandList& list = m_frames[m_writeIndex];
+ list.clear();
+ return list;
+}
+
+void
+RenderThread::submit() {
+ {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_hasReady) {
+   m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+  }
+  std::swap(m_writeIndex, m_readyIndex);
+  m_hasReady = true;
+  if (m_frames[m_readyIndex].hasGuiPass()) {
+   m_guiPending = true;
+  }
+ }
+ m_frameReady.notify_one();
+}
+
+void
+RenderThread::waitForGuiIdle() {
+ std::unique_lock<std::mutex> lock(m_mutex);
+ m_guiIdle.wait(lock, [this]() { return !m_guiPending || !isRunning(); });
+}
+
+void
+RenderThread::threadMain() {
+ StartupTracer::getInstance().setThreadName("Render thread");
+ PROFILE_THREAD_NAME("Render thread");
+ if (!m_window->setActive(true)) {
+  ERROR("RenderThread", "threadMain", "Failed to activate the window context");
+ }
+
+ for (;;) {
+  {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   m_frameReady.wait(lock, [this]() { return m_hasReady || m_stopRequested; });
+   if (!m_hasReady && m_stopRequested) {
+    break;
+   }
+   std::swap(m_readIndex, m_readyIndex);
+   m_hasReady = false;
+  }
+
+  const DrawCommandList& frame = m_frames[m_readIndex];
+  {
+   PROFILE_SCOPE("Render frame");
+   {
+    //texturas decodificadas en segundo plano, con presupuesto por frame
+    PROFILE_SCOPE("Uploads");
+    ResourceManager::getInstance().processUploads(m_uploadBudget);
+    for (VirtualTexture* texture : m_virtualTextures) {
+     texture->processUploads();
+    }
+   }
+   {
+    PROFILE_SCOPE("Execute");
+    m_window->clear(frame.getClearColor());
+    frame.execute(*m_window);
+    PROFILE_COUNTER("Draw batches", frame.getBatchCount());
+    PROFILE_COUNTER("Vertices", frame.getVertexCount());
+   }
+   if (frame.hasGuiPass() && m_engineGUI != nullptr) {
+    PROFILE_SCOPE("ImGui render");
+    m_engineGUI->render(m_window);
+   }
+   PROFILE_SCOPE("Display");
+   m_window->display();
+  }
+  m_renderedFrames.fetch_add(1, std::memory_order_relaxed);
+
+  if (frame.hasGuiPass()) {
+   {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_guiPending = false;
+   }
+   m_guiIdle.notify_all();
+  }
+ }
+
+ m_window->setActive(false);
+}
@@ -0,0 +1,412 @@
+#include "Render/SoftwareRenderBackend.h"
+#include "Render/DrawCommandList.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_SOFTWARE_SSE2 1
+#include <emmintrin.h>
+#else
+#define ENGINE_SOFTWARE_SSE2 0
+#endif
+
+namespace {
+
+ inline uint32_t
+  packColor(const sf::Color& c) {
+  return uint32_t(c.r) | (uint32_t(c.g) << 8) | (uint32_t(c.b) << 16) | (uint32_t(c.a) << 24);
+ }
+
+ inline uint32_t
+  div255(uint32_t x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+ }
+
+ //blend alpha clasico: rgb = src*a + dst*(1-a), a = a + dstA*(1-a)
+ inline uint32_t
+  blendPixel(uint32_t dst, uint32_t src) {
+  const uint32_t a = src >> 24;
+  if (a == 255) return src;
+  if (a == 0) return dst;
+  const uint32_t inv = 255 - a;
+  uint32_t out = 0;
+  for (int shift = 0; shift < 24; shift += 8) {
+   const uint32_t s = (src >> shift) & 0xFF;
+   const uint32_t d = (dst >> shift) & 0xFF;
+   out |= div255(s * a + d * inv) << shift;
+  }
+  const uint32_t da = dst >> 24;
+  out |= div255(255 * a + da * inv) << 24;
+  return out;
+ }
+
+ inline uint32_t
+  modulate(uint32_t texel, const sf::Color& c) {
+  const uint32_t r = div255((texel & 0xFF) * c.r);
+  const uint32_t g = div255(((texel >> 8) & 0xFF) * c.g);
+  const uint32_t b = div255(((texel >> 16) & 0xFF) * c.b);
+  const uint32_t a = div255((texel >> 24) * c.a);
+  return r | (g << 8) | (b << 16) | (a << 24);
+ }
+
+ //relleno opaco de un span
+ void
+  fillSpan(uint32_t* dst, int count, uint32_t color) {
+  int i = 0;
+#if ENGINE_SOFTWARE_SSE2
+  const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+  for (; i + 4 <= count; i += 4) {
+   _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+  }
+#endif
+  for (; i < count; ++i) dst[i] = color;
+ }
+
+ //span translucido de color plano, 4 pixeles por iteracion
+ void
+  blendSpan(uint32_t* dst, int count, uint32_t color) {
+  const uint32_t a = color >> 24;
+  if (a == 255) { fillSpan(dst, count, color); return; }
+  if (a == 0) return;
+  int i = 0;
+#if ENGINE_SOFTWARE_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  //el canal alfa de la fuente se multiplica como 255 para obtener a + dstA*(1-a)
+  const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color | 0xFF000000u)), zero);
+  const __m128i srcMul = _mm_mullo_epi16(src, _mm_set1_epi16(static_cast<short>(a)));
+  const __m128i inv = _mm_set1_epi16(static_cast<short>(255 - a));
+  const __m128i bias = _mm_set1_epi16(128);
+  for (; i + 4 <= count; i += 4) {
+   const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+   __m128i lo = _mm_add_epi16(_mm_add_epi16(srcMul, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv)), bias);
+   __m128i hi = _mm_add_epi16(_mm_add_epi16(srcMul, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv)), bias);
+   lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+   hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+   _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+  }
+#endif
+  for (; i < count; ++i) dst[i] = blendPixel(dst[i], color);
+ }
+
+ inline float
+  edge(float ax, float ay, float bx, float by, float px, float py) {
+  return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+ }
+
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend(unsigned int width, unsigned int height)
+ : m_width(width), m_height(height),
+   m_pixels(static_cast<std::size_t>(width) * height, 0xFF000000u),
+   m_view(sf::FloatRect({ 0.f, 0.f }, { static_cast<float>(width), static_cast<float>(height) })) {
+ setView(m_view);
+}
+
+void
+SoftwareRenderBackend::setView(const sf::View& view) {
+ m_view = view;
+ const sf::FloatRect& vp = view.getViewport();
+ const int left = static_cast<int>(std::lround(vp.position.x * m_width));
+ const int top = static_cast<int>(std::lround(vp.position.y * m_height));
+ const int width = static_cast<int>(std::lround(vp.size.x * m_width));
+ const int height = static_cast<int>(std::lround(vp.size.y * m_height));
+ //recortar al framebuffer
+ const int x0 = std::clamp(left, 0, static_cast<int>(m_width));
+ const int y0 = std::clamp(top, 0, static_cast<int>(m_height));
+ const int x1 = std::clamp(left + width, 0, static_cast<int>(m_width));
+ const int y1 = std::clamp(top + height, 0, static_cast<int>(m_height));
+ m_clip = sf::IntRect({ x0, y0 }, { x1 - x0, y1 - y0 });
+}
+
+void
+SoftwareRenderBackend::clear(const sf::Color& color) {
+ fillSpan(m_pixels.data(), static_cast<int>(m_pixels.size()), packColor(color));
+}
+
+void
+SoftwareRenderBackend::registerTexture(const sf::Texture* texture, const sf::Image& image) {
+ if (texture == nullptr) {
+  return;
+ }
+ TextureImage& entry = m_textures[texture];
+ entry.width = image.getSize().x;
+ entry.height = image.getSize().y;
+ entry.repeated = texture->isRepeated();
+ entry.texels.resize(static_cast<std::size_t>(entry.width) * entry.height);
+ if (!entry.texels.empty()) {
+  std::memcpy(entry.texels.data(), image.getPixelsPtr(), entry.texels.size() * 4);
+ }
+}
+
+const SoftwareRenderBackend::TextureImage*
+SoftwareRenderBackend::resolveTexture(const sf::Texture* texture) {
+ if (texture == nullptr) {
+  return nullptr;
+ }
+ auto it = m_textures.find(texture);
+ if (it == m_textures.end()) {
+  //primera vez que se usa: copia de la GPU
+  registerTexture(texture, texture->copyToImage());
+  it = m_textures.find(texture);
+ }
+ return it->second.texels.empty() ? nullptr : &it->second;
+}
+
+sf::Image
+SoftwareRenderBackend::getImage() const {
+ return sf::Image({ m_width, m_height }, reinterpret_cast<const std::uint8_t*>(m_pixels.data()));
+}
+
+bool
+SoftwareRenderBackend::saveToFile(const std::string& fileName) const {
+ return getImage().saveToFile(fileName);
+}
+
+void
+SoftwareRenderBackend::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
+ if (const auto* shape = dynamic_cast<const sf::Shape*>(&drawable)) {
+  m_scratch.clear();
+  const std::size_t count = DrawCommandList::tessellateShape(*shape, m_scratch);
+  sf::RenderStates shapeStates = states;
+  shapeStates.texture = shape->getTexture();
+  draw(m_scratch.data(), count, sf::PrimitiveType::Triangles, shapeStates);
+  return;
+ }
+
+ if (const auto* sprite = dynamic_cast<const sf::Sprite*>(&drawable)) {
+  const sf::FloatRect bounds = sprite->getLocalBounds();
+  const sf::FloatRect rect(sprite->getTextureRect());
+  const sf::Transform& t = sprite->getTransform();
+  const sf::Color color = sprite->getColor();
+  const sf::Vector2f p0 = bounds.position;
+  const sf::Vector2f p1 = bounds.position + sf::Vector2f(bounds.size.x, 0.f);
+  const sf::Vector2f p2 = bounds.position + bounds.size;
+  const sf::Vector2f p3 = bounds.position + sf::Vector2f(0.f, bounds.size.y);
+  const sf::Vertex quad[6] = {
+   { t.transformPoint(p0), color, rect.position },
+   { t.transformPoint(p1), color, rect.position + sf::Vector2f(rect.size.x, 0.f) },
+   { t.transformPoint(p2), color, rect.position + rect.size },
+   { t.transformPoint(p0), color, rect.position },
+   { t.transformPoint(p2), color, rect.position + rect.size },
+   { t.transformPoint(p3), color, rect.position + sf::Vector2f(0.f, rect.size.y) },
+  };
+  sf::RenderStates spriteStates = states;
+  spriteStates.texture = &sprite->getTexture();
+  draw(quad, 6, sf::PrimitiveType::Triangles, spriteStates);
+  return;
+ }
+
+ if (const auto* array = dynamic_cast<const sf::VertexArray*>(&drawable)) {
+  if (array->getVertexCount() > 0) {
+   draw(&(*array)[0], array->getVertexCount(), array->getPrimitiveType(), states);
+  }
+  return;
+ }
+
+ if (!m_warnedUnsupported) {
+  m_warnedUnsupported = true;
+  MESSAGE("SoftwareRenderBackend", "draw", "Unsupported drawable type skipped");
+ }
+}
+
+void
+SoftwareRenderBackend::draw(const sf::Vertex* vertices,
+                            std::size_t vertexCount,
+                            sf::PrimitiveType type,
+                            const sf::RenderStates& states) {
+ if (vertices == nullptr || vertexCount == 0 || m_clip.size.x <= 0 || m_clip.size.y <= 0) {
+  return;
+ }
+
+ //mundo -> NDC (view) -> pixeles (viewport), igual que RenderTarget::mapCoordsToPixel
+ const float halfW = m_clip.size.x * 0.5f;
+ const float halfH = m_clip.size.y * 0.5f;
+ sf::Transform ndcToPixel;
+ ndcToPixel.translate({ m_clip.position.x + halfW, m_clip.position.y + halfH });
+ ndcToPixel.scale({ halfW, -halfH });
+ const sf::Transform toPixel = ndcToPixel * m_view.getTransform() * states.transform;
+
+ const TextureImage* texture = resolveTexture(states.texture);
+ float texScaleX = 1.f, texScaleY = 1.f;
+ if (texture != nullptr && states.coordinateType == sf::CoordinateType::Normalized) {
+  texScaleX = static_cast<float>(texture->width);
+  texScaleY = static_cast<float>(texture->height);
+ }
+
+ m_transformed.resize(vertexCount);
+ for (std::size_t i = 0; i < vertexCount; ++i) {
+  const sf::Vector2f p = toPixel.transformPoint(vertices[i].position);
+  m_transformed[i] = { p.x, p.y,
+                       vertices[i].texCoords.x * texScaleX,
+                       vertices[i].texCoords.y * texScaleY,
+                       vertices[i].color };
+ }
+ const RasterVertex* v = m_transformed.data();
+
+ switch (type) {
+  case sf::PrimitiveType::Points:
+   for (std::size_t i = 0; i < vertexCount; ++i) {
+    plot(static_cast<int>(std::floor(v[i].x)), static_cast<int>(std::floor(v[i].y)), packColor(v[i].color));
+   }
+   break;
+  case sf::PrimitiveType::Lines:
+   for (std::size_t i = 0; i + 1 < vertexCount; i += 2) rasterLine(v[i], v[i + 1]);
+   break;
+  case sf::PrimitiveType::LineStrip:
+   for (std::size_t i = 0; i + 1 < vertexCount; ++i) rasterLine(v[i], v[i + 1]);
+   break;
+  case sf::PrimitiveType::Triangles:
+   for (std::size_t i = 0; i + 2 < vertexCount; i += 3) rasterTriangle(v[i], v[i + 1], v[i + 2], texture);
+   break;
+  case sf::PrimitiveType::TriangleStrip:
+   for (std::size_t i = 0; i + 2 < vertexCount; ++i) rasterTriangle(v[i], v[i + 1], v[i + 2], texture);
+   break;
+  case sf::PrimitiveType::TriangleFan:
+   for (std::size_t i = 1; i + 1 < vertexCount; ++i) rasterTriangle(v[0], v[i], v[i + 1], texture);
+   break;
+ }
+}
+
+void
+SoftwareRenderBackend::plot(int x, int y, uint32_t color) {
+ if (x < m_clip.position.x || y < m_clip.position.y ||
+     x >= m_clip.position.x + m_clip.size.x || y >= m_clip.position.y + m_clip.size.y) {
+  return;
+ }
+ uint32_t& dst = m_pixels[static_cast<std::size_t>(y) * m_width + x];
+ dst = blendPixel(dst, color);
+}
+
+void
+SoftwareRenderBackend::rasterLine(const RasterVertex& a, const RasterVertex& b) {
+ //DDA de 1 pixel de ancho, color interpolado
+ const float dx = b.x - a.x;
+ const float dy = b.y - a.y;
+ const int steps = static_cast<int>(std::ceil(std::max(std::fabs(dx), std::fabs(dy))));
+ if (steps == 0) {
+  plot(static_cast<int>(std::floor(a.x)), static_cast<int>(std::floor(a.y)), packColor(a.color));
+  return;
+ }
+ const bool flat = a.color == b.color;
+ const uint32_t flatColor = packColor(a.color);
+ for (int i = 0; i <= steps; ++i) {
+  const float t = static_cast<float>(i) / steps;
+  uint32_t color = flatColor;
+  if (!flat) {
+   const sf::Color c(
+    static_cast<std::uint8_t>(a.color.r + (b.color.r - a.color.r) * t),
+    static_cast<std::uint8_t>(a.color.g + (b.color.g - a.color.g) * t),
+    static_cast<std::uint8_t>(a.color.b + (b.color.b - a.color.b) * t),
+    static_cast<std::uint8_t>(a.color.a + (b.color.a - a.color.a) * t));
+   color = packColor(c);
+  }
+  plot(static_cast<int>(std::floor(a.x + dx * t)), static_cast<int>(std::floor(a.y + dy * t)), color);
+ }
+}
+
+void
+SoftwareRenderBackend::rasterTriangle(const RasterVertex& a,
+                                      const RasterVertex& b,
+                                      const RasterVertex& c,
+                                      const TextureImage* texture) {
+ const RasterVertex* v0 = &a;
+ const RasterVertex* v1 = &b;
+ const RasterVertex* v2 = &c;
+ float area = edge(v0->x, v0->y, v1->x, v1->y, v2->x, v2->y);
+ if (std::fabs(area) < 1e-6f) {
+  return;
+ }
+ if (area < 0.f) {
+  std::swap(v1, v2);
+  area = -area;
+ }
+ const float invArea = 1.f / area;
+
+ const int clipX0 = m_clip.position.x;
+ const int clipX1 = m_clip.position.x + m_clip.size.x - 1;
+ const int minY = std::max(m_clip.position.y,
+                           static_cast<int>(std::floor(std::min({ v0->y, v1->y, v2->y }))));
+ const int maxY = std::min(m_clip.position.y + m_clip.size.y - 1,
+                           static_cast<int>(std::ceil(std::max({ v0->y, v1->y, v2->y }))));
+
+ const bool flatColor = v0->color == v1->color && v1->color == v2->color;
+ const uint32_t solid = packColor(v0->color);
+
+ //aristas en orden (v1,v2) (v2,v0) (v0,v1): w0, w1, w2
+ const RasterVertex* ea[3] = { v1, v2, v0 };
+ const RasterVertex* eb[3] = { v2, v0, v1 };
+
+ for (int y = minY; y <= maxY; ++y) {
+  const float py = y + 0.5f;
+
+  //rango [xs, xe] donde las tres funciones de arista son >= 0
+  float xs = static_cast<float>(clipX0);
+  float xe = static_cast<float>(clipX1);
+  bool empty = false;
+  for (int e = 0; e < 3 && !empty; ++e) {
+   const float D = eb[e]->y - ea[e]->y;
+   const float K = (eb[e]->x - ea[e]->x) * (py - ea[e]->y) + D * ea[e]->x;
+   if (D > 0.f) {
+    xe = std::min(xe, std::floor(K / D - 0.5f));
+   }
+   else if (D < 0.f) {
+    xs = std::max(xs, std::ceil(K / D - 0.5f));
+   }
+   else if (K < 0.f) {
+    empty = true;
+   }
+  }
+  if (empty || xs > xe) {
+   continue;
+  }
+
+  const int x0 = static_cast<int>(xs);
+  const int count = static_cast<int>(xe) - x0 + 1;
+  uint32_t* row = &m_pixels[static_cast<std::size_t>(y) * m_width + x0];
+
+  if (texture == nullptr && flatColor) {
+   blendSpan(row, count, solid);
+   continue;
+  }
+
+  //baricentricas lineales en x: valor inicial + incremento por pixel
+  const float px0 = x0 + 0.5f;
+  float w0 = edge(v1->x, v1->y, v2->x, v2->y, px0, py) * invArea;
+  float w1 = edge(v2->x, v2->y, v0->x, v0->y, px0, py) * invArea;
+  const float dw0 = -(v2->y - v1->y) * invArea;
+  const float dw1 = -(v0->y - v2->y) * invArea;
+
+  for (int i = 0; i < count; ++i, w0 += dw0, w1 += dw1) {
+   const float w2 = 1.f - w0 - w1;
+   sf::Color color = v0->color;
+   if (!flatColor) {
+    color = sf::Color(
+     static_cast<std::uint8_t>(std::clamp(w0 * v0->color.r + w1 * v1->color.r + w2 * v2->color.r, 0.f, 255.f)),
+     static_cast<std::uint8_t>(std::clamp(w0 * v0->color.g + w1 * v1->color.g + w2 * v2->color.g, 0.f, 255.f)),
+     static_cast<std::uint8_t>(std::clamp(w0 * v0->color.b + w1 * v1->color.b + w2 * v2->color.b, 0.f, 255.f)),
+     static_cast<std::uint8_t>(std::clamp(w0 * v0->color.a + w1 * v1->color.a + w2 * v2->color.a, 0.f, 255.f)));
+   }
+   uint32_t src = packColor(color);
+   if (texture != nullptr) {
+    const float u = w0 * v0->u + w1 * v1->u + w2 * v2->u;
+    const float v = w0 * v0->v + w1 * v1->v + w2 * v2->v;
+    int tx = static_cast<int>(std::floor(u));
+    int ty = static_cast<int>(std::floor(v));
+    const int tw = static_cast<int>(texture->width);
+    const int th = static_cast<int>(texture->height);
+    if (texture->repeated) {
+     tx = ((tx % tw) + tw) % tw;
+     ty = ((ty % th) + th) % th;
+    }
+    else {
+     tx = std::clamp(tx, 0, tw - 1);
+     ty = std::clamp(ty, 0, th - 1);
+    }
+    src = modulate(texture->texels[static_cast<std::size_t>(ty) * tw + tx], color);
+   }
+   row[i] = blendPixel(row[i], src);
+  }
+ }
+}
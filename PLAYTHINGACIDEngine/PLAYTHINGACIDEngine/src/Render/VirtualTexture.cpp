@@ -0,0 +1,517 @@
+#include "Render/VirtualTexture.h"
+#include "Render/Camera.h"
+#include "Render/DrawCommandList.h"
+#include "Utilities/JobSystem.h"
+#include "Utilities/StartupTracer.h"
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+
+namespace {
+ /**
+  * @brief Fixed header at the start of a `.vtex` file.
+  */
+ struct
+  VTexHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t width;
+  uint32_t height;
+  uint32_t tileSize;
+  uint32_t levelCount;
+ };
+
+ constexpr uint32_t VTEX_VERSION = 1;
+
+ /** @brief Frames a slot must stay untouched before reuse (frames that may still be drawing it). */
+ constexpr uint64_t FRAMES_IN_FLIGHT = 3;
+
+ /**
+  * @brief Halves an image with a 2x2 box filter (odd edges are clamped).
+  */
+ sf::Image
+  downsample(const sf::Image& source) {
+  const sf::Vector2u size = source.getSize();
+  const sf::Vector2u half(std::max(1u, size.x / 2), std::max(1u, size.y / 2));
+  sf::Image result(half);
+  for (unsigned int y = 0; y < half.y; ++y) {
+   for (unsigned int x = 0; x < half.x; ++x) {
+    const unsigned int sx0 = std::min(x * 2, size.x - 1), sx1 = std::min(x * 2 + 1, size.x - 1);
+    const unsigned int sy0 = std::min(y * 2, size.y - 1), sy1 = std::min(y * 2 + 1, size.y - 1);
+    const sf::Color a = source.getPixel({ sx0, sy0 });
+    const sf::Color b = source.getPixel({ sx1, sy0 });
+    const sf::Color c = source.getPixel({ sx0, sy1 });
+    const sf::Color d = source.getPixel({ sx1, sy1 });
+    result.setPixel({ x, y }, sf::Color(
+     static_cast<uint8_t>((a.r + b.r + c.r + d.r + 2) / 4),
+     static_cast<uint8_t>((a.g + b.g + c.g + d.g + 2) / 4),
+     static_cast<uint8_t>((a.b + b.b + c.b + d.b + 2) / 4),
+     static_cast<uint8_t>((a.a + b.a + c.a + d.a + 2) / 4)));
+   }
+  }
+  return result;
+ }
+}
+
+VirtualTexture::~VirtualTexture() {
+ close();
+}
+
+bool
+VirtualTexture::buildPyramid(const std::string& imageFile, const std::string& outputFile, unsigned int tileSize) {
+ sf::Image level;
+ if (tileSize == 0 || !level.loadFromFile(imageFile)) {
+  return false;
+ }
+
+ //niveles hasta que la imagen cabe en un solo tile
+ std::vector<sf::Vector2u> sizes;
+ sf::Vector2u size = level.getSize();
+ for (;;) {
+  sizes.push_back(size);
+  if (size.x <= tileSize && size.y <= tileSize) {
+   break;
+  }
+  size = sf::Vector2u(std::max(1u, size.x / 2), std::max(1u, size.y / 2));
+ }
+
+ std::size_t tileCount = 0;
+ for (const sf::Vector2u& s : sizes) {
+  tileCount += static_cast<std::size_t>((s.x + tileSize - 1) / tileSize) * ((s.y + tileSize - 1) / tileSize);
+ }
+
+ std::ofstream out(outputFile, std::ios::binary | std::ios::trunc);
+ if (!out) {
+  return false;
+ }
+
+ VTexHeader header;
+ std::memcpy(header.magic, "VTEX", 4);
+ header.version = VTEX_VERSION;
+ header.width = sizes[0].x;
+ header.height = sizes[0].y;
+ header.tileSize = tileSize;
+ header.levelCount = static_cast<uint32_t>(sizes.size());
+ out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+ //la tabla se escribe al final, cuando se conocen los offsets
+ std::vector<TileEntry> table(tileCount);
+ const std::streamoff tableOffset = out.tellp();
+ out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(TileEntry));
+
+ std::size_t entry = 0;
+ for (std::size_t l = 0; l < sizes.size(); ++l) {
+  if (l > 0) {
+   level = downsample(level);
+  }
+  const sf::Vector2u levelSize = level.getSize();
+  for (unsigned int ty = 0; ty * tileSize < levelSize.y; ++ty) {
+   for (unsigned int tx = 0; tx * tileSize < levelSize.x; ++tx) {
+    const sf::Vector2u origin(tx * tileSize, ty * tileSize);
+    const sf::Vector2u extent(std::min(tileSize, levelSize.x - origin.x),
+                              std::min(tileSize, levelSize.y - origin.y));
+    sf::Image tile(extent);
+    if (!tile.copy(level, { 0, 0 }, sf::IntRect(sf::Vector2i(origin), sf::Vector2i(extent)))) {
+     return false;
+    }
+    const std::optional<std::vector<std::uint8_t>> encoded = tile.saveToMemory("png");
+    if (!encoded) {
+     return false;
+    }
+    table[entry].offset = static_cast<uint64_t>(out.tellp());
+    table[entry].size = static_cast<uint32_t>(encoded->size());
+    out.write(reinterpret_cast<const char*>(encoded->data()), encoded->size());
+    ++entry;
+   }
+  }
+ }
+
+ out.seekp(tableOffset);
+ out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(TileEntry));
+ if (!out) {
+  return false;
+ }
+ MESSAGE("VirtualTexture", "buildPyramid", outputFile + " (" + std::to_string(sizes.size()) + " levels, "
+                                            + std::to_string(tileCount) + " tiles)");
+ return true;
+}
+
+void
+VirtualTexture::openOrBuild(const std::string& imageFile, const std::string& fileName, unsigned int cacheTilesPerSide) {
+ if (std::ifstream(fileName)) {
+  if (!open(fileName, cacheTilesPerSide)) {
+   LOG_ERROR("VirtualTexture", "Can't open {}", fileName);
+  }
+  return;
+ }
+
+ //la piramide se genera una sola vez, fuera del hilo principal
+ close();
+ m_buildFile = fileName;
+ m_buildCacheTiles = cacheTilesPerSide;
+ m_buildFinished.store(false, std::memory_order_relaxed);
+ ++m_jobsInFlight;
+ JobSystem::getInstance().submit([this, imageFile, fileName] {
+  {
+   STARTUP_SCOPE("Build pyramid");
+   if (!buildPyramid(imageFile, fileName)) {
+    LOG_ERROR("VirtualTexture", "Can't build {} from {}", fileName, imageFile);
+    std::remove(fileName.c_str());
+   }
+  }
+  {
+   std::lock_guard<std::mutex> lock(m_loadedMutex);
+   m_buildFinished.store(true, std::memory_order_release);
+   --m_jobsInFlight;
+  }
+  m_jobsDone.notify_all();
+ });
+}
+
+bool
+VirtualTexture::open(const std::string& fileName, unsigned int cacheTilesPerSide) {
+ close();
+
+ std::ifstream in(fileName, std::ios::binary);
+ VTexHeader header;
+ if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header))
+     || std::memcmp(header.magic, "VTEX", 4) != 0 || header.version != VTEX_VERSION
+     || header.tileSize == 0 || header.levelCount == 0) {
+  return false;
+ }
+
+ //solo cabecera y tabla: el costo de abrir no depende del tamano de la imagen
+ m_levels.resize(header.levelCount);
+ std::size_t tileCount = 0;
+ for (uint32_t l = 0; l < header.levelCount; ++l) {
+  Level& level = m_levels[l];
+  level.width = std::max(1u, header.width >> l);
+  level.height = std::max(1u, header.height >> l);
+  level.tilesX = (level.width + header.tileSize - 1) / header.tileSize;
+  level.tilesY = (level.height + header.tileSize - 1) / header.tileSize;
+  level.firstEntry = tileCount;
+  tileCount += static_cast<std::size_t>(level.tilesX) * level.tilesY;
+ }
+ m_entries.resize(tileCount);
+ if (!in.read(reinterpret_cast<char*>(m_entries.data()), tileCount * sizeof(TileEntry))) {
+  m_levels.clear();
+  m_entries.clear();
+  return false;
+ }
+
+ m_fileName = fileName;
+ m_imageSize = sf::Vector2u(header.width, header.height);
+ m_tileSize = header.tileSize;
+ m_slotsPerSide = std::max(2u, cacheTilesPerSide);
+ m_slots.assign(static_cast<std::size_t>(m_slotsPerSide) * m_slotsPerSide, Slot());
+ {
+  //el atlas lo crea el hilo que lo dibuja
+  std::lock_guard<std::mutex> lock(m_writesMutex);
+  m_atlasSize = sf::Vector2u(m_slotsPerSide * m_tileSize, m_slotsPerSide * m_tileSize);
+ }
+
+ //el nivel superior queda fijo: siempre hay algo que dibujar mientras llegan los demas
+ const unsigned int top = static_cast<unsigned int>(m_levels.size() - 1);
+ for (unsigned int y = 0; y < m_levels[top].tilesY; ++y) {
+  for (unsigned int x = 0; x < m_levels[top].tilesX; ++x) {
+   sf::Image image;
+   if (loadTile(makeKey(top, x, y), image)) {
+    upload(makeKey(top, x, y), std::move(image), true);
+   }
+  }
+ }
+
+ if (m_worldRect.size.x <= 0.f || m_worldRect.size.y <= 0.f) {
+  m_worldRect = sf::FloatRect({ 0.f, 0.f }, sf::Vector2f(m_imageSize));
+ }
+ return true;
+}
+
+void
+VirtualTexture::close() {
+ //los trabajos en curso apuntan a este objeto
+ {
+  std::unique_lock<std::mutex> lock(m_loadedMutex);
+  m_jobsDone.wait(lock, [this] { return m_jobsInFlight.load() == 0; });
+  m_loaded.clear();
+ }
+ {
+  std::lock_guard<std::mutex> lock(m_writesMutex);
+  m_writes.clear();
+  m_atlasSize = sf::Vector2u();
+ }
+ m_buildFile.clear();
+ m_levels.clear();
+ m_entries.clear();
+ m_slots.clear();
+ m_pageTable.clear();
+ m_requested.clear();
+ m_fileName.clear();
+}
+
+void
+VirtualTexture::update(const std::vector<Camera>& cameras) {
+ if (!m_buildFile.empty() && m_buildFinished.load(std::memory_order_acquire)) {
+  const std::string fileName = m_buildFile;
+  open(fileName, m_buildCacheTiles);
+ }
+ if (!isOpen()) {
+  return;
+ }
+ ++m_frame;
+
+ //subir al cache lo que ya decodificaron los workers, con presupuesto por frame
+ std::vector<LoadedTile> ready;
+ {
+  std::lock_guard<std::mutex> lock(m_loadedMutex);
+  const std::size_t count = std::min<std::size_t>(m_loaded.size(), m_uploadBudget);
+  ready.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+   ready.push_back(std::move(m_loaded[i]));
+  }
+  m_loaded.erase(m_loaded.begin(), m_loaded.begin() + count);
+ }
+ for (LoadedTile& tile : ready) {
+  m_requested.erase(tile.key);
+  if (tile.ok) {
+   upload(tile.key, std::move(tile.image), false);
+  }
+ }
+
+ for (const Camera& camera : cameras) {
+  if (!camera.isEnabled()) {
+   continue;
+  }
+  const unsigned int level = levelFor(camera);
+  unsigned int x0, y0, x1, y1;
+  if (!tileRange(level, camera.getVisibleRect(), x0, y0, x1, y1)) {
+   continue;
+  }
+  for (unsigned int y = y0; y < y1; ++y) {
+   for (unsigned int x = x0; x < x1; ++x) {
+    //el tile y sus ancestros (respaldo mientras carga) se marcan como usados
+    for (unsigned int l = level; l < m_levels.size(); ++l) {
+     const uint64_t key = makeKey(l, x >> (l - level), y >> (l - level));
+     if (m_pageTable.count(key) != 0) {
+      touch(key);
+      break;
+     }
+     if (l == level) {
+      request(key);
+     }
+    }
+   }
+  }
+ }
+}
+
+void
+VirtualTexture::processUploads() {
+ sf::Vector2u size;
+ {
+  std::lock_guard<std::mutex> lock(m_writesMutex);
+  size = m_atlasSize;
+  m_writing.swap(m_writes);
+ }
+ if (size.x == 0 || size.y == 0) {
+  m_writing.clear();
+  return;
+ }
+ if (m_atlas.getSize() != size && !m_atlas.resize(size)) {
+  LOG_ERROR("VirtualTexture", "Can't create the tile cache");
+  m_writing.clear();
+  return;
+ }
+ //los slots escritos no los dibuja ningun frame en vuelo (ver acquireSlot)
+ for (const AtlasWrite& write : m_writing) {
+  m_atlas.update(write.image, write.position);
+ }
+ m_writing.clear();
+}
+
+void
+VirtualTexture::record(DrawCommandList& commandList, const Camera& camera) const {
+ if (!isOpen()) {
+  return;
+ }
+ const unsigned int level = levelFor(camera);
+ unsigned int x0, y0, x1, y1;
+ if (!tileRange(level, camera.getVisibleRect(), x0, y0, x1, y1)) {
+  return;
+ }
+
+ const std::size_t maxVertices = static_cast<std::size_t>(x1 - x0) * (y1 - y0) * 6;
+ sf::Vertex* out = commandList.beginVertices(maxVertices, sf::PrimitiveType::Triangles, &m_atlas);
+ std::size_t used = 0;
+
+ const Level& desired = m_levels[level];
+ const sf::Vector2f worldPerTexel(m_worldRect.size.x / desired.width, m_worldRect.size.y / desired.height);
+ for (unsigned int y = y0; y < y1; ++y) {
+  for (unsigned int x = x0; x < x1; ++x) {
+   //area del tile en texels del nivel deseado (los del borde son mas chicos)
+   const float px0 = static_cast<float>(x * m_tileSize);
+   const float py0 = static_cast<float>(y * m_tileSize);
+   const float px1 = static_cast<float>(std::min((x + 1) * m_tileSize, desired.width));
+   const float py1 = static_cast<float>(std::min((y + 1) * m_tileSize, desired.height));
+
+   //el nivel residente mas fino que cubre el tile
+   for (unsigned int l = level; l < m_levels.size(); ++l) {
+    const unsigned int shift = l - level;
+    const unsigned int ax = x >> shift;
+    const unsigned int ay = y >> shift;
+    const auto it = m_pageTable.find(makeKey(l, ax, ay));
+    if (it == m_pageTable.end()) {
+     continue;
+    }
+    const float scale = 1.f / static_cast<float>(1u << shift);
+    const sf::Vector2f slotOrigin(static_cast<float>((it->second % m_slotsPerSide) * m_tileSize),
+                                  static_cast<float>((it->second / m_slotsPerSide) * m_tileSize));
+    const float u0 = slotOrigin.x + px0 * scale - ax * m_tileSize;
+    const float v0 = slotOrigin.y + py0 * scale - ay * m_tileSize;
+    const float u1 = slotOrigin.x + px1 * scale - ax * m_tileSize;
+    const float v1 = slotOrigin.y + py1 * scale - ay * m_tileSize;
+
+    const sf::Vector2f p0(m_worldRect.position.x + px0 * worldPerTexel.x, m_worldRect.position.y + py0 * worldPerTexel.y);
+    const sf::Vector2f p1(m_worldRect.position.x + px1 * worldPerTexel.x, m_worldRect.position.y + py1 * worldPerTexel.y);
+    const sf::Vertex a{ p0, sf::Color::White, { u0, v0 } };
+    const sf::Vertex b{ { p1.x, p0.y }, sf::Color::White, { u1, v0 } };
+    const sf::Vertex c{ p1, sf::Color::White, { u1, v1 } };
+    const sf::Vertex d{ { p0.x, p1.y }, sf::Color::White, { u0, v1 } };
+    out[used++] = a;
+    out[used++] = b;
+    out[used++] = c;
+    out[used++] = a;
+    out[used++] = c;
+    out[used++] = d;
+    break;
+   }
+  }
+ }
+ commandList.endVertices(used);
+}
+
+unsigned int
+VirtualTexture::levelFor(const Camera& camera) const {
+ //texels de nivel 0 que caen en un pixel de pantalla
+ const float texelsPerUnit = m_imageSize.x / std::max(1.f, m_worldRect.size.x);
+ const float texelsPerPixel = texelsPerUnit / std::max(0.0001f, camera.getPixelsPerUnit());
+ if (texelsPerPixel <= 1.f) {
+  return 0;
+ }
+ const unsigned int level = static_cast<unsigned int>(std::floor(std::log2(texelsPerPixel)));
+ return std::min(level, static_cast<unsigned int>(m_levels.size() - 1));
+}
+
+bool
+VirtualTexture::tileRange(unsigned int level, const sf::FloatRect& worldRect,
+                          unsigned int& x0, unsigned int& y0, unsigned int& x1, unsigned int& y1) const {
+ const std::optional<sf::FloatRect> overlap = worldRect.findIntersection(m_worldRect);
+ if (!overlap) {
+  return false;
+ }
+ const Level& l = m_levels[level];
+ const float tilesPerUnitX = l.width / (m_worldRect.size.x * m_tileSize);
+ const float tilesPerUnitY = l.height / (m_worldRect.size.y * m_tileSize);
+ const float left = (overlap->position.x - m_worldRect.position.x) * tilesPerUnitX;
+ const float top = (overlap->position.y - m_worldRect.position.y) * tilesPerUnitY;
+ const float right = left + overlap->size.x * tilesPerUnitX;
+ const float bottom = top + overlap->size.y * tilesPerUnitY;
+ x0 = std::min(l.tilesX - 1, static_cast<unsigned int>(std::max(0.f, left)));
+ y0 = std::min(l.tilesY - 1, static_cast<unsigned int>(std::max(0.f, top)));
+ x1 = std::min(l.tilesX, static_cast<unsigned int>(std::ceil(right)));
+ y1 = std::min(l.tilesY, static_cast<unsigned int>(std::ceil(bottom)));
+ return x1 > x0 && y1 > y0;
+}
+
+bool
+VirtualTexture::loadTile(uint64_t key, sf::Image& image) const {
+ const unsigned int level = static_cast<unsigned int>(key >> 48);
+ const unsigned int y = static_cast<unsigned int>((key >> 24) & 0xFFFFFF);
+ const unsigned int x = static_cast<unsigned int>(key & 0xFFFFFF);
+ const Level& l = m_levels[level];
+ const TileEntry& entry = m_entries[l.firstEntry + static_cast<std::size_t>(y) * l.tilesX + x];
+
+ //cada carga abre su propio stream: los workers no comparten estado
+ std::ifstream in(m_fileName, std::ios::binary);
+ std::vector<char> bytes(entry.size);
+ if (!in || !in.seekg(static_cast<std::streamoff>(entry.offset))
+     || !in.read(bytes.data(), bytes.size())) {
+  return false;
+ }
+ return image.loadFromMemory(bytes.data(), bytes.size());
+}
+
+void
+VirtualTexture::request(uint64_t key) {
+ if (m_requested.size() >= m_maxPendingLoads || !m_requested.insert(key).second) {
+  return;
+ }
+ ++m_jobsInFlight;
+ JobSystem::getInstance().submit([this, key] {
+  LoadedTile tile;
+  tile.key = key;
+  tile.ok = loadTile(key, tile.image);
+  {
+   std::lock_guard<std::mutex> lock(m_loadedMutex);
+   m_loaded.push_back(std::move(tile));
+   --m_jobsInFlight;
+  }
+  m_jobsDone.notify_all();
+ });
+}
+
+void
+VirtualTexture::touch(uint64_t key) {
+ const auto it = m_pageTable.find(key);
+ if (it != m_pageTable.end()) {
+  m_slots[it->second].lastUsedFrame = m_frame;
+ }
+}
+
+int
+VirtualTexture::acquireSlot() {
+ int oldest = -1;
+ for (std::size_t i = 0; i < m_slots.size(); ++i) {
+  const Slot& slot = m_slots[i];
+  if (!slot.used) {
+   return static_cast<int>(i);
+  }
+  //no se reciclan tiles que algun frame en vuelo todavia puede estar dibujando
+  if (slot.pinned || slot.lastUsedFrame + FRAMES_IN_FLIGHT >= m_frame) {
+   continue;
+  }
+  if (oldest < 0 || slot.lastUsedFrame < m_slots[oldest].lastUsedFrame) {
+   oldest = static_cast<int>(i);
+  }
+ }
+ if (oldest >= 0) {
+  m_pageTable.erase(m_slots[oldest].key);
+  m_slots[oldest].used = false;
+ }
+ return oldest;
+}
+
+void
+VirtualTexture::upload(uint64_t key, sf::Image&& image, bool pinned) {
+ if (m_pageTable.count(key) != 0) {
+  return;
+ }
+ const int slot = acquireSlot();
+ if (slot < 0) {
+  return;
+ }
+ const sf::Vector2u position((slot % m_slotsPerSide) * m_tileSize, (slot / m_slotsPerSide) * m_tileSize);
+ {
+  std::lock_guard<std::mutex> lock(m_writesMutex);
+  m_writes.push_back({ std::move(image), position });
+ }
+
+ Slot& s = m_slots[slot];
+ s.key = key;
+ s.used = true;
+ s.pinned = pinned;
+ s.lastUsedFrame = m_frame;
+ m_pageTable[key] = slot;
+}
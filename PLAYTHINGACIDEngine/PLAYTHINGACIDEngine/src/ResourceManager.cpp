@@ -1,42 +1,421 @@
 #include "ResourceManager.h"
+#include "Utilities/JobSystem.h"
+#include "Utilities/StartupTracer.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+ //fuentes y shaders no exponen su tamano: se cuenta el de sus archivos
+ std::size_t
+ fileSize(const std::string& path) {
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  return error ? 0 : static_cast<std::size_t>(size);
+ }
+}
+
+ResourceManager::ResourceManager() :
+	m_textures("Textures",
+			   [](const Texture& texture) {
+				   const sf::Vector2u size = texture.getTexture().getSize();
+				   return static_cast<std::size_t>(size.x) * size.y * 4;
+			   },
+			   256u * 1024u * 1024u),
+	m_fonts("Fonts", nullptr, 16u * 1024u * 1024u),
+	m_soundBuffers("Sound buffers",
+				   [](const sf::SoundBuffer& buffer) {
+					   return static_cast<std::size_t>(buffer.getSampleCount()) * sizeof(std::int16_t);
+				   },
+				   64u * 1024u * 1024u),
+	m_shaders("Shaders", nullptr) {
+}
 
 bool 
 ResourceManager::loadTexture(const std::string& fileName, 
 							 const std::string& extension) {
-	//verificar si la textura ya est cargada
-	if (m_textures.find(fileName) != m_textures.end()) {
-		return true;
-	}
-
-	//crear y cargar la textura
-	auto texture = EngineUtilities::MakeShared<Texture>(fileName, extension);
-	m_textures[fileName] = texture;
+	//si la textura ya est cargada se reutiliza
+	const StringId key(fileName);
+	m_textures.getOrLoad(key, [&]() {
+		//crear y cargar la textura: blob cocinado si lo hay, si no la imagen original
+		STARTUP_SCOPE_DETAIL("Load texture", fileName);
+		sf::Clock clock;
+		const std::string path = fileName + "." + extension;
+		TextureSource source = locateTexture(fileName, path, true);
+		std::vector<uint8_t> storage;
+		ByteSpan bytes = readSource(source, storage);
+		CookedTexture cooked;
+		if (source.cooked && !cooked.parse(bytes)) {
+			LOG_WARNING("ResourceManager", "Invalid cooked texture {}. Decoding {}", source.path, path);
+			source = locateTexture(fileName, path, false);
+			bytes = readSource(source, storage);
+		}
+		EngineUtilities::TSharedPointer<Texture> texture(source.cooked
+			? new Texture(fileName, extension, cooked)
+			: new Texture(fileName, extension, bytes.data, bytes.size));
+		const sf::Vector2u size = texture->getTexture().getSize();
+		recordLoad(source.cooked, static_cast<uint64_t>(size.x) * size.y, clock.getElapsedTime());
+		trackFile(key, texture->getPath());
+		return texture;
+	});
 	return true;
 }
 
 EngineUtilities::TSharedPointer<Texture>
-ResourceManager::getTexture(const std::string& fileName) {
+ResourceManager::getTexture(StringId id) {
 
 	//buscar la textura
-	auto it = m_textures.find(fileName);
-	if (it != m_textures.end()) {
-		return it->second; // devolver la textura si se encuentra
+	auto texture = m_textures.find(id);
+	if (texture) {
+		return texture; // devolver la textura si se encuentra
 	}
 
 	//si no se encuentra, retornar una textura default
-	std::cerr << "[Resource Manager]: Texture not found: " << fileName << ". Using default texture.\n";
+	LOG_WARNING("ResourceManager", "Texture not found: {} ({}). Using default texture.", id.getString(), id.getHash());
+
+	return getDefaultTexture();
+}
+
+EngineUtilities::TSharedPointer<Texture>
+ResourceManager::loadTextureAsync(const std::string& fileName,
+								  const std::string& extension) {
+	//si ya esta en cache (cargada o cargando) se comparte el mismo handle
+	const StringId key(fileName);
+	return m_textures.getOrLoad(key, [&]() {
+		//mientras se decodifica se ve la textura por defecto (MakeShared copiaria la textura dos veces)
+		auto placeholder = getDefaultTexture();
+		EngineUtilities::TSharedPointer<Texture> texture(new Texture(fileName, extension, placeholder->getTexture()));
+		trackFile(key, texture->getPath());
+		queueDecode(texture);
+		return texture;
+	});
+}
+
+void
+ResourceManager::queueDecode(const EngineUtilities::TSharedPointer<Texture>& texture, bool allowCooked) {
+	m_loading.push_back(texture);
+
+	//el worker solo decodifica; la subida a GPU la hace el render thread
+	//la entrada del archivo se busca aqui; el worker solo lee el mapeo (inmutable)
+	Texture* target = texture.get();
+	const std::string path = texture->getPath();
+	const TextureSource source = locateTexture(texture->getName(), path, allowCooked);
+	JobSystem::getInstance().submit([this, target, path, source]() {
+		STARTUP_SCOPE_DETAIL("Decode", source.path);
+		sf::Clock clock;
+		PendingUpload upload;
+		upload.texture = target;
+		//el vector movido a la cola conserva su buffer: cooked puede apuntar a el
+		const ByteSpan bytes = readSource(source, upload.blob);
+		bool decoded = false;
+		if (source.cooked) {
+			decoded = upload.cooked.parse(bytes);
+		}
+		else {
+			decoded = !bytes.empty() && upload.image.loadFromMemory(bytes.data, bytes.size);
+			upload.blob.clear();
+			upload.blob.shrink_to_fit();
+		}
+		if (!decoded) {
+			LOG_ERROR("ResourceManager", "Can't decode {}. Keeping default texture.", source.path);
+		}
+		recordLoad(source.cooked, 0, clock.getElapsedTime());
+		std::lock_guard<std::mutex> lock(m_uploadMutex);
+		m_uploads.push_back(std::move(upload));
+	});
+}
+
+ResourceManager::TextureSource
+ResourceManager::locateTexture(const std::string& fileName, const std::string& path, bool allowCooked) const {
+	TextureSource source;
+	const AssetArchive::Entry* entry = nullptr;
+	if (allowCooked) {
+		const std::string cookedPath = CookedTexture::getCookedPath(fileName);
+		source.archive = findInArchives(cookedPath, entry);
+		if (source.archive != nullptr) {
+			source.entry = *entry;
+			source.path = cookedPath;
+			source.cooked = true;
+			return source;
+		}
+
+		//un blob suelto mas viejo que su imagen esta desactualizado
+		std::error_code error;
+		const auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+		if (!error) {
+			const auto sourceTime = std::filesystem::last_write_time(path, error);
+			if (error || sourceTime <= cookedTime) {
+				source.path = cookedPath;
+				source.cooked = true;
+				return source;
+			}
+		}
+	}
+
+	source.archive = findInArchives(path, entry);
+	if (source.archive != nullptr) {
+		source.entry = *entry;
+	}
+	source.path = path;
+	return source;
+}
+
+ByteSpan
+ResourceManager::readSource(const TextureSource& source, std::vector<uint8_t>& storage) {
+	if (source.archive != nullptr) {
+		return source.archive->getBytes(source.entry, storage);
+	}
+	std::ifstream file(source.path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return ByteSpan();
+	}
+	//una sola lectura del tamano del archivo (istreambuf_iterator copia byte a byte)
+	storage.resize(static_cast<std::size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(storage.data()), static_cast<std::streamsize>(storage.size()))) {
+		storage.clear();
+		return ByteSpan();
+	}
+	return ByteSpan{ storage.data(), storage.size() };
+}
+
+void
+ResourceManager::recordLoad(bool cooked, uint64_t pixels, sf::Time time) {
+	LoadCounters& counters = m_loadCounters[cooked ? 1 : 0];
+	if (pixels > 0) {
+		counters.count.fetch_add(1, std::memory_order_relaxed);
+		counters.pixels.fetch_add(pixels, std::memory_order_relaxed);
+	}
+	counters.microseconds.fetch_add(static_cast<uint64_t>(time.asMicroseconds()), std::memory_order_relaxed);
+}
+
+ResourceManager::TextureLoadStats
+ResourceManager::getTextureLoadStats(bool cooked) const {
+	const LoadCounters& counters = m_loadCounters[cooked ? 1 : 0];
+	TextureLoadStats stats;
+	stats.count = counters.count.load(std::memory_order_relaxed);
+	stats.megapixels = counters.pixels.load(std::memory_order_relaxed) / 1000000.0;
+	stats.milliseconds = counters.microseconds.load(std::memory_order_relaxed) / 1000.0;
+	return stats;
+}
+
+bool
+ResourceManager::mountArchive(const std::string& fileName) {
+	auto archive = EngineUtilities::MakeShared<AssetArchive>();
+	if (!archive->open(fileName)) {
+		return false;
+	}
+	m_archives.push_back(archive);
+	MESSAGE("ResourceManager", "mountArchive", fileName + " (" + std::to_string(archive->getEntryCount()) + " entries)");
+	return true;
+}
 
-	const std::string defaultKey = "Default";
+const AssetArchive*
+ResourceManager::findInArchives(const std::string& path, const AssetArchive::Entry*& entry) const {
+	//los ultimos montados tienen prioridad (parches)
+	for (auto it = m_archives.rbegin(); it != m_archives.rend(); ++it) {
+		entry = (*it)->find(path);
+		if (entry != nullptr) {
+			return it->get();
+		}
+	}
+	entry = nullptr;
+	return nullptr;
+}
+
+void
+ResourceManager::trackFile(StringId key, const std::string& path) {
+	m_fileKeys[FileWatcher::normalize(path)] = key;
+	m_watcher.watch(path);
+}
+
+void
+ResourceManager::reloadTexture(StringId key, const EngineUtilities::TSharedPointer<Texture>& texture, bool allowCooked) {
+	//una carga en curso pudo leer el archivo antes del cambio: se repite al terminar
+	if (!texture->isReady()) {
+		m_staleTextures[key] = allowCooked;
+		return;
+	}
+	texture->beginReload();
+	queueDecode(texture, allowCooked);
+}
+
+void
+ResourceManager::reloadAll() {
+	m_textures.forEach([this](StringId key, const EngineUtilities::TSharedPointer<Texture>& texture) {
+		reloadTexture(key, texture, true);
+	});
+}
+
+void
+ResourceManager::setHotReload(bool enabled) {
+	if (enabled) {
+		m_watcher.start();
+	}
+	else {
+		m_watcher.stop();
+	}
+}
+
+void
+ResourceManager::processUploads(sf::Time budget) {
+	sf::Clock clock;
+	for (;;) {
+		PendingUpload upload;
+		{
+			std::lock_guard<std::mutex> lock(m_uploadMutex);
+			if (m_uploads.empty()) {
+				return;
+			}
+			upload = std::move(m_uploads.front());
+			m_uploads.pop_front();
+		}
+		STARTUP_SCOPE_DETAIL("Upload", upload.texture->getName());
+		sf::Clock uploadClock;
+		const bool cooked = upload.cooked.isValid();
+		if (cooked) {
+			upload.texture->finishLoad(upload.cooked);
+		}
+		else {
+			upload.texture->finishLoad(upload.image);
+		}
+		//si fallo la decodificacion no se cuentan los pixeles del placeholder
+		const bool loaded = cooked || upload.image.getSize().x > 0;
+		const sf::Vector2u size = upload.texture->getTexture().getSize();
+		recordLoad(cooked, loaded ? static_cast<uint64_t>(size.x) * size.y : 0, uploadClock.getElapsedTime());
+
+		//el resto espera al siguiente frame
+		if (clock.getElapsedTime() >= budget) {
+			return;
+		}
+	}
+}
+
+void
+ResourceManager::update() {
+	//archivos editados: se recargan en sitio, los handles existentes ven la imagen nueva
+	for (const std::string& path : m_watcher.takeChanges()) {
+		auto key = m_fileKeys.find(path);
+		if (key == m_fileKeys.end()) {
+			continue;
+		}
+		auto texture = m_textures.find(key->second);
+		if (texture) {
+			LOG_INFO("ResourceManager", "Reloading {}", path);
+			reloadTexture(key->second, texture, false);
+		}
+	}
+
+	//las texturas listas ya no necesitan la referencia extra; su tamano ya es el final
+	m_loading.erase(std::remove_if(m_loading.begin(), m_loading.end(),
+		[this](const EngineUtilities::TSharedPointer<Texture>& texture) {
+			if (!texture->isReady()) {
+				return false;
+			}
+			m_textures.refreshSize(StringId(texture->getName()));
+			return true;
+		}),
+		m_loading.end());
+
+	//cambios que llegaron durante una carga: se vuelven a decodificar cuando esta termina
+	for (auto it = m_staleTextures.begin(); it != m_staleTextures.end();) {
+		auto texture = m_textures.find(it->first);
+		if (texture && !texture->isReady()) {
+			++it;
+			continue;
+		}
+		if (texture) {
+			texture->beginReload();
+			queueDecode(texture, it->second);
+		}
+		it = m_staleTextures.erase(it);
+	}
+
+	//lo que nadie usa sale en orden LRU si el tipo excede su presupuesto (si no, no recorre nada)
+	m_textures.trim();
+	m_fonts.trim();
+	m_soundBuffers.trim();
+	m_shaders.trim();
+}
+
+EngineUtilities::TSharedPointer<sf::Font>
+ResourceManager::getFont(const std::string& fileName, const std::string& extension) {
+	return m_fonts.getOrLoad(StringId(fileName), [&](std::size_t& bytes) {
+		const std::string path = fileName + "." + extension;
+		auto font = EngineUtilities::MakeShared<sf::Font>();
+
+		//sf::Font lee el buffer mientras vive: solo entradas sin comprimir (apuntan al mapeo)
+		const AssetArchive::Entry* entry = nullptr;
+		const AssetArchive* archive = findInArchives(path, entry);
+		if (archive != nullptr && (entry->flags & AssetArchive::FLAG_COMPRESSED) == 0) {
+			std::vector<uint8_t> unused;
+			const ByteSpan data = archive->getBytes(*entry, unused);
+			if (!data.empty() && font->openFromMemory(data.data, data.size)) {
+				bytes = static_cast<std::size_t>(entry->size);
+				return font;
+			}
+		}
+		if (!font->openFromFile(path)) {
+			LOG_ERROR("ResourceManager", "Font not found: {}", path);
+			return EngineUtilities::TSharedPointer<sf::Font>();
+		}
+		bytes = fileSize(path);
+		return font;
+	});
+}
+
+EngineUtilities::TSharedPointer<sf::SoundBuffer>
+ResourceManager::getSoundBuffer(const std::string& fileName, const std::string& extension) {
+	return m_soundBuffers.getOrLoad(StringId(fileName), [&]() {
+		auto buffer = EngineUtilities::MakeShared<sf::SoundBuffer>();
+		const std::string path = fileName + "." + extension;
+		const AssetArchive::Entry* entry = nullptr;
+		const AssetArchive* archive = findInArchives(path, entry);
+		bool loaded = false;
+		if (archive != nullptr) {
+			std::vector<uint8_t> storage;
+			const ByteSpan bytes = archive->getBytes(*entry, storage);
+			loaded = !bytes.empty() && buffer->loadFromMemory(bytes.data, bytes.size);
+		}
+		else {
+			loaded = buffer->loadFromFile(path);
+		}
+		if (!loaded) {
+			LOG_ERROR("ResourceManager", "Sound not found: {}.{}", fileName, extension);
+			return EngineUtilities::TSharedPointer<sf::SoundBuffer>();
+		}
+		return buffer;
+	});
+}
+
+EngineUtilities::TSharedPointer<sf::Shader>
+ResourceManager::getShader(const std::string& fileName) {
+	return m_shaders.getOrLoad(StringId(fileName), [&](std::size_t& bytes) {
+		const std::string vertexPath = fileName + ".vert";
+		const std::string fragmentPath = fileName + ".frag";
+		auto shader = EngineUtilities::MakeShared<sf::Shader>();
+		if (!sf::Shader::isAvailable() || !shader->loadFromFile(vertexPath, fragmentPath)) {
+			LOG_ERROR("ResourceManager", "Shader not available: {}", fileName);
+			return EngineUtilities::TSharedPointer<sf::Shader>();
+		}
+		bytes = fileSize(vertexPath) + fileSize(fragmentPath);
+		return shader;
+	});
+}
+
+EngineUtilities::TSharedPointer<Texture>
+ResourceManager::getDefaultTexture() {
+	const std::string defaultName = "Default";
+	static const StringId defaultKey(defaultName);
 
 	//verificar si la textura por defecto ya est cargada
 	auto defaultIt = m_textures.find(defaultKey);
-	if (defaultIt != m_textures.end()) {
-		return defaultIt->second; // devolver la textura por defecto si se encuentra
+	if (defaultIt) {
+		return defaultIt; // devolver la textura por defecto si se encuentra
 	}
 
-
 	// cargar la textura por defecto
-	auto defaultTexture = EngineUtilities::MakeShared<Texture>(defaultKey, "png");
-	m_textures[defaultKey] = defaultTexture;
+	auto defaultTexture = EngineUtilities::MakeShared<Texture>(defaultName, "png");
+	m_textures.insert(defaultKey, defaultTexture);
+	trackFile(defaultKey, defaultTexture->getPath());
 	return defaultTexture; // devolver la textura por defecto
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "StressScene.h"
+#include "CShape.h"
+#include "ECS/Transform.h"
+#include "ECS/Texture.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI  //wingdi.h redefine ERROR
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+StressScene::StressScene(const StressConfig& config) : m_config(config), m_random(config.seed) {
+ m_config.racers = std::clamp(m_config.racers, MIN_RACERS, MAX_RACERS);
+}
+
+std::vector<sf::Vector2f>
+StressScene::generateTrack(const sf::FloatRect& area) {
+ std::uniform_real_distribution<float> amplitude(0.04f, 0.14f);
+ std::uniform_real_distribution<float> phase(0.f, 6.2831853f);
+ std::uniform_int_distribution<int> waypointCount(16, 40);
+
+ //radio base con tres armonicos: curvas suaves y alguna horquilla
+ float amplitudes[3];
+ float phases[3];
+ for (int h = 0; h < 3; ++h) {
+  amplitudes[h] = amplitude(m_random);
+  phases[h] = phase(m_random);
+ }
+
+ const sf::Vector2f center = area.position + area.size * 0.5f;
+ const sf::Vector2f radius = area.size * 0.38f;
+ const int count = waypointCount(m_random);
+ std::vector<sf::Vector2f> waypoints;
+ waypoints.reserve(count);
+ for (int i = 0; i < count; ++i) {
+  const float angle = 6.2831853f * i / count;
+  float scale = 1.f;
+  for (int h = 0; h < 3; ++h) {
+   scale += amplitudes[h] * std::sin((h + 2) * angle + phases[h]);
+  }
+  waypoints.push_back(center + sf::Vector2f(std::cos(angle) * radius.x, std::sin(angle) * radius.y) * scale);
+ }
+ return waypoints;
+}
+
+std::vector<EngineUtilities::TSharedPointer<A_Racer>>
+StressScene::spawnRacers(const std::vector<sf::Vector2f>& waypoints,
+                         const std::vector<EngineUtilities::TSharedPointer<Texture>>& liveries) {
+ std::uniform_real_distribution<float> speed(180.f, 420.f);
+ std::uniform_real_distribution<float> force(400.f, 900.f);
+ std::uniform_real_distribution<float> mass(0.7f, 1.6f);
+ std::uniform_real_distribution<float> drag(0.05f, 0.2f);
+ std::uniform_real_distribution<float> arrive(60.f, 140.f);
+ std::uniform_real_distribution<float> size(0.3f, 0.8f);
+ std::uniform_int_distribution<int> channel(60, 255);
+ std::uniform_int_distribution<std::size_t> livery(0, liveries.empty() ? 0 : liveries.size() - 1);
+
+ std::vector<EngineUtilities::TSharedPointer<A_Racer>> racers;
+ racers.reserve(m_config.racers);
+ const int lanes = 4;
+ const float laneGap = 30.f;
+ const float rowGap = 60.f;
+ const int waypointCount = static_cast<int>(waypoints.size());
+ for (uint32_t i = 0; i < m_config.racers; ++i) {
+  auto racer = EngineUtilities::MakeShared<A_Racer>("Stress_" + std::to_string(i));
+  auto shape = racer->getComponent<CShape>();
+  shape->createShape(ShapeType::RECTANGLE);
+  shape->setFillColor(sf::Color(channel(m_random), channel(m_random), channel(m_random)));
+  const float scale = size(m_random);
+  racer->getComponent<Transform>()->setScale(sf::Vector2f(scale, scale * 1.2f));
+  if (!liveries.empty()) {
+   racer->setTexture(liveries[livery(m_random)]);
+  }
+
+  racer->setMaxSpeed(speed(m_random));
+  racer->setMaxForce(force(m_random));
+  racer->setMass(mass(m_random));
+  racer->setLinearDrag(drag(m_random));
+  const float arriveRadius = arrive(m_random);
+  racer->setArrive(arriveRadius * 0.2f, arriveRadius);
+
+  //parrilla de 4 carriles repartida por todos los tramos
+  racer->setWaypoints(waypoints);
+  const uint32_t row = i / lanes;
+  const int segment = static_cast<int>(row % waypointCount);
+  const float back = rowGap * static_cast<float>(row / waypointCount % 8);
+  racer->spawnRelative(segment, back, (static_cast<int>(i % lanes) - 1.5f) * laneGap);
+  racers.push_back(racer);
+ }
+ return racers;
+}
+
+int
+StressScene::addPhase(const char* name) {
+ Phase phase;
+ phase.name = name;
+ m_phases.push_back(phase);
+ return static_cast<int>(m_phases.size()) - 1;
+}
+
+void
+StressScene::addSample(int phase, double milliseconds) {
+ Phase& entry = m_phases[phase];
+ entry.totalMs += milliseconds;
+ entry.maxMs = std::max(entry.maxMs, milliseconds);
+ ++entry.samples;
+}
+
+void
+StressScene::printReport(std::ostream& out, const ProcessMemory& before, const ProcessMemory& after) const {
+ const std::ios::fmtflags flags = out.flags();
+ const double mb = 1024.0 * 1024.0;
+ out << std::fixed << std::setprecision(3);
+ out << "---- Stress: " << m_config.racers << " racers, " << m_config.ticks << " ticks, seed "
+     << m_config.seed << (m_config.headless ? ", headless" : ", windowed") << " ----\n";
+ out << std::left << std::setw(14) << "phase" << std::right
+     << std::setw(12) << "avg ms" << std::setw(12) << "max ms" << std::setw(14) << "ns/racer" << "\n";
+ double totalMs = 0.0;
+ for (const Phase& phase : m_phases) {
+  const double avg = phase.samples > 0 ? phase.totalMs / phase.samples : 0.0;
+  out << std::left << std::setw(14) << phase.name << std::right
+      << std::setw(12) << avg << std::setw(12) << phase.maxMs
+      << std::setw(14) << avg * 1e6 / m_config.racers << "\n";
+  totalMs += avg;
+ }
+ out << std::left << std::setw(14) << "tick" << std::right << std::setw(12) << totalMs
+     << std::setw(12) << "" << std::setw(14) << totalMs * 1e6 / m_config.racers << "\n";
+ out << std::setprecision(1)
+     << "memory: " << before.current / mb << " MB before spawn, " << after.current / mb << " MB after ("
+     << (after.current > before.current ? static_cast<double>(after.current - before.current) / m_config.racers : 0.0)
+     << " bytes/racer), peak " << getProcessMemory().peak / mb << " MB\n";
+ out.flags(flags);
+}
+
+StressScene::ProcessMemory
+StressScene::getProcessMemory() {
+ ProcessMemory memory;
+#if defined(_WIN32)
+ PROCESS_MEMORY_COUNTERS counters;
+ if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+  memory.current = counters.WorkingSetSize;
+  memory.peak = counters.PeakWorkingSetSize;
+ }
+#else
+ //residente actual desde /proc, pico desde getrusage (en KB)
+ std::ifstream statm("/proc/self/statm");
+ uint64_t pages = 0;
+ uint64_t resident = 0;
+ if (statm >> pages >> resident) {
+  memory.current = resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+ }
+ rusage usage;
+ if (getrusage(RUSAGE_SELF, &usage) == 0) {
+  memory.peak = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+ }
+#endif
+ return memory;
+}
@@ -0,0 +1,157 @@
+#include "Utilities/Compression.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+ constexpr std::size_t MIN_MATCH = 4;
+ constexpr std::size_t LAST_LITERALS = 5;      ///< Bytes at the end always stored as literals.
+ constexpr std::size_t MATCH_FIND_LIMIT = 12;  ///< No match may start this close to the end.
+ constexpr std::size_t MAX_OFFSET = 65535;
+ constexpr unsigned int HASH_BITS = 14;
+ constexpr uint32_t NO_POSITION = 0xFFFFFFFFu;
+
+ uint32_t
+  read32(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+ }
+
+ uint32_t
+  hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - HASH_BITS);
+ }
+
+ //longitudes >= 15 continuan en bytes de 255
+ void
+  writeLength(std::vector<uint8_t>& out, std::size_t length) {
+  while (length >= 255) {
+   out.push_back(255);
+   length -= 255;
+  }
+  out.push_back(static_cast<uint8_t>(length));
+ }
+
+ void
+  writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, std::size_t literalCount,
+                std::size_t offset, std::size_t matchLength) {
+  const std::size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+  out.push_back(static_cast<uint8_t>((std::min<std::size_t>(literalCount, 15) << 4)
+                                     | std::min<std::size_t>(matchCode, 15)));
+  if (literalCount >= 15) {
+   writeLength(out, literalCount - 15);
+  }
+  out.insert(out.end(), literals, literals + literalCount);
+  if (matchLength == 0) {
+   return;
+  }
+  out.push_back(static_cast<uint8_t>(offset & 0xFF));
+  out.push_back(static_cast<uint8_t>(offset >> 8));
+  if (matchCode >= 15) {
+   writeLength(out, matchCode - 15);
+  }
+ }
+
+ bool
+  readLength(const uint8_t*& ip, const uint8_t* end, std::size_t& length) {
+  uint8_t byte;
+  do {
+   if (ip >= end) {
+    return false;
+   }
+   byte = *ip++;
+   length += byte;
+  } while (byte == 255);
+  return true;
+ }
+}
+
+namespace Compression {
+
+ std::size_t
+  compressBound(std::size_t size) {
+  return size + size / 255 + 16;
+ }
+
+ void
+  compress(const uint8_t* source, std::size_t size, std::vector<uint8_t>& output) {
+  output.clear();
+  output.reserve(compressBound(size));
+
+  std::size_t anchor = 0;
+  if (size > MATCH_FIND_LIMIT) {
+   std::vector<uint32_t> table(std::size_t(1) << HASH_BITS, NO_POSITION);
+   const std::size_t matchLimit = size - LAST_LITERALS;
+   std::size_t ip = 0;
+   while (ip < size - MATCH_FIND_LIMIT) {
+    const uint32_t sequence = read32(source + ip);
+    uint32_t& slot = table[hash(sequence)];
+    const uint32_t candidate = slot;
+    slot = static_cast<uint32_t>(ip);
+
+    if (candidate == NO_POSITION || ip - candidate > MAX_OFFSET || read32(source + candidate) != sequence) {
+     ++ip;
+     continue;
+    }
+
+    std::size_t length = MIN_MATCH;
+    while (ip + length < matchLimit && source[candidate + length] == source[ip + length]) {
+     ++length;
+    }
+    writeSequence(output, source + anchor, ip - anchor, ip - candidate, length);
+    ip += length;
+    anchor = ip;
+   }
+  }
+
+  //la ultima secuencia solo lleva literales
+  writeSequence(output, source + anchor, size - anchor, 0, 0);
+ }
+
+ bool
+  decompress(const uint8_t* source, std::size_t size, uint8_t* destination, std::size_t destinationSize) {
+  const uint8_t* ip = source;
+  const uint8_t* const end = source + size;
+  uint8_t* op = destination;
+  uint8_t* const outEnd = destination + destinationSize;
+
+  while (ip < end) {
+   const uint8_t token = *ip++;
+   std::size_t literals = token >> 4;
+   if (literals == 15 && !readLength(ip, end, literals)) {
+    return false;
+   }
+   if (literals > static_cast<std::size_t>(end - ip) || literals > static_cast<std::size_t>(outEnd - op)) {
+    return false;
+   }
+   std::memcpy(op, ip, literals);
+   ip += literals;
+   op += literals;
+   if (ip == end) {
+    break;
+   }
+
+   if (end - ip < 2) {
+    return false;
+   }
+   const std::size_t offset = ip[0] | (std::size_t(ip[1]) << 8);
+   ip += 2;
+   std::size_t length = token & 15;
+   if (length == 15 && !readLength(ip, end, length)) {
+    return false;
+   }
+   length += MIN_MATCH;
+   if (offset == 0 || offset > static_cast<std::size_t>(op - destination)
+       || length > static_cast<std::size_t>(outEnd - op)) {
+    return false;
+   }
+   //la copia puede solaparse con lo que escribe (repeticiones cortas)
+   const uint8_t* match = op - offset;
+   for (std::size_t i = 0; i < length; ++i) {
+    op[i] = match[i];
+   }
+   op += length;
+  }
+  return op == outEnd;
+ }
+}
@@ -0,0 +1,177 @@
+#include "Utilities/FileWatcher.h"
+#include <filesystem>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#if !defined(__linux__)
+ int64_t
+  writeTime(const std::string& path) {
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(path, error);
+  return error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+ }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+ stop();
+}
+
+std::string
+FileWatcher::normalize(const std::string& path) {
+ //sin "./" ni separadores repetidos, para comparar eventos con lo vigilado
+ return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool
+FileWatcher::start(std::chrono::milliseconds debounce) {
+ if (isRunning()) {
+  return true;
+ }
+ m_debounce = debounce;
+
+#if defined(__linux__)
+ m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+ if (m_inotify < 0) {
+  return false;
+ }
+ //los archivos agregados antes de arrancar
+ std::vector<std::string> files;
+ {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  files.assign(m_files.begin(), m_files.end());
+  m_watchedDirs.clear();
+  m_watchDirs.clear();
+ }
+ m_running.store(true, std::memory_order_release);
+ for (const std::string& file : files) {
+  watch(file);
+ }
+#else
+ m_running.store(true, std::memory_order_release);
+#endif
+
+ m_thread = std::thread(&FileWatcher::threadMain, this);
+ return true;
+}
+
+void
+FileWatcher::stop() {
+ if (!isRunning()) {
+  return;
+ }
+ m_running.store(false, std::memory_order_release);
+ if (m_thread.joinable()) {
+  m_thread.join();
+ }
+#if defined(__linux__)
+ close(m_inotify);
+ m_inotify = -1;
+#endif
+}
+
+void
+FileWatcher::watch(const std::string& path) {
+ const std::string file = normalize(path);
+ std::lock_guard<std::mutex> lock(m_mutex);
+ m_files.insert(file);
+
+#if defined(__linux__)
+ if (m_inotify < 0) {
+  return;
+ }
+ std::string directory = std::filesystem::path(file).parent_path().generic_string();
+ if (directory.empty()) {
+  directory = ".";
+ }
+ if (m_watchedDirs.insert(directory).second) {
+  //guardar y renombrar cubre tanto escritura directa como archivo temporal
+  const int wd = inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+  if (wd >= 0) {
+   m_watchDirs[wd] = directory;
+  }
+ }
+#else
+ m_writeTimes[file] = writeTime(file);
+#endif
+}
+
+std::vector<std::string>
+FileWatcher::takeChanges() {
+ std::lock_guard<std::mutex> lock(m_mutex);
+ std::vector<std::string> changes;
+ changes.swap(m_changes);
+ return changes;
+}
+
+const char*
+FileWatcher::getBackendName() const {
+#if defined(__linux__)
+ return "inotify";
+#else
+ return "polling";
+#endif
+}
+
+void
+FileWatcher::markChanged(const std::string& path, Clock::time_point now) {
+ if (m_files.count(path) != 0) {
+  m_pending[path] = now;
+ }
+}
+
+void
+FileWatcher::threadMain() {
+ while (isRunning()) {
+#if defined(__linux__)
+  pollfd descriptor{ m_inotify, POLLIN, 0 };
+  if (poll(&descriptor, 1, 50) > 0) {
+   alignas(inotify_event) char buffer[4096];
+   ssize_t length;
+   while ((length = read(m_inotify, buffer, sizeof(buffer))) > 0) {
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (char* cursor = buffer; cursor < buffer + length;) {
+     const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+     auto dir = m_watchDirs.find(event->wd);
+     if (event->len > 0 && dir != m_watchDirs.end()) {
+      markChanged(normalize(dir->second + "/" + event->name), now);
+     }
+     cursor += sizeof(inotify_event) + event->len;
+    }
+   }
+  }
+#else
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  {
+   const Clock::time_point now = Clock::now();
+   std::lock_guard<std::mutex> lock(m_mutex);
+   for (auto& pair : m_writeTimes) {
+    const int64_t time = writeTime(pair.first);
+    if (time != pair.second) {
+     pair.second = time;
+     markChanged(pair.first, now);
+    }
+   }
+  }
+#endif
+
+  //un cambio se reporta cuando el archivo deja de moverse
+  const Clock::time_point now = Clock::now();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto it = m_pending.begin(); it != m_pending.end();) {
+   if (now - it->second >= m_debounce) {
+    m_changes.push_back(it->first);
+    it = m_pending.erase(it);
+   }
+   else {
+    ++it;
+   }
+  }
+ }
+}
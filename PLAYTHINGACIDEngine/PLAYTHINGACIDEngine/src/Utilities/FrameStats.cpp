@@ -0,0 +1,204 @@
+#include "Utilities/FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+uint32_t
+FrameHistogram::bucketOf(uint64_t micros) {
+ micros = std::min(micros, MAX_VALUE);
+ if (micros < LINEAR_LIMIT) {
+  return static_cast<uint32_t>(micros);
+ }
+ //potencia de dos partida en SUB_BUCKETS: los 6 bits tras el mas alto
+ uint32_t msb = 0;
+ for (uint64_t v = micros; v > 1; v >>= 1) {
+  ++msb;
+ }
+ const uint32_t shift = msb - 6;
+ return shift * SUB_BUCKETS + static_cast<uint32_t>(micros >> shift);
+}
+
+uint64_t
+FrameHistogram::bucketUpper(uint32_t bucket) {
+ if (bucket < LINEAR_LIMIT) {
+  return bucket;
+ }
+ const uint32_t shift = bucket / SUB_BUCKETS - 1;
+ const uint64_t top = bucket % SUB_BUCKETS + SUB_BUCKETS;
+ return ((top + 1) << shift) - 1;
+}
+
+void
+FrameHistogram::add(uint64_t micros) {
+ ++m_buckets[bucketOf(micros)];
+ ++m_count;
+}
+
+void
+FrameHistogram::remove(uint64_t micros) {
+ uint32_t& bucket = m_buckets[bucketOf(micros)];
+ if (bucket > 0) {
+  --bucket;
+  --m_count;
+ }
+}
+
+uint64_t
+FrameHistogram::percentile(double fraction) const {
+ if (m_count == 0) {
+  return 0;
+ }
+ //rango de la muestra buscada (1..count)
+ const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * m_count)));
+ uint64_t seen = 0;
+ for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+  seen += m_buckets[i];
+  if (seen >= rank) {
+   return bucketUpper(i);
+  }
+ }
+ return MAX_VALUE;
+}
+
+void
+FrameStats::beginFrame() {
+ const Clock::time_point now = Clock::now();
+ if (!m_started) {
+  m_frameStart = now;
+  m_started = true;
+ }
+ m_phaseStart = now;
+ m_current = FrameRecord();
+}
+
+void
+FrameStats::mark(FrameStatChannel channel) {
+ const Clock::time_point now = Clock::now();
+ m_current.micros[channel] += static_cast<uint32_t>(
+  std::chrono::duration_cast<std::chrono::microseconds>(now - m_phaseStart).count());
+ m_phaseStart = now;
+}
+
+void
+FrameStats::endFrame() {
+ const Clock::time_point now = Clock::now();
+ m_current.micros[FRAME_STAT_FRAME] = static_cast<uint32_t>(
+  std::chrono::duration_cast<std::chrono::microseconds>(now - m_frameStart).count());
+ m_frameStart = now;
+
+ //la ventana suelta el frame que sale antes de meter el nuevo
+ if (m_frameCount >= WINDOW_FRAMES) {
+  const FrameRecord& oldest = m_recent[m_windowNext];
+  for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+   m_window[c].remove(oldest.micros[c]);
+  }
+ }
+ for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+  const uint32_t micros = m_current.micros[c];
+  m_total[c].add(micros);
+  m_window[c].add(micros);
+  m_totalMax[c] = std::max<uint64_t>(m_totalMax[c], micros);
+  m_windowMs[c][m_windowNext] = micros / 1000.f;
+ }
+ m_recent[m_windowNext] = m_current;
+ m_windowNext = (m_windowNext + 1) % WINDOW_FRAMES;
+ if (m_csv.is_open()) {
+  writeCsvRow(m_current);
+ }
+ ++m_frameCount;
+}
+
+FrameStats::Summary
+FrameStats::getWindowSummary(FrameStatChannel channel) const {
+ Summary summary;
+ const FrameHistogram& histogram = m_window[channel];
+ summary.count = histogram.getCount();
+ summary.p50 = histogram.percentile(0.50) / 1000.0;
+ summary.p95 = histogram.percentile(0.95) / 1000.0;
+ summary.p99 = histogram.percentile(0.99) / 1000.0;
+
+ //el maximo exacto sale de los frames de la ventana
+ uint32_t max = 0;
+ const std::size_t filled = std::min(m_frameCount, WINDOW_FRAMES);
+ for (std::size_t i = 0; i < filled; ++i) {
+  max = std::max(max, m_recent[i].micros[channel]);
+ }
+ summary.max = max / 1000.0;
+ return summary;
+}
+
+FrameStats::Summary
+FrameStats::getTotalSummary(FrameStatChannel channel) const {
+ Summary summary;
+ const FrameHistogram& histogram = m_total[channel];
+ summary.count = histogram.getCount();
+ summary.p50 = histogram.percentile(0.50) / 1000.0;
+ summary.p95 = histogram.percentile(0.95) / 1000.0;
+ summary.p99 = histogram.percentile(0.99) / 1000.0;
+ summary.max = m_totalMax[channel] / 1000.0;
+ return summary;
+}
+
+const char*
+FrameStats::getChannelName(FrameStatChannel channel) {
+ switch (channel) {
+ case FRAME_STAT_FRAME: return "Frame";
+ case FRAME_STAT_SIMULATION: return "Simulation";
+ case FRAME_STAT_GUI: return "GUI";
+ case FRAME_STAT_RENDER: return "Render";
+ default: return "?";
+ }
+}
+
+bool
+FrameStats::openCsv(const std::string& fileName) {
+ closeCsv();
+ m_csv.open(fileName, std::ios::trunc);
+ if (!m_csv) {
+  m_csv.close();
+  return false;
+ }
+ m_csv << "frame";
+ for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+  m_csv << "," << getChannelName(static_cast<FrameStatChannel>(c)) << "_ms";
+ }
+ m_csv << "\n" << std::fixed << std::setprecision(3);
+ return true;
+}
+
+void
+FrameStats::writeCsvRow(const FrameRecord& record) {
+ //el buffer del stream agrupa las filas: se escribe al disco cada pocos KB
+ m_csv << m_frameCount;
+ for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+  m_csv << "," << record.micros[c] / 1000.0;
+ }
+ m_csv << "\n";
+}
+
+bool
+FrameStats::closeCsv() {
+ if (!m_csv.is_open()) {
+  return false;
+ }
+ m_csv.flush();
+ const bool written = static_cast<bool>(m_csv);
+ m_csv.close();
+ return written;
+}
+
+void
+FrameStats::printSummary(std::ostream& out) const {
+ const std::ios::fmtflags flags = out.flags();
+ out << std::fixed << std::setprecision(2);
+ out << "---- Frame times over " << m_frameCount << " frames (ms) ----\n";
+ out << std::left << std::setw(12) << "channel" << std::right
+     << std::setw(9) << "p50" << std::setw(9) << "p95" << std::setw(9) << "p99" << std::setw(9) << "max" << "\n";
+ for (int c = 0; c < FRAME_STAT_COUNT; ++c) {
+  const Summary summary = getTotalSummary(static_cast<FrameStatChannel>(c));
+  out << std::left << std::setw(12) << getChannelName(static_cast<FrameStatChannel>(c)) << std::right
+      << std::setw(9) << summary.p50 << std::setw(9) << summary.p95
+      << std::setw(9) << summary.p99 << std::setw(9) << summary.max << "\n";
+ }
+ out.flags(flags);
+}
@@ -0,0 +1,75 @@
+#include "Utilities/JobSystem.h"
+#include "Utilities/StartupTracer.h"
+#include "Utilities/Profiler.h"
+
+JobSystem::JobSystem() {
+ //un hilo queda libre para la simulacion y otro para el render
+ const unsigned int hardware = std::thread::hardware_concurrency();
+ const unsigned int count = hardware > 2 ? hardware - 2 : 1;
+ m_workers.reserve(count);
+ for (unsigned int i = 0; i < count; ++i) {
+  m_workers.emplace_back(&JobSystem::workerMain, this);
+ }
+}
+
+JobSystem::~JobSystem() {
+ {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stopping = true;
+ }
+ m_jobReady.notify_all();
+ for (std::thread& worker : m_workers) {
+  if (worker.joinable()) {
+   worker.join();
+  }
+ }
+}
+
+void
+JobSystem::submit(std::function<void()> job) {
+ if (!job) {
+  return;
+ }
+ {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_jobs.push_back(std::move(job));
+  ++m_pending;
+ }
+ m_jobReady.notify_one();
+}
+
+void
+JobSystem::waitIdle() {
+ std::unique_lock<std::mutex> lock(m_mutex);
+ m_idle.wait(lock, [this] { return m_pending.load() == 0; });
+}
+
+void
+JobSystem::workerMain() {
+ StartupTracer::getInstance().setThreadName("Job worker");
+ PROFILE_THREAD_NAME("Job worker");
+ for (;;) {
+  std::function<void()> job;
+  {
+   std::unique_lock<std::mutex> lock(m_mutex);
+   m_jobReady.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+   //al cerrar se terminan los trabajos pendientes
+   if (m_jobs.empty()) {
+    return;
+   }
+   job = std::move(m_jobs.front());
+   m_jobs.pop_front();
+  }
+
+  {
+   PROFILE_SCOPE("Job");
+   job();
+  }
+
+  {
+   std::lock_guard<std::mutex> lock(m_mutex);
+   --m_pending;
+  }
+  m_idle.notify_all();
+ }
+}
@@ -0,0 +1,470 @@
+#include "Utilities/Logger.h"
+#include "Utilities/Profiler.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+
+LogBuffer::LogBuffer(std::size_t maxLines, std::size_t maxTextBytes)
+ : m_maxLines(std::max<std::size_t>(maxLines, 1)),
+   m_maxText(std::min<std::size_t>(std::max<std::size_t>(maxTextBytes, 1), UINT32_MAX)) {
+}
+
+void
+LogBuffer::push(double time, LogSeverity severity, uint16_t category, uint32_t thread, std::string_view text) {
+ const std::size_t length = std::min(text.size(), m_maxText);
+
+ //el texto va contiguo: si no cabe al final se crece o se da la vuelta
+ if (m_textHead + length > m_text.size()) {
+  if (m_text.size() < m_maxText) {
+   const std::size_t grown = std::max({ m_text.size() * 2, m_textHead + length, std::size_t(64) << 10 });
+   m_text.resize(std::min(grown, m_maxText));
+  }
+  if (m_textHead + length > m_text.size()) {
+   //las lineas que quedan al final son las mas viejas
+   while (m_count > 0 && m_lines[m_first].textOffset >= m_textHead) {
+    popFront();
+   }
+   m_textHead = 0;
+  }
+ }
+ //fuera las lineas cuyo texto se va a pisar: las que empiezan delante de la cabeza son las mas viejas
+ while (m_count > 0) {
+  const Line& oldest = m_lines[m_first];
+  if (oldest.textOffset >= m_textHead && oldest.textOffset < m_textHead + length) {
+   popFront();
+  }
+  else {
+   break;
+  }
+ }
+ if (m_count == m_maxLines) {
+  popFront();
+ }
+
+ Line line;
+ line.sequence = m_nextSequence++;
+ line.time = time;
+ line.textOffset = static_cast<uint32_t>(m_textHead);
+ line.textLength = static_cast<uint32_t>(length);
+ line.thread = thread;
+ line.category = category;
+ line.severity = static_cast<uint8_t>(severity);
+
+ char* destination = m_text.data() + m_textHead;
+ for (std::size_t i = 0; i < length; ++i) {
+  const char c = text[i];
+  destination[i] = (c == '\n' || c == '\r') ? ' ' : c;
+ }
+ m_textHead += length;
+
+ //el anillo de lineas crece hasta m_maxLines; al crecer se endereza primero
+ if (m_count == m_lines.size()) {
+  std::rotate(m_lines.begin(), m_lines.begin() + m_first, m_lines.end());
+  m_first = 0;
+  m_lines.push_back(line);
+ }
+ else {
+  m_lines[(m_first + m_count) % m_lines.size()] = line;
+ }
+ ++m_count;
+}
+
+void
+LogBuffer::clear() {
+ m_first = 0;
+ m_count = 0;
+ m_textHead = 0;
+}
+
+void
+LogBuffer::popFront() {
+ m_first = (m_first + 1) % m_lines.size();
+ --m_count;
+}
+
+Logger::Logger() : m_start(std::chrono::steady_clock::now()) {
+ m_level.store(LOG_SEVERITY_INFO, std::memory_order_relaxed);
+ m_sinkLevels[LOG_SINK_FILE].store(LOG_SEVERITY_TRACE, std::memory_order_relaxed);
+ m_sinkLevels[LOG_SINK_STDERR].store(LOG_SEVERITY_INFO, std::memory_order_relaxed);
+ m_sinkLevels[LOG_SINK_CONSOLE].store(LOG_SEVERITY_TRACE, std::memory_order_relaxed);
+ m_pending.reserve(RING_CAPACITY * 4);
+ m_line.reserve(512);
+ m_running.store(true, std::memory_order_release);
+ m_thread = std::thread(&Logger::threadMain, this);
+}
+
+Logger::~Logger() {
+ shutdown();
+}
+
+uint16_t
+Logger::registerCategory(const char* name) {
+ std::lock_guard<std::mutex> lock(m_categoryMutex);
+ const uint16_t count = m_categoryCount.load(std::memory_order_relaxed);
+ for (uint16_t i = 0; i < count; ++i) {
+  if (std::strcmp(m_categories[i].name.load(std::memory_order_relaxed), name) == 0) {
+   return i;
+  }
+ }
+ if (count == MAX_CATEGORIES) {
+  return static_cast<uint16_t>(MAX_CATEGORIES - 1);
+ }
+ m_categories[count].name.store(name, std::memory_order_relaxed);
+ m_categoryCount.store(static_cast<uint16_t>(count + 1), std::memory_order_release);
+ return count;
+}
+
+void
+Logger::setCategoryLevel(uint16_t category, LogSeverity severity) {
+ if (category < MAX_CATEGORIES) {
+  m_categories[category].level.store(severity, std::memory_order_relaxed);
+ }
+}
+
+uint16_t
+Logger::getCategoryCount() const {
+ return m_categoryCount.load(std::memory_order_acquire);
+}
+
+const char*
+Logger::getCategoryName(uint16_t category) const {
+ const char* name = category < MAX_CATEGORIES ? m_categories[category].name.load(std::memory_order_relaxed) : nullptr;
+ return name != nullptr ? name : "?";
+}
+
+bool
+Logger::setFile(const std::string& fileName) {
+ std::lock_guard<std::mutex> lock(m_fileMutex);
+ if (m_file.is_open()) {
+  m_file.close();
+ }
+ if (fileName.empty()) {
+  return false;
+ }
+ m_file.open(fileName, std::ios::trunc);
+ return m_file.is_open();
+}
+
+void
+Logger::appendBytes(Record& record, ArgumentType type, const void* data, std::size_t size) {
+ if (record.used + 1 + size > ARGUMENT_BYTES) {
+  record.truncated = 1;
+  return;
+ }
+ record.arguments[record.used] = static_cast<char>(type);
+ std::memcpy(record.arguments + record.used + 1, data, size);
+ record.used = static_cast<uint16_t>(record.used + 1 + size);
+}
+
+void
+Logger::appendString(Record& record, std::string_view text) {
+ //etiqueta + longitud de 2 bytes + texto, recortado a lo que quede
+ const std::size_t left = ARGUMENT_BYTES - record.used;
+ if (left < 3) {
+  record.truncated = 1;
+  return;
+ }
+ const uint16_t length = static_cast<uint16_t>(std::min(text.size(), left - 3));
+ if (length < text.size()) {
+  record.truncated = 1;
+ }
+ char* out = record.arguments + record.used;
+ out[0] = static_cast<char>(ARGUMENT_STRING);
+ std::memcpy(out + 1, &length, sizeof(length));
+ std::memcpy(out + 3, text.data(), length);
+ record.used = static_cast<uint16_t>(record.used + 3 + length);
+}
+
+Logger::ThreadBuffer*
+Logger::threadBuffer() {
+ thread_local ThreadBuffer* t_buffer = nullptr;
+ if (t_buffer == nullptr) {
+  //el ring vive en el logger: se sigue drenando aunque el hilo termine
+  auto buffer = std::make_unique<ThreadBuffer>();
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+  buffer->index = static_cast<uint32_t>(m_buffers.size());
+  t_buffer = buffer.get();
+  m_buffers.push_back(std::move(buffer));
+ }
+ return t_buffer;
+}
+
+void
+Logger::push(Record& record) {
+ if (!m_running.load(std::memory_order_acquire)) {
+  return;
+ }
+ ThreadBuffer* buffer = threadBuffer();
+ record.time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+  std::chrono::steady_clock::now() - m_start).count());
+ record.thread = buffer->index;
+ record.sequence = buffer->sequence++;
+
+ const std::size_t head = buffer->head.load(std::memory_order_relaxed);
+ if (head - buffer->tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+  m_dropped.fetch_add(1, std::memory_order_relaxed);
+  return;
+ }
+ //solo la cabecera y los bytes de argumentos usados
+ std::memcpy(&buffer->records[head % RING_CAPACITY], &record, offsetof(Record, arguments) + record.used);
+ buffer->head.store(head + 1, std::memory_order_release);
+
+ //los errores salen en cuanto se pueda; el resto espera a la siguiente pasada
+ if (record.severity >= LOG_SEVERITY_ERROR) {
+  m_wake.notify_one();
+ }
+}
+
+void
+Logger::flush() {
+ if (!m_running.load(std::memory_order_acquire)) {
+  return;
+ }
+ std::unique_lock<std::mutex> lock(m_wakeMutex);
+ const uint64_t target = ++m_flushRequests;
+ m_wake.notify_one();
+ m_flushed.wait(lock, [this, target]() { return m_flushesDone >= target; });
+}
+
+void
+Logger::shutdown() {
+ if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+  return;
+ }
+ {
+  std::lock_guard<std::mutex> lock(m_wakeMutex);
+  m_stop = true;
+ }
+ m_wake.notify_one();
+ if (m_thread.joinable()) {
+  m_thread.join();
+ }
+ std::lock_guard<std::mutex> lock(m_fileMutex);
+ if (m_file.is_open()) {
+  m_file.close();
+ }
+}
+
+void
+Logger::threadMain() {
+ PROFILE_THREAD_NAME("Logger thread");
+ for (;;) {
+  uint64_t flushTarget = 0;
+  bool stop = false;
+  {
+   //varias pasadas por frame; un error o un flush despiertan antes
+   std::unique_lock<std::mutex> lock(m_wakeMutex);
+   if (!m_stop && m_flushRequests == m_flushesDone) {
+    m_wake.wait_for(lock, std::chrono::milliseconds(5));
+   }
+   flushTarget = m_flushRequests;
+   stop = m_stop;
+  }
+
+  drain();
+
+  {
+   std::lock_guard<std::mutex> lock(m_wakeMutex);
+   m_flushesDone = flushTarget;
+  }
+  m_flushed.notify_all();
+  if (stop) {
+   break;
+  }
+ }
+}
+
+void
+Logger::drain() {
+ m_pending.clear();
+ {
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+  for (auto& buffer : m_buffers) {
+   std::size_t tail = buffer->tail.load(std::memory_order_relaxed);
+   const std::size_t head = buffer->head.load(std::memory_order_acquire);
+   for (; tail != head; ++tail) {
+    m_pending.push_back(buffer->records[tail % RING_CAPACITY]);
+   }
+   buffer->tail.store(tail, std::memory_order_release);
+  }
+ }
+
+ //los descartados se avisan como un mensaje mas
+ const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+ if (dropped != m_reportedDropped) {
+  static const uint16_t category = registerCategory("Logger");
+  Record record;
+  record.severity = LOG_SEVERITY_WARNING;
+  record.category = category;
+  record.format = "{} messages dropped (thread ring full)";
+  record.time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+   std::chrono::steady_clock::now() - m_start).count());
+  appendArgument(record, dropped - m_reportedDropped);
+  m_pending.push_back(record);
+  m_reportedDropped = dropped;
+ }
+ if (m_pending.empty()) {
+  return;
+ }
+
+ PROFILE_SCOPE("Drain log");
+ //cada ring ya esta en orden; entre hilos se ordena por tiempo
+ std::sort(m_pending.begin(), m_pending.end(), [](const Record& a, const Record& b) {
+  if (a.time != b.time) {
+   return a.time < b.time;
+  }
+  return a.thread != b.thread ? a.thread < b.thread : a.sequence < b.sequence;
+ });
+ for (const Record& record : m_pending) {
+  format(record, m_line);
+  dispatch(record, m_line);
+ }
+
+ std::lock_guard<std::mutex> lock(m_fileMutex);
+ if (m_file.is_open()) {
+  m_file.flush();
+ }
+}
+
+void
+Logger::format(const Record& record, std::string& out) const {
+ out.clear();
+ std::size_t offset = 0;
+ char number[96];
+ for (const char* c = record.format; *c != '\0'; ++c) {
+  if (c[0] != '{' || c[1] != '}') {
+   out += *c;
+   continue;
+  }
+  ++c;
+  if (offset >= record.used) {
+   //faltan argumentos: se deja el hueco visible
+   out += "{}";
+   continue;
+  }
+
+  const ArgumentType type = static_cast<ArgumentType>(record.arguments[offset]);
+  const char* data = record.arguments + offset + 1;
+  switch (type) {
+  case ARGUMENT_INT: {
+   int64_t value;
+   std::memcpy(&value, data, sizeof(value));
+   std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(value));
+   out += number;
+   offset += 1 + sizeof(value);
+   break;
+  }
+  case ARGUMENT_UINT: {
+   uint64_t value;
+   std::memcpy(&value, data, sizeof(value));
+   std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value));
+   out += number;
+   offset += 1 + sizeof(value);
+   break;
+  }
+  case ARGUMENT_DOUBLE: {
+   double value;
+   std::memcpy(&value, data, sizeof(value));
+   std::snprintf(number, sizeof(number), "%g", value);
+   out += number;
+   offset += 1 + sizeof(value);
+   break;
+  }
+  case ARGUMENT_BOOL:
+   out += *data != 0 ? "true" : "false";
+   offset += 1 + sizeof(bool);
+   break;
+  case ARGUMENT_CHAR:
+   out += *data;
+   offset += 1 + sizeof(char);
+   break;
+  case ARGUMENT_STRING: {
+   uint16_t length;
+   std::memcpy(&length, data, sizeof(length));
+   out.append(data + sizeof(length), length);
+   offset += 1 + sizeof(length) + length;
+   break;
+  }
+  case ARGUMENT_POINTER: {
+   uint64_t value;
+   std::memcpy(&value, data, sizeof(value));
+   std::snprintf(number, sizeof(number), "0x%llx", static_cast<unsigned long long>(value));
+   out += number;
+   offset += 1 + sizeof(value);
+   break;
+  }
+  case ARGUMENT_VECTOR2: {
+   double pair[2];
+   std::memcpy(pair, data, sizeof(pair));
+   std::snprintf(number, sizeof(number), "(%g, %g)", pair[0], pair[1]);
+   out += number;
+   offset += 1 + sizeof(pair);
+   break;
+  }
+  default:
+   offset = record.used;
+   break;
+  }
+ }
+ if (record.truncated) {
+  out += " [...]";
+ }
+}
+
+void
+Logger::dispatch(const Record& record, const std::string& text) {
+ const LogSeverity severity = static_cast<LogSeverity>(record.severity);
+ const double seconds = record.time / 1e9;
+ char prefix[192];
+ std::snprintf(prefix, sizeof(prefix), "[%10.4f] [%-7s] [%s] ",
+               seconds, getSeverityName(severity), getCategoryName(record.category));
+
+ if (severity >= m_sinkLevels[LOG_SINK_FILE].load(std::memory_order_relaxed)) {
+  std::lock_guard<std::mutex> lock(m_fileMutex);
+  if (m_file.is_open()) {
+   m_file << prefix << text << '\n';
+  }
+ }
+
+ if (severity >= m_sinkLevels[LOG_SINK_STDERR].load(std::memory_order_relaxed)) {
+  //una sola escritura por linea para no mezclarla con otros hilos
+  std::fprintf(stderr, "%s%s\n", prefix, text.c_str());
+ }
+
+ if (severity >= m_sinkLevels[LOG_SINK_CONSOLE].load(std::memory_order_relaxed)) {
+  std::lock_guard<std::mutex> lock(m_consoleMutex);
+  m_console.push(seconds, severity, record.category, record.thread, text);
+ }
+}
+
+void
+Logger::clearConsole() {
+ std::lock_guard<std::mutex> lock(m_consoleMutex);
+ m_console.clear();
+}
+
+const char*
+Logger::getSeverityName(LogSeverity severity) {
+ switch (severity) {
+ case LOG_SEVERITY_TRACE: return "TRACE";
+ case LOG_SEVERITY_DEBUG: return "DEBUG";
+ case LOG_SEVERITY_INFO: return "INFO";
+ case LOG_SEVERITY_WARNING: return "WARNING";
+ case LOG_SEVERITY_ERROR: return "ERROR";
+ case LOG_SEVERITY_OFF: return "OFF";
+ default: return "?";
+ }
+}
+
+bool
+Logger::parseSeverity(const std::string& name, LogSeverity& severity) {
+ static const char* names[] = { "trace", "debug", "info", "warning", "error", "off" };
+ for (int i = 0; i <= LOG_SEVERITY_OFF; ++i) {
+  if (name == names[i]) {
+   severity = static_cast<LogSeverity>(i);
+   return true;
+  }
+ }
+ return false;
+}
@@ -0,0 +1,87 @@
+#include "Utilities/MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI  //wingdi.h redefine ERROR
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+ close();
+}
+
+bool
+MappedFile::open(const std::string& fileName) {
+ close();
+
+#if defined(_WIN32)
+ HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+ if (file == INVALID_HANDLE_VALUE) {
+  return false;
+ }
+ LARGE_INTEGER size;
+ if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+  CloseHandle(file);
+  return false;
+ }
+ HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+ if (mapping == nullptr) {
+  CloseHandle(file);
+  return false;
+ }
+ void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+ if (view == nullptr) {
+  CloseHandle(mapping);
+  CloseHandle(file);
+  return false;
+ }
+ m_file = file;
+ m_mapping = mapping;
+ m_data = static_cast<const uint8_t*>(view);
+ m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+ const int descriptor = ::open(fileName.c_str(), O_RDONLY);
+ if (descriptor < 0) {
+  return false;
+ }
+ struct stat info;
+ if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+  ::close(descriptor);
+  return false;
+ }
+ void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+ //el mapeo sobrevive al descriptor
+ ::close(descriptor);
+ if (view == MAP_FAILED) {
+  return false;
+ }
+ m_data = static_cast<const uint8_t*>(view);
+ m_size = static_cast<std::size_t>(info.st_size);
+#endif
+ return true;
+}
+
+void
+MappedFile::close() {
+ if (m_data == nullptr) {
+  return;
+ }
+#if defined(_WIN32)
+ UnmapViewOfFile(m_data);
+ CloseHandle(static_cast<HANDLE>(m_mapping));
+ CloseHandle(static_cast<HANDLE>(m_file));
+ m_mapping = nullptr;
+ m_file = nullptr;
+#else
+ munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+ m_data = nullptr;
+ m_size = 0;
+}
@@ -0,0 +1,386 @@
+#include "Utilities/MemoryTracker.h"
+
+#if ENGINE_MEMORY_TRACKING
+
+#include "Utilities/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+namespace {
+ //todo se inicializa a cero antes de cualquier constructor estatico (new puede llegar antes)
+ struct
+  TypeCounters {
+  std::atomic<const char*> name;
+  std::atomic<std::size_t> size;
+  std::atomic<uint64_t> allocations;
+  std::atomic<uint64_t> frees;
+  std::atomic<uint64_t> frameAllocations;
+  std::atomic<int64_t> liveBytes;
+  std::atomic<int64_t> peakBytes;
+ };
+
+ TypeCounters g_types[MemoryTracker::MAX_TYPES];
+ std::atomic<uint32_t> g_typeCount{ 1 };  //el 0 es "untyped"
+ std::atomic<uint64_t> g_allocations{ 0 };
+ std::atomic<uint64_t> g_frees{ 0 };
+ std::atomic<uint64_t> g_frameAllocations{ 0 };
+ std::atomic<uint64_t> g_frameBytes{ 0 };
+ std::atomic<int64_t> g_liveBytes{ 0 };
+ std::atomic<int64_t> g_peakBytes{ 0 };
+ thread_local uint32_t t_nextType = 0;
+ //solo las reservas del hilo del frame entran en los contadores del frame
+ thread_local bool t_frameThread = false;
+
+ //bloques reservados por estos hooks, por direccion. Nada se lee delante de un puntero
+ //ajeno: un bloque que no esta en la tabla vino de otro modulo y va directo al CRT
+ struct
+  BlockEntry {
+  uintptr_t address;  //0: libre, 1: borrado
+  uint64_t size;
+  uint32_t type;
+ };
+
+ constexpr uintptr_t EMPTY_SLOT = 0;
+ constexpr uintptr_t ERASED_SLOT = 1;
+ constexpr std::size_t SHARD_BITS = 6;
+ constexpr std::size_t SHARD_MIN_CAPACITY = 1024;
+
+ //tabla abierta con sondeo lineal; la memoria sale de malloc (no de los hooks)
+ struct
+  BlockShard {
+  std::atomic<bool> locked;
+  BlockEntry* entries;
+  std::size_t capacity;
+  std::size_t used;
+  std::size_t erased;
+ };
+
+ BlockShard g_shards[std::size_t(1) << SHARD_BITS];
+
+ uint64_t
+ hashAddress(uintptr_t address) {
+  return (static_cast<uint64_t>(address) >> 4) * 0x9E3779B97F4A7C15ull;
+ }
+
+ BlockShard&
+ shardOf(uint64_t hash) {
+  return g_shards[hash >> (64 - SHARD_BITS)];
+ }
+
+ class
+  ShardLock {
+ public:
+  explicit ShardLock(BlockShard& shard) : m_shard(shard) {
+   while (m_shard.locked.exchange(true, std::memory_order_acquire)) {
+    std::this_thread::yield();
+   }
+  }
+  ~ShardLock() { m_shard.locked.store(false, std::memory_order_release); }
+ private:
+  BlockShard& m_shard;
+ };
+
+ //rehace la tabla sin los borrados; false si malloc falla
+ bool
+ growShard(BlockShard& shard) {
+  const std::size_t capacity = shard.used * 2 >= shard.capacity ? std::max(shard.capacity * 2, SHARD_MIN_CAPACITY) : shard.capacity;
+  BlockEntry* entries = static_cast<BlockEntry*>(std::calloc(capacity, sizeof(BlockEntry)));
+  if (entries == nullptr) {
+   return false;
+  }
+  for (std::size_t i = 0; i < shard.capacity; ++i) {
+   const BlockEntry& entry = shard.entries[i];
+   if (entry.address <= ERASED_SLOT) {
+    continue;
+   }
+   std::size_t slot = hashAddress(entry.address) & (capacity - 1);
+   while (entries[slot].address != EMPTY_SLOT) {
+    slot = (slot + 1) & (capacity - 1);
+   }
+   entries[slot] = entry;
+  }
+  std::free(shard.entries);
+  shard.entries = entries;
+  shard.capacity = capacity;
+  shard.erased = 0;
+  return true;
+ }
+
+ //registra un bloque; si la direccion seguia en la tabla (liberada fuera de los hooks) devuelve la entrada vieja
+ bool
+ insertBlock(uintptr_t address, uint64_t size, uint32_t type, BlockEntry& stale) {
+  const uint64_t hash = hashAddress(address);
+  BlockShard& shard = shardOf(hash);
+  ShardLock lock(shard);
+  if ((shard.used + shard.erased + 1) * 4 > shard.capacity * 3 && !growShard(shard)) {
+   return false;
+  }
+  stale.address = EMPTY_SLOT;
+  std::size_t slot = hash & (shard.capacity - 1);
+  std::size_t reuse = SIZE_MAX;
+  while (shard.entries[slot].address != EMPTY_SLOT) {
+   if (shard.entries[slot].address == address) {
+    stale = shard.entries[slot];
+    shard.entries[slot] = { address, size, type };
+    return true;
+   }
+   if (shard.entries[slot].address == ERASED_SLOT && reuse == SIZE_MAX) {
+    reuse = slot;
+   }
+   slot = (slot + 1) & (shard.capacity - 1);
+  }
+  if (reuse != SIZE_MAX) {
+   slot = reuse;
+   --shard.erased;
+  }
+  shard.entries[slot] = { address, size, type };
+  ++shard.used;
+  return true;
+ }
+
+ //saca un bloque de la tabla; false si no lo reservaron estos hooks
+ bool
+ removeBlock(uintptr_t address, BlockEntry& removed) {
+  const uint64_t hash = hashAddress(address);
+  BlockShard& shard = shardOf(hash);
+  ShardLock lock(shard);
+  if (shard.capacity == 0) {
+   return false;
+  }
+  std::size_t slot = hash & (shard.capacity - 1);
+  while (shard.entries[slot].address != EMPTY_SLOT) {
+   if (shard.entries[slot].address == address) {
+    removed = shard.entries[slot];
+    shard.entries[slot].address = ERASED_SLOT;
+    --shard.used;
+    ++shard.erased;
+    return true;
+   }
+   slot = (slot + 1) & (shard.capacity - 1);
+  }
+  return false;
+ }
+
+ void
+ raisePeak(std::atomic<int64_t>& peak, int64_t value) {
+  int64_t current = peak.load(std::memory_order_relaxed);
+  while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+ }
+
+ void
+ countFree(const BlockEntry& entry) {
+  const int64_t bytes = static_cast<int64_t>(entry.size);
+  g_frees.fetch_add(1, std::memory_order_relaxed);
+  g_liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+  TypeCounters& counters = g_types[entry.type];
+  counters.frees.fetch_add(1, std::memory_order_relaxed);
+  counters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+ }
+
+ void*
+ allocate(std::size_t size) {
+  //la etiqueta de MakeShared/MakeUnique vale solo para esta reserva
+  const uint32_t type = t_nextType;
+  t_nextType = 0;
+
+  //sin cabecera: el bloque es el de malloc, tal cual lo liberaria cualquier otro modulo
+  void* block = std::malloc(size > 0 ? size : 1);
+  if (block == nullptr) {
+   return nullptr;
+  }
+  BlockEntry stale;
+  if (!insertBlock(reinterpret_cast<uintptr_t>(block), size, type, stale)) {
+   std::free(block);
+   return nullptr;
+  }
+  if (stale.address != EMPTY_SLOT) {
+   //la direccion se libero fuera de los hooks (dentro de una DLL): se cuenta ahora
+   countFree(stale);
+  }
+
+  const int64_t bytes = static_cast<int64_t>(size);
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  raisePeak(g_peakBytes, g_liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+  TypeCounters& counters = g_types[type];
+  counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  if (t_frameThread) {
+   g_frameAllocations.fetch_add(1, std::memory_order_relaxed);
+   g_frameBytes.fetch_add(size, std::memory_order_relaxed);
+   counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  raisePeak(counters.peakBytes, counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+  return block;
+ }
+
+ void
+ release(void* block) {
+  if (block == nullptr) {
+   return;
+  }
+  BlockEntry entry;
+  if (removeBlock(reinterpret_cast<uintptr_t>(block), entry)) {
+   countFree(entry);
+  }
+  std::free(block);
+ }
+}
+
+uint32_t
+EngineUtilities::registerAllocationType(const char* name, std::size_t size) {
+ const uint32_t type = g_typeCount.fetch_add(1, std::memory_order_relaxed);
+ if (type >= MemoryTracker::MAX_TYPES) {
+  return 0;
+ }
+ g_types[type].size.store(size, std::memory_order_relaxed);
+ g_types[type].name.store(name, std::memory_order_release);
+ return type;
+}
+
+void
+EngineUtilities::setNextAllocationType(uint32_t type) {
+ t_nextType = type;
+}
+
+void
+MemoryTracker::endFrame() {
+ const uint32_t typeCount = std::min(g_typeCount.load(std::memory_order_relaxed), MAX_TYPES);
+ m_frameAllocations = g_frameAllocations.exchange(0, std::memory_order_relaxed);
+ m_frameBytes = g_frameBytes.exchange(0, std::memory_order_relaxed);
+ for (uint32_t i = 0; i < typeCount; ++i) {
+  m_typeFrame[i] = g_types[i].frameAllocations.exchange(0, std::memory_order_relaxed);
+ }
+ m_history[m_historyNext] = static_cast<float>(m_frameAllocations);
+ m_historyNext = (m_historyNext + 1) % HISTORY_FRAMES;
+ ++m_frame;
+ PROFILE_COUNTER("Allocations", m_frameAllocations);
+
+ if (m_assertEnabled && m_frame > m_assertFrom && m_frameAllocations > 0) {
+  //stderr directo: el logger no se vaciaria antes del abort
+  std::cerr << "[MemoryTracker]: frame " << m_frame << " allocated " << m_frameAllocations
+            << " times (" << m_frameBytes << " bytes) in the steady-state loop\n";
+  printFrameAllocations(std::cerr);
+  //abort y no exit: el depurador se detiene aqui con la pila del frame
+  std::abort();
+ }
+}
+
+void
+MemoryTracker::setFrameThread() {
+ t_frameThread = true;
+}
+
+void
+MemoryTracker::setSteadyStateAssert(uint32_t warmupFrames) {
+ m_assertEnabled = true;
+ m_assertFrom = m_frame + warmupFrames;
+}
+
+MemoryTracker::Totals
+MemoryTracker::getTotals() const {
+ Totals totals;
+ totals.allocations = g_allocations.load(std::memory_order_relaxed);
+ totals.frees = g_frees.load(std::memory_order_relaxed);
+ totals.liveBytes = g_liveBytes.load(std::memory_order_relaxed);
+ totals.peakBytes = g_peakBytes.load(std::memory_order_relaxed);
+ totals.frameAllocations = m_frameAllocations;
+ totals.frameBytes = m_frameBytes;
+ return totals;
+}
+
+void
+MemoryTracker::getTypeStats(std::vector<TypeStats>& out) const {
+ const uint32_t typeCount = std::min(g_typeCount.load(std::memory_order_relaxed), MAX_TYPES);
+ out.resize(typeCount);
+ for (uint32_t i = 0; i < typeCount; ++i) {
+  const TypeCounters& counters = g_types[i];
+  TypeStats& stats = out[i];
+  //un tipo a medio registrar sale sin nombre
+  const char* name = counters.name.load(std::memory_order_acquire);
+  stats.name = i == 0 ? "untyped" : (name != nullptr ? name : "?");
+  stats.size = counters.size.load(std::memory_order_relaxed);
+  stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+  stats.frees = counters.frees.load(std::memory_order_relaxed);
+  stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+  stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+  stats.frameAllocations = m_typeFrame[i];
+ }
+}
+
+void
+MemoryTracker::printFrameAllocations(std::ostream& out) const {
+ const uint32_t typeCount = std::min(g_typeCount.load(std::memory_order_relaxed), MAX_TYPES);
+ for (uint32_t i = 0; i < typeCount; ++i) {
+  if (m_typeFrame[i] == 0) {
+   continue;
+  }
+  const char* name = g_types[i].name.load(std::memory_order_acquire);
+  out << "  " << (i == 0 ? "untyped" : (name != nullptr ? name : "?")) << ": " << m_typeFrame[i] << "\n";
+ }
+}
+
+//hooks globales: formas simples, de arreglo y nothrow
+void*
+operator new(std::size_t size) {
+ void* block = allocate(size);
+ if (block == nullptr) {
+  throw std::bad_alloc();
+ }
+ return block;
+}
+
+void*
+operator new[](std::size_t size) {
+ void* block = allocate(size);
+ if (block == nullptr) {
+  throw std::bad_alloc();
+ }
+ return block;
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept {
+ return allocate(size);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+ return allocate(size);
+}
+
+void
+operator delete(void* block) noexcept {
+ release(block);
+}
+
+void
+operator delete[](void* block) noexcept {
+ release(block);
+}
+
+void
+operator delete(void* block, std::size_t) noexcept {
+ release(block);
+}
+
+void
+operator delete[](void* block, std::size_t) noexcept {
+ release(block);
+}
+
+void
+operator delete(void* block, const std::nothrow_t&) noexcept {
+ release(block);
+}
+
+void
+operator delete[](void* block, const std::nothrow_t&) noexcept {
+ release(block);
+}
+
+#endif
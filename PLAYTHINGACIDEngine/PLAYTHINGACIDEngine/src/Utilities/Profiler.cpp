@@ -0,0 +1,358 @@
+#include "Utilities/Profiler.h"
+
+#if ENGINE_PROFILER
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+namespace {
+ //los nombres son literales, pero __FUNCTION__ puede traer cualquier cosa
+ void
+  writeJsonString(std::ostream& out, const char* text) {
+  out << '"';
+  for (; *text != '\0'; ++text) {
+   if (*text == '"' || *text == '\\') {
+    out << '\\' << *text;
+   }
+   else if (static_cast<unsigned char>(*text) >= 0x20) {
+    out << *text;
+   }
+  }
+  out << '"';
+ }
+}
+
+/**
+ * @brief Ring of events written by one thread and read by the main thread.
+ */
+struct
+ Profiler::ThreadBuffer {
+ static constexpr uint64_t CAPACITY = 8192;  ///< Events (power of two).
+
+ Event events[CAPACITY];
+ std::atomic<uint64_t> head{ 0 };     ///< Next write (owner thread).
+ std::atomic<uint64_t> tail{ 0 };     ///< Next read (main thread).
+ std::atomic<uint64_t> dropped{ 0 };  ///< Events lost to a full ring.
+ uint32_t depth = 0;                  ///< Open scopes (owner thread).
+ uint32_t index = 0;                  ///< Thread index.
+ std::string name;                    ///< Thread name (guarded by m_threadsMutex).
+};
+
+Profiler::~Profiler() {
+ for (ThreadBuffer* buffer : m_threads) {
+  delete buffer;
+ }
+}
+
+uint64_t
+Profiler::now() {
+ return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+  std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler::ThreadBuffer&
+Profiler::threadBuffer() {
+ thread_local ThreadBuffer* t_buffer = nullptr;
+ if (t_buffer == nullptr) {
+  Profiler& profiler = getInstance();
+  ThreadBuffer* buffer = new ThreadBuffer();
+  std::lock_guard<std::mutex> lock(profiler.m_threadsMutex);
+  buffer->index = static_cast<uint32_t>(profiler.m_threads.size());
+  buffer->name = buffer->index == 0 ? "Main thread" : "Thread " + std::to_string(buffer->index);
+  profiler.m_threads.push_back(buffer);
+  t_buffer = buffer;
+ }
+ return *t_buffer;
+}
+
+void
+Profiler::enter() {
+ ++threadBuffer().depth;
+}
+
+void
+Profiler::push(ThreadBuffer& buffer, const char* name, uint64_t start, uint64_t end, uint32_t depth) {
+ //un solo escritor por anillo: no hace falta lock
+ const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+ if (head - buffer.tail.load(std::memory_order_acquire) >= ThreadBuffer::CAPACITY) {
+  buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+  return;
+ }
+ Event& event = buffer.events[head & (ThreadBuffer::CAPACITY - 1)];
+ event.name = name;
+ event.start = start;
+ event.end = end;
+ event.depth = depth;
+ event.thread = buffer.index;
+ buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void
+Profiler::leave(const char* name, uint64_t start) {
+ const uint64_t end = now();
+ ThreadBuffer& buffer = threadBuffer();
+ --buffer.depth;
+ push(buffer, name, start, end, buffer.depth);
+}
+
+void
+Profiler::counter(const char* name, uint64_t value) {
+ push(threadBuffer(), name, now(), value, COUNTER_DEPTH);
+}
+
+void
+Profiler::setThreadName(const std::string& name) {
+ ThreadBuffer& buffer = threadBuffer();
+ std::lock_guard<std::mutex> lock(m_threadsMutex);
+ buffer.name = name;
+}
+
+std::size_t
+Profiler::getThreadCount() const {
+ std::lock_guard<std::mutex> lock(m_threadsMutex);
+ return m_threads.size();
+}
+
+std::string
+Profiler::getThreadName(uint32_t thread) const {
+ std::lock_guard<std::mutex> lock(m_threadsMutex);
+ return thread < m_threads.size() ? m_threads[thread]->name : std::string();
+}
+
+uint64_t
+Profiler::getDroppedCount() const {
+ std::lock_guard<std::mutex> lock(m_threadsMutex);
+ uint64_t dropped = 0;
+ for (const ThreadBuffer* buffer : m_threads) {
+  dropped += buffer->dropped.load(std::memory_order_relaxed);
+ }
+ return dropped;
+}
+
+int
+Profiler::findChild(int parent, const char* name, uint32_t thread) {
+ for (const int child : m_nodes[parent].children) {
+  const char* childName = m_nodes[child].name;
+  if (childName == name || std::strcmp(childName, name) == 0) {
+   return child;
+  }
+ }
+ Node node;
+ node.name = name;
+ node.parent = parent;
+ node.thread = thread;
+ node.history.reserve(HISTORY_FRAMES);
+ m_nodes.push_back(std::move(node));
+ const int index = static_cast<int>(m_nodes.size()) - 1;
+ m_nodes[parent].children.push_back(index);
+ return index;
+}
+
+void
+Profiler::endFrame() {
+ const uint64_t frameEnd = now();
+ if (m_frameStart == 0) {
+  m_frameStart = frameEnd;
+ }
+
+ //vaciar los anillos de todos los hilos
+ m_drained.clear();
+ std::size_t threadCount = 0;
+ {
+  std::lock_guard<std::mutex> lock(m_threadsMutex);
+  threadCount = m_threads.size();
+  for (ThreadBuffer* buffer : m_threads) {
+   const uint64_t head = buffer->head.load(std::memory_order_acquire);
+   uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+   for (; tail != head; ++tail) {
+    m_drained.push_back(buffer->events[tail & (ThreadBuffer::CAPACITY - 1)]);
+   }
+   buffer->tail.store(tail, std::memory_order_release);
+  }
+ }
+
+ if (m_captureTarget > 0) {
+  captureFrame(frameEnd);
+ }
+
+ //los contadores solo van a la captura
+ m_drained.erase(std::remove_if(m_drained.begin(), m_drained.end(),
+  [](const Event& event) { return event.depth == COUNTER_DEPTH; }), m_drained.end());
+
+ if (m_paused) {
+  m_frameStart = frameEnd;
+  return;
+ }
+
+ while (m_roots.size() < threadCount) {
+  Node root;
+  root.thread = static_cast<uint32_t>(m_roots.size());
+  root.history.reserve(HISTORY_FRAMES);
+  m_nodes.push_back(std::move(root));
+  m_roots.push_back(static_cast<int>(m_nodes.size()) - 1);
+ }
+ for (Node& node : m_nodes) {
+  node.frameTime = 0;
+  node.frameCalls = 0;
+ }
+
+ //los eventos se escriben al cerrar: ordenados por inicio, el padre va antes que sus hijos
+ std::sort(m_drained.begin(), m_drained.end(), [](const Event& a, const Event& b) {
+  if (a.thread != b.thread) {
+   return a.thread < b.thread;
+  }
+  return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+ });
+
+ //pila reutilizada entre frames: agregar no reserva memoria en el hilo del frame
+ std::vector<OpenScope>& stack = m_openScopes;
+ stack.clear();
+ uint32_t currentThread = UINT32_MAX;
+ for (const Event& event : m_drained) {
+  if (event.thread != currentThread) {
+   currentThread = event.thread;
+   stack.clear();
+  }
+  while (!stack.empty() && stack.back().depth >= event.depth) {
+   stack.pop_back();
+  }
+  const uint64_t duration = event.end - event.start;
+  const int root = m_roots[event.thread];
+  if (stack.empty()) {
+   m_nodes[root].frameTime += duration;
+   m_nodes[root].frameCalls = 1;
+  }
+  const int node = findChild(stack.empty() ? root : stack.back().node, event.name, event.thread);
+  m_nodes[node].frameTime += duration;
+  ++m_nodes[node].frameCalls;
+  stack.push_back({ node, event.depth });
+ }
+
+ for (Node& node : m_nodes) {
+  if (node.frameCalls == 0) {
+   continue;
+  }
+  if (node.history.size() < HISTORY_FRAMES) {
+   node.history.push_back(node.frameTime);
+  }
+  else {
+   node.history[node.historyNext] = node.frameTime;
+  }
+  node.historyNext = (node.historyNext + 1) % HISTORY_FRAMES;
+ }
+
+ m_lastFrame.swap(m_drained);
+ m_lastFrameStart = m_frameStart;
+ m_lastFrameEnd = frameEnd;
+ m_frameStart = frameEnd;
+}
+
+Profiler::Stats
+Profiler::getStats(const Node& node) const {
+ Stats stats;
+ if (node.history.empty()) {
+  return stats;
+ }
+ std::vector<uint64_t> sorted = node.history;
+ std::sort(sorted.begin(), sorted.end());
+ uint64_t total = 0;
+ for (const uint64_t sample : sorted) {
+  total += sample;
+ }
+ const std::size_t p99 = (sorted.size() * 99 + 99) / 100 - 1;
+ stats.minMs = sorted.front() / 1e6;
+ stats.maxMs = sorted.back() / 1e6;
+ stats.avgMs = static_cast<double>(total) / sorted.size() / 1e6;
+ stats.p99Ms = sorted[std::min(p99, sorted.size() - 1)] / 1e6;
+ return stats;
+}
+
+void
+Profiler::startCapture(uint32_t frames, const std::string& fileName) {
+ if (m_captureTarget > 0 || frames == 0) {
+  return;
+ }
+ m_captureTarget = frames;
+ m_captureFile = fileName;
+ //toda la memoria de la captura se pide aqui: reallocar a mitad de frame se veria en la traza
+ m_capture.clear();
+ m_capture.reserve(MAX_CAPTURE_EVENTS);
+ m_captureFrames.clear();
+ m_captureFrames.reserve(frames);
+ LOG_INFO("Profiler", "Capturing {} frames to {}", frames, fileName);
+}
+
+void
+Profiler::captureFrame(uint64_t frameEnd) {
+ //memoria acotada: si no cabe el frame entero la captura termina antes
+ if (m_capture.size() + m_drained.size() > MAX_CAPTURE_EVENTS) {
+  LOG_WARNING("Profiler", "Capture buffer full after {} frames", m_captureFrames.size());
+  finishCapture();
+  return;
+ }
+ m_capture.insert(m_capture.end(), m_drained.begin(), m_drained.end());
+ m_captureFrames.push_back({ m_frameStart, frameEnd });
+ if (m_captureFrames.size() >= m_captureTarget) {
+  finishCapture();
+ }
+}
+
+void
+Profiler::finishCapture() {
+ std::ofstream out(m_captureFile, std::ios::trunc);
+ if (out && !m_captureFrames.empty()) {
+  const uint64_t origin = m_captureFrames.front().start;
+  const std::size_t threadCount = getThreadCount();
+  //microsegundos relativos al primer frame (con decimales: los scopes duran ns)
+  auto micros = [origin](uint64_t time) {
+   return (static_cast<double>(time) - static_cast<double>(origin)) / 1000.0;
+  };
+
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"PLAYTHINGACID Engine\"}}";
+  for (std::size_t i = 0; i < threadCount; ++i) {
+   out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":";
+   writeJsonString(out, getThreadName(static_cast<uint32_t>(i)).c_str());
+   out << "}}";
+  }
+  //los frames van en una pista propia, despues de los hilos
+  out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadCount
+      << ",\"args\":{\"name\":\"Frames\"}}";
+  for (std::size_t i = 0; i < m_captureFrames.size(); ++i) {
+   const FrameMark& frame = m_captureFrames[i];
+   out << ",\n{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadCount
+       << ",\"ts\":" << micros(frame.start) << ",\"dur\":" << (frame.end - frame.start) / 1000.0
+       << ",\"args\":{\"frame\":" << i << "}}";
+  }
+  for (const Event& event : m_capture) {
+   out << ",\n{\"name\":";
+   writeJsonString(out, event.name);
+   if (event.depth == COUNTER_DEPTH) {
+    out << ",\"ph\":\"C\",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":" << micros(event.start)
+        << ",\"args\":{\"value\":" << event.end << "}}";
+   }
+   else {
+    out << ",\"cat\":\"scope\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread << ",\"ts\":" << micros(event.start)
+        << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+   }
+  }
+  out << "\n]}\n";
+ }
+
+ if (out) {
+  LOG_INFO("Profiler", "Trace of {} frames written to {}", m_captureFrames.size(), m_captureFile);
+ }
+ else {
+  LOG_ERROR("Profiler", "Can't write {}", m_captureFile);
+ }
+
+ //la memoria de la captura se devuelve entera
+ std::vector<Event>().swap(m_capture);
+ std::vector<FrameMark>().swap(m_captureFrames);
+ m_captureTarget = 0;
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include "Utilities/SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize) {
+ setCellSize(cellSize);
+}
+
+void
+SpatialGrid::clear() {
+ m_cells.clear();
+ m_items.clear();
+ m_oversized.clear();
+ m_stamps.clear();
+ m_count = 0;
+}
+
+void
+SpatialGrid::setCellSize(float cellSize) {
+ if (m_count > 0) {
+  LOG_WARNING("SpatialGrid", "setCellSize ignored: the grid is not empty");
+  return;
+ }
+ m_cellSize = cellSize > 0.f ? cellSize : 64.f;
+ m_inverseCell = 1.f / m_cellSize;
+}
+
+int
+SpatialGrid::cellOf(float value) const {
+ return static_cast<int>(std::floor(value * m_inverseCell));
+}
+
+void
+SpatialGrid::update(int id, const sf::FloatRect& bounds) {
+ if (id < 0) {
+  return;
+ }
+ if (bounds.size.x <= 0.f || bounds.size.y <= 0.f) {
+  remove(id);
+  return;
+ }
+ if (static_cast<std::size_t>(id) >= m_items.size()) {
+  m_items.resize(static_cast<std::size_t>(id) + 1);
+  m_stamps.resize(m_items.size(), 0);
+ }
+
+ Item& item = m_items[id];
+ const int minX = cellOf(bounds.position.x);
+ const int minY = cellOf(bounds.position.y);
+ const int maxX = cellOf(bounds.position.x + bounds.size.x);
+ const int maxY = cellOf(bounds.position.y + bounds.size.y);
+ item.bounds = bounds;
+
+ //mismas celdas: solo cambia la caja (el caso comun de un actor que se mueve poco)
+ if (item.stored && minX == item.minX && minY == item.minY && maxX == item.maxX && maxY == item.maxY) {
+  return;
+ }
+ if (item.stored) {
+  unlink(id, item);
+ }
+
+ item.minX = minX;
+ item.minY = minY;
+ item.maxX = maxX;
+ item.maxY = maxY;
+ item.stored = true;
+ ++m_count;
+
+ const int64_t cellCount = (static_cast<int64_t>(maxX) - minX + 1) * (static_cast<int64_t>(maxY) - minY + 1);
+ item.oversized = cellCount > MAX_ITEM_CELLS;
+ if (item.oversized) {
+  m_oversized.push_back(id);
+  return;
+ }
+ for (int y = minY; y <= maxY; ++y) {
+  for (int x = minX; x <= maxX; ++x) {
+   m_cells[cellKey(x, y)].push_back(id);
+  }
+ }
+}
+
+void
+SpatialGrid::remove(int id) {
+ if (id < 0 || static_cast<std::size_t>(id) >= m_items.size() || !m_items[id].stored) {
+  return;
+ }
+ unlink(id, m_items[id]);
+}
+
+void
+SpatialGrid::unlink(int id, Item& item) {
+ //orden dentro de una celda sin importancia: quitar es cambiar por el ultimo
+ auto erase = [id](std::vector<int>& ids) {
+  const auto found = std::find(ids.begin(), ids.end(), id);
+  if (found != ids.end()) {
+   *found = ids.back();
+   ids.pop_back();
+  }
+ };
+
+ if (item.oversized) {
+  erase(m_oversized);
+ }
+ else {
+  for (int y = item.minY; y <= item.maxY; ++y) {
+   for (int x = item.minX; x <= item.maxX; ++x) {
+    //la celda vacia se queda con su capacidad: volver a entrar no reserva memoria
+    const auto cell = m_cells.find(cellKey(x, y));
+    if (cell != m_cells.end()) {
+     erase(cell->second);
+    }
+   }
+  }
+ }
+ item.stored = false;
+ item.oversized = false;
+ --m_count;
+}
+
+void
+SpatialGrid::report(int id, std::vector<int>& out) const {
+ if (m_stamps[id] != m_query) {
+  m_stamps[id] = m_query;
+  out.push_back(id);
+ }
+}
+
+void
+SpatialGrid::queryPoint(const sf::Vector2f& point, std::vector<int>& out) const {
+ if (++m_query == 0) {
+  std::fill(m_stamps.begin(), m_stamps.end(), 0);
+  m_query = 1;
+ }
+
+ const auto cell = m_cells.find(cellKey(cellOf(point.x), cellOf(point.y)));
+ if (cell != m_cells.end()) {
+  for (int id : cell->second) {
+   if (m_items[id].bounds.contains(point)) {
+    report(id, out);
+   }
+  }
+ }
+ for (int id : m_oversized) {
+  if (m_items[id].bounds.contains(point)) {
+   report(id, out);
+  }
+ }
+}
+
+void
+SpatialGrid::queryRect(const sf::FloatRect& rect, std::vector<int>& out) const {
+ if (++m_query == 0) {
+  std::fill(m_stamps.begin(), m_stamps.end(), 0);
+  m_query = 1;
+ }
+
+ const int minX = cellOf(rect.position.x);
+ const int minY = cellOf(rect.position.y);
+ const int maxX = cellOf(rect.position.x + rect.size.x);
+ const int maxY = cellOf(rect.position.y + rect.size.y);
+ auto visit = [&](const std::vector<int>& ids) {
+  for (int id : ids) {
+   if (m_items[id].bounds.findIntersection(rect)) {
+    report(id, out);
+   }
+  }
+ };
+
+ //un rectangulo con mas celdas que las creadas se resuelve recorriendo las creadas
+ const int64_t cellCount = (static_cast<int64_t>(maxX) - minX + 1) * (static_cast<int64_t>(maxY) - minY + 1);
+ if (cellCount > static_cast<int64_t>(m_cells.size())) {
+  for (const auto& cell : m_cells) {
+   const int x = static_cast<int>(static_cast<uint32_t>(cell.first >> 32));
+   const int y = static_cast<int>(static_cast<uint32_t>(cell.first));
+   if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+    visit(cell.second);
+   }
+  }
+ }
+ else {
+  for (int y = minY; y <= maxY; ++y) {
+   for (int x = minX; x <= maxX; ++x) {
+    const auto cell = m_cells.find(cellKey(x, y));
+    if (cell != m_cells.end()) {
+     visit(cell->second);
+    }
+   }
+  }
+ }
+ visit(m_oversized);
+}
@@ -0,0 +1,187 @@
+#include "Utilities/StartupTracer.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+ //spans abiertos del hilo (indices en m_spans)
+ thread_local std::vector<std::size_t> t_openSpans;
+
+ std::string
+  escapeJson(const std::string& text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (const char c : text) {
+   if (c == '"' || c == '\\') {
+    escaped.push_back('\\');
+    escaped.push_back(c);
+   }
+   else if (static_cast<unsigned char>(c) < 0x20) {
+    escaped.push_back(' ');
+   }
+   else {
+    escaped.push_back(c);
+   }
+  }
+  return escaped;
+ }
+}
+
+StartupTracer::StartupTracer() : m_origin(std::chrono::steady_clock::now()) {
+}
+
+uint64_t
+StartupTracer::now() const {
+ return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+  std::chrono::steady_clock::now() - m_origin).count());
+}
+
+uint32_t
+StartupTracer::threadIndex() {
+ const std::thread::id id = std::this_thread::get_id();
+ auto it = m_threads.find(id);
+ if (it != m_threads.end()) {
+  return it->second;
+ }
+ const uint32_t index = static_cast<uint32_t>(m_threadNames.size());
+ m_threadNames.push_back(index == 0 ? "Main thread" : "Thread " + std::to_string(index));
+ m_threads.emplace(id, index);
+ return index;
+}
+
+void
+StartupTracer::begin(const char* name, const std::string* detail) {
+ if (!isRecording()) {
+  return;
+ }
+ Span span;
+ span.name = name;
+ if (detail != nullptr) {
+  span.name += ' ';
+  span.name += *detail;
+ }
+ span.start = now();
+ span.depth = static_cast<uint32_t>(t_openSpans.size());
+
+ std::lock_guard<std::mutex> lock(m_mutex);
+ span.thread = threadIndex();
+ t_openSpans.push_back(m_spans.size());
+ m_spans.push_back(std::move(span));
+}
+
+void
+StartupTracer::end() {
+ if (t_openSpans.empty()) {
+  return;
+ }
+ const std::size_t index = t_openSpans.back();
+ t_openSpans.pop_back();
+ if (!isRecording()) {
+  return;
+ }
+ const uint64_t time = now();
+ std::lock_guard<std::mutex> lock(m_mutex);
+ m_spans[index].end = std::max(time, m_spans[index].start + 1);
+}
+
+void
+StartupTracer::setThreadName(const std::string& name) {
+ std::lock_guard<std::mutex> lock(m_mutex);
+ m_threadNames[threadIndex()] = name;
+}
+
+void
+StartupTracer::finish(const std::string& traceFile, bool printSummary) {
+ if (!m_recording.exchange(false, std::memory_order_acq_rel)) {
+  return;
+ }
+ {
+  //lo que sigue abierto se cierra ahora
+  const uint64_t time = now();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (Span& span : m_spans) {
+   if (span.end == 0) {
+    span.end = std::max(time, span.start + 1);
+   }
+  }
+ }
+
+ if (!traceFile.empty()) {
+  if (writeChromeTrace(traceFile)) {
+   LOG_INFO("StartupTracer", "Trace written to {}", traceFile);
+  }
+  else {
+   LOG_ERROR("StartupTracer", "Can't write {}", traceFile);
+  }
+ }
+ if (printSummary) {
+  this->printSummary(std::cout);
+ }
+}
+
+bool
+StartupTracer::writeChromeTrace(const std::string& fileName) const {
+ std::ofstream out(fileName, std::ios::trunc);
+ if (!out) {
+  return false;
+ }
+ std::lock_guard<std::mutex> lock(m_mutex);
+ out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+ bool first = true;
+ for (std::size_t i = 0; i < m_threadNames.size(); ++i) {
+  out << (first ? "" : ",\n")
+      << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+      << ",\"args\":{\"name\":\"" << escapeJson(m_threadNames[i]) << "\"}}";
+  first = false;
+ }
+ for (const Span& span : m_spans) {
+  const uint64_t end = span.end != 0 ? span.end : span.start;
+  out << (first ? "" : ",\n")
+      << "{\"name\":\"" << escapeJson(span.name) << "\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+      << span.thread << ",\"ts\":" << span.start << ",\"dur\":" << (end - span.start) << "}";
+  first = false;
+ }
+ out << "\n]}\n";
+ return static_cast<bool>(out);
+}
+
+void
+StartupTracer::printSummary(std::ostream& out) const {
+ std::lock_guard<std::mutex> lock(m_mutex);
+
+ //tiempo propio = total menos el de los hijos directos
+ std::vector<uint64_t> childTime(m_spans.size(), 0);
+ std::vector<std::vector<std::size_t>> stacks(m_threadNames.size());
+ for (std::size_t i = 0; i < m_spans.size(); ++i) {
+  const Span& span = m_spans[i];
+  std::vector<std::size_t>& stack = stacks[span.thread];
+  while (!stack.empty() && m_spans[stack.back()].depth >= span.depth) {
+   stack.pop_back();
+  }
+  if (!stack.empty()) {
+   childTime[stack.back()] += span.end - span.start;
+  }
+  stack.push_back(i);
+ }
+
+ const std::ios::fmtflags flags = out.flags();
+ out << std::fixed << std::setprecision(2);
+ out << "---- Startup timeline (ms) ----\n";
+ for (uint32_t thread = 0; thread < m_threadNames.size(); ++thread) {
+  out << m_threadNames[thread] << "\n";
+  out << std::left << std::setw(48) << "  span" << std::right
+      << std::setw(10) << "start" << std::setw(10) << "total" << std::setw(10) << "self" << "\n";
+  for (std::size_t i = 0; i < m_spans.size(); ++i) {
+   const Span& span = m_spans[i];
+   if (span.thread != thread) {
+    continue;
+   }
+   const uint64_t total = span.end - span.start;
+   const uint64_t self = total > childTime[i] ? total - childTime[i] : 0;
+   out << std::left << std::setw(48) << (std::string(2 + span.depth * 2, ' ') + span.name) << std::right
+       << std::setw(10) << span.start / 1000.0
+       << std::setw(10) << total / 1000.0
+       << std::setw(10) << self / 1000.0 << "\n";
+  }
+ }
+ out.flags(flags);
+}
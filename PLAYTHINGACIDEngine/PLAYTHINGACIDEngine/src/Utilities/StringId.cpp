@@ -0,0 +1,51 @@
+#include "Utilities/StringId.h"
+#include <iomanip>
+
+StringId::StringId(const std::string& text) : m_hash(hash(text.data(), text.size())) {
+ StringIdTable::getInstance().intern(m_hash, text);
+}
+
+const std::string&
+StringId::getString() const {
+ static const std::string empty;
+ const std::string* text = StringIdTable::getInstance().find(m_hash);
+ return text != nullptr ? *text : empty;
+}
+
+std::ostream&
+operator<<(std::ostream& stream, const StringId& id) {
+ const std::string& text = id.getString();
+ if (!text.empty()) {
+  return stream << text;
+ }
+ std::ostringstream hex;
+ hex << "#" << std::hex << std::setw(16) << std::setfill('0') << id.getHash();
+ return stream << hex.str();
+}
+
+void
+StringIdTable::intern(uint64_t hash, const std::string& text) {
+ std::lock_guard<std::mutex> lock(m_mutex);
+ auto it = m_strings.find(hash);
+ if (it == m_strings.end()) {
+  m_strings.emplace(hash, text);
+  return;
+ }
+ //dos textos con el mismo hash serian el mismo id: se avisa
+ if (it->second != text) {
+  LOG_ERROR("StringId", "Hash collision between \"{}\" and \"{}\"", it->second, text);
+ }
+}
+
+const std::string*
+StringIdTable::find(uint64_t hash) const {
+ std::lock_guard<std::mutex> lock(m_mutex);
+ auto it = m_strings.find(hash);
+ return it != m_strings.end() ? &it->second : nullptr;
+}
+
+std::size_t
+StringIdTable::getCount() const {
+ std::lock_guard<std::mutex> lock(m_mutex);
+ return m_strings.size();
+}
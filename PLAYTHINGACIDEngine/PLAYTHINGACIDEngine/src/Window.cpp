@@ -1,7 +1,22 @@
 #include "window.h"
 #include "EngineGUI.h"
+#include "Render/SoftwareRenderBackend.h"
+
+Window::Window(int width, int height, const std::string& title)
+ : Window(width, height, title, SFML_WINDOW) {
+}
+
+Window::Window(int width, int height, const std::string& title, RenderBackendType backendType)
+ : m_backendType(backendType),
+   m_view(sf::FloatRect({ 0.f, 0.f }, { static_cast<float>(width), static_cast<float>(height) })) {
+ if (backendType == SOFTWARE) {
+  //sin ventana: se rasteriza en memoria
+  m_backend.reset(new SoftwareRenderBackend(static_cast<unsigned int>(width),
+                                            static_cast<unsigned int>(height)));
+  MESSAGE("Window", "Window", "Software render backend created successfully");
+  return;
+ }
 
-Window::Window(int width, int height, const std::string& title) {
  //Inicializar ventana
     m_windowPtr = EngineUtilities::MakeUnique <sf::RenderWindow>(
         sf::VideoMode({ static_cast<unsigned int>(width), 
@@ -12,6 +27,7 @@ Window::Window(int width, int height, const std::string& title) {
 
  if (!m_windowPtr.isNull()) {
   m_windowPtr->setFramerateLimit(60); //limitar 60 fps
+  m_backend.reset(new SfmlRenderBackend(*m_windowPtr));
   MESSAGE("Window", "Window", "Window created successfully");
  }
  else {
@@ -28,14 +44,18 @@ Window::~Window(){
 void 
 Window::handleEvents(EngineGUI& engineGUI)
 {
+        //el backend software no tiene cola de eventos
+        if (m_windowPtr.isNull()) {
+            return;
+        }
         //process events
         while (const std::optional event = m_windowPtr->pollEvent())
         {
             
 			engineGUI.processEvent(*m_windowPtr, *event); // Process ImGui events
-            //close window: exit
+            //close window: se cierra en destroy(), el render thread puede seguir dibujando
             if (event->is<sf::Event::Closed>())
-                m_windowPtr->close();
+                m_closeRequested = true;
         }
 }
 
@@ -43,8 +63,8 @@ bool
  Window::isOpen() const {
  // Check that window is not null
 
- if (!m_windowPtr.isNull()) {
-  return m_windowPtr->isOpen();
+ if (!m_backend.isNull()) {
+  return !m_closeRequested && m_backend->isOpen();
  }
  else {
   ERROR("Window", "isOpen", "Window is null");
@@ -54,8 +74,8 @@ bool
 
 void
  Window::clear(const sf::Color& color) {
- if (!m_windowPtr.isNull()) {
-  m_windowPtr->clear(color);
+ if (!m_backend.isNull()) {
+  m_backend->clear(color);
  }
  else {
   ERROR("Window", "isOpen", "Window is null");
@@ -65,18 +85,62 @@ void
 
 void
  Window::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
- if (!m_windowPtr.isNull()) {
-  m_windowPtr->draw(drawable, states);
+ if (!m_backend.isNull()) {
+  m_backend->draw(drawable, states);
  }
  else {
   ERROR("Window", "draw", "Window is null");
  }
 }
 
+void
+ Window::draw(const sf::Vertex* vertices,
+              std::size_t vertexCount,
+              sf::PrimitiveType type,
+              const sf::RenderStates& states) {
+ if (!m_backend.isNull()) {
+  m_backend->draw(vertices, vertexCount, type, states);
+ }
+ else {
+  ERROR("Window", "draw", "Window is null");
+ }
+}
+
+void
+ Window::setView(const sf::View& view) {
+ if (!m_backend.isNull()) {
+  m_backend->setView(view);
+ }
+ else {
+  ERROR("Window", "setView", "Window is null");
+ }
+}
+
+void
+ Window::resetView() {
+ setView(m_view);
+}
+
+sf::Vector2u
+ Window::getSize() const {
+ if (m_backend.isNull()) {
+  return { 0, 0 };
+ }
+ return m_backend->getSize();
+}
+
+bool
+ Window::setActive(bool active) {
+ if (m_backend.isNull()) {
+  return false;
+ }
+ return m_backend->setActive(active);
+}
+
 void
  Window::display() {
- if (!m_windowPtr.isNull()) {
-  m_windowPtr->display();
+ if (!m_backend.isNull()) {
+  m_backend->display();
  }
  else {
   ERROR("Window", "display", "Window is null");
@@ -96,7 +160,11 @@ Window::render() {
 
 void
 Window::destroy() {
-   
-    m_windowPtr.release();
-   
+    if (!m_windowPtr.isNull() && m_windowPtr->isOpen()) {
+        m_windowPtr->close();
+    }
+    if (m_backendType == SOFTWARE && !m_backend.isNull()) {
+        static_cast<SoftwareRenderBackend*>(m_backend.get())->close();
+    }
+    m_closeRequested = true;
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "BaseApp.h"
 
 int
-main() {
+main(int argc, char* argv[]) {
  BaseApp app;
- return app.run();
+ return app.run(argc, argv);
 }
\ No newline at end of file